@@ -0,0 +1,939 @@
+#include "synthetic_project.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <pjson_editor/AllocStats.h>
+#include <pjson_editor/BinaryBridge.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ExtendedModels.h>
+#include <pjson_editor/OpLog.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Allocation counters. Every benchmark reports the allocations, bytes and
+// peak live bytes of the measured call only, as counted by the library's own
+// instrumentation; CMake turns PJSON_ALLOC_STATS on for the benchmarks.
+#ifndef PJSON_ALLOC_STATS
+#error "pjson_bench counts allocations through AllocStats: build with -DPJSON_ALLOC_STATS=ON"
+#endif
+
+namespace {
+size_t allocCount() { return pjson::AllocStats::threadTotals().allocations; }
+size_t allocBytes() { return pjson::AllocStats::threadTotals().bytes; }
+} // namespace
+
+using namespace pjson;
+using namespace pjson::bench;
+
+namespace {
+
+// Project shapes every benchmark runs against:
+// {scenes, timelines per scene, transcript items per scene, assets}
+const std::vector<std::vector<int64_t>> kProjectShapes = {
+    {50, 4, 40, 100},
+    {500, 8, 120, 1000},
+};
+
+// Few scenes with many timelines and long transcripts, where copying whole
+// scenes dominates the split/merge/reorder handlers.
+const std::vector<std::vector<int64_t>> kHeavySceneShapes = {
+    {20, 64, 2000, 200},
+};
+const std::vector<std::string> kHeavySceneHandlers = {
+    "splitScene", "mergeScenes", "setMainStoryOrder"};
+
+// Handlers that change the project shape are measured against a pristine
+// copy each iteration, so they run a fixed number of iterations.
+constexpr int kResetIterations = 200;
+
+SyntheticProjectSpec specFromState(const benchmark::State &state) {
+  SyntheticProjectSpec spec;
+  spec.sceneCount = static_cast<int>(state.range(0));
+  spec.timelinesPerScene = static_cast<int>(state.range(1));
+  spec.transcriptItems = static_cast<int>(state.range(2));
+  spec.assetCount = static_cast<int>(state.range(3));
+  return spec;
+}
+
+// Uuids of the entities the handlers operate on, resolved from the loaded
+// project so they stay valid whatever the generator emits.
+struct BenchContext {
+  std::string projectUuid;
+  std::string sceneUuid;     // DEFAULT scene in the middle of the project
+  std::string nextSceneUuid; // DEFAULT scene right after it
+  std::string blankSceneUuid;
+  std::string aRollUuid;
+  std::string bRollUuid;
+  std::string voiceOverUuid;
+  std::string bgmUuid;
+  std::string assetUuid;
+  std::vector<std::string> reversedSceneUuids;
+};
+
+class BenchProject {
+public:
+  explicit BenchProject(const SyntheticProjectSpec &spec)
+      : sceneList(makeSceneListResponse(spec)), pristine(sceneList),
+        store(std::make_shared<ExtendedDataStore>()) {
+    controller.setDataStore(store);
+    reset();
+    resolveContext();
+  }
+
+  void reset() {
+    store->init(std::make_shared<ExtendedProjectAndScenesVo>(pristine));
+  }
+
+  ExtendedControllerAPI &api() { return controller; }
+  ExtendedDataStore &dataStore() { return *store; }
+  const BenchContext &context() const { return ctx; }
+  const nlohmann::json &sceneListResponse() const { return sceneList; }
+
+private:
+  void resolveContext() {
+    const auto &project = store->getProject();
+    ctx.projectUuid = project.projectUuid;
+    const auto &scenes = project.scenes;
+    for (size_t i = scenes.size() / 2; i + 1 < scenes.size(); ++i) {
+      // The cut/split cases below assume at least 8 s of scene.
+      if (scenes[i].sceneType == SceneTypeEnum::DEFAULT &&
+          scenes[i + 1].sceneType == SceneTypeEnum::DEFAULT &&
+          scenes[i].duration >= 8000 &&
+          !scenes[i].aRolls.empty() && !scenes[i].bRolls.empty() &&
+          !scenes[i].voiceOvers.empty()) {
+        ctx.sceneUuid = scenes[i].uuid;
+        ctx.nextSceneUuid = scenes[i + 1].uuid;
+        ctx.aRollUuid = scenes[i].aRolls.front().uuid;
+        ctx.bRollUuid = scenes[i].bRolls.front().uuid;
+        ctx.voiceOverUuid = scenes[i].voiceOvers.front().uuid;
+        break;
+      }
+    }
+    for (const auto &scene : scenes) {
+      if (scene.sceneType == SceneTypeEnum::BLANK_SCENE) {
+        ctx.blankSceneUuid = scene.uuid;
+        break;
+      }
+    }
+    for (auto it = scenes.rbegin(); it != scenes.rend(); ++it) {
+      ctx.reversedSceneUuids.push_back(it->uuid);
+    }
+    if (!project.bgms.empty()) {
+      ctx.bgmUuid = project.bgms.front().uuid;
+    }
+    if (!project.assets.empty()) {
+      ctx.assetUuid = project.assets.begin()->first;
+    }
+  }
+
+  nlohmann::json sceneList;
+  ExtendedProjectAndScenesVo pristine;
+  std::shared_ptr<ExtendedDataStore> store;
+  ExtendedControllerAPI controller;
+  BenchContext ctx;
+};
+
+// Per-call latency samples and allocation deltas, reported as counters.
+class CallRecorder {
+public:
+  CallRecorder() { AllocStats::reset(); }
+
+  template <typename Fn> void measure(benchmark::State &state, Fn &&fn) {
+    size_t allocsBefore = allocCount();
+    size_t bytesBefore = allocBytes();
+    auto start = std::chrono::steady_clock::now();
+    {
+      PJSON_ALLOC_SCOPE(kScopeName);
+      fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    allocs += allocCount() - allocsBefore;
+    bytes += allocBytes() - bytesBefore;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    samples.push_back(seconds);
+    state.SetIterationTime(seconds);
+  }
+
+  void report(benchmark::State &state) {
+    if (samples.empty()) {
+      return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [this](double p) {
+      size_t idx = static_cast<size_t>(p * (samples.size() - 1));
+      return samples[idx] * 1e6;
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p90_us"] = percentile(0.90);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["allocs/op"] =
+        static_cast<double>(allocs) / static_cast<double>(samples.size());
+    state.counters["bytes/op"] =
+        static_cast<double>(bytes) / static_cast<double>(samples.size());
+    nlohmann::json scopes = AllocStats::snapshot()["scopes"];
+    if (scopes.contains(kScopeName)) {
+      state.counters["peak_live_bytes"] =
+          scopes[kScopeName]["peakLiveBytes"].get<double>();
+    }
+  }
+
+private:
+  static constexpr const char *kScopeName = "bench";
+
+  std::vector<double> samples;
+  size_t allocs{0};
+  size_t bytes{0};
+};
+
+struct HandlerCase {
+  const char *name;
+  bool resetEachIteration;
+  std::function<ApiResult(ExtendedControllerAPI &, const BenchContext &)> run;
+};
+
+// One entry per ExtendedControllerAPI handler.
+const std::vector<HandlerCase> &handlerCases() {
+  using Api = ExtendedControllerAPI;
+  using Ctx = BenchContext;
+  static const std::vector<HandlerCase> cases = {
+      {"addScene", true,
+       [](Api &api, const Ctx &) {
+         ExtendedProjectSceneAddReqBody req;
+         req.addPosition = 1;
+         req.duration = 10000;
+         return api.addScene(req);
+       }},
+      {"renameScene", false,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneRenameReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.name = "Renamed";
+         return api.renameScene(req);
+       }},
+      {"moveScene", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneMoveReqBody req;
+         req.uuid = c.sceneUuid;
+         req.newIndex = 0;
+         req.afterSceneUuid = c.reversedSceneUuids.front();
+         return api.moveScene(req);
+       }},
+      {"setSceneTime", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneSetTimeReqBody req;
+         req.sceneUuid = c.nextSceneUuid;
+         req.newDuration = 8000;
+         return api.setSceneTime(req);
+       }},
+      {"cutScene", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneCutReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.cutList = {{1000, 1500}, {4000, 4200}, {7000, 7600}};
+         return api.cutScene(req);
+       }},
+      {"cutSceneSilences", true,
+       [](Api &api, const Ctx &c) {
+         // Silence removal: 10ms out of every 40ms over the first 5s
+         ExtendedProjectSceneCutReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         for (int t = 30; t < 5000; t += 40) {
+           req.cutList.push_back({t, t + 10});
+         }
+         return api.cutScene(req);
+       }},
+      {"splitScene", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneSplitReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.splitTime = 5000;
+         return api.splitScene(req);
+       }},
+      {"mergeScenes", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneMergeReqBody req;
+         req.sceneUuids = {c.sceneUuid, c.nextSceneUuid};
+         return api.mergeScenes(req);
+       }},
+      {"deleteScene", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneDeleteReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         return api.deleteScene(req);
+       }},
+      {"addSceneAudio", true,
+       [](Api &api, const Ctx &c) {
+         AddSceneAudioReqBody req;
+         req.sceneUuid = c.blankSceneUuid;
+         req.entityUuid = c.assetUuid;
+         req.entityType = EntityTypeEnum::PROJECT_ASSET;
+         return api.addSceneAudio(req);
+       }},
+      {"clearFootage", true,
+       [](Api &api, const Ctx &c) {
+         ExtendedProjectSceneClearFootageReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         return api.clearFootage(req);
+       }},
+      {"replaceFootage", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneReplaceFootageReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.oldTimelineUuid = c.bRollUuid;
+         req.newAssetUuid = c.assetUuid;
+         return api.replaceFootage(req);
+       }},
+      {"adjustFootage", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneAdjustFootageReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.timelineUuid = c.bRollUuid;
+         req.startTime = 1200;
+         req.volume = 0.5;
+         return api.adjustFootage(req);
+       }},
+      {"addFootage", true,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneFootageAddReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.assetUuid = c.assetUuid;
+         req.timeOffsetInScene = 20000;
+         req.duration = 1000;
+         return api.addFootage(req);
+       }},
+      {"deleteFootage", true,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneFootageDeleteReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.timelineUuid = c.bRollUuid;
+         return api.deleteFootage(req);
+       }},
+      {"addVoiceOver", true,
+       [](Api &api, const Ctx &c) {
+         AddVoiceOverReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.assetUuid = c.assetUuid;
+         req.duration = 3000;
+         return api.addVoiceOver(req);
+       }},
+      {"deleteVoiceOver", true,
+       [](Api &api, const Ctx &c) {
+         DeleteVoiceOverReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.timelineUuid = c.voiceOverUuid;
+         return api.deleteVoiceOver(req);
+       }},
+      {"adjustVoiceOver", false,
+       [](Api &api, const Ctx &c) {
+         AdjustVoiceOverReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.timelineUuid = c.voiceOverUuid;
+         req.volume = 0.8;
+         return api.adjustVoiceOver(req);
+       }},
+      {"setPauseTime", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneSetPauseTimeReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.pauseTime = 500;
+         return api.setPauseTime(req);
+       }},
+      {"setSceneTransition", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneTransitionReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.type = "dissolve";
+         req.duration = 400;
+         return api.setSceneTransition(req);
+       }},
+      {"deleteTransition", false,
+       [](Api &api, const Ctx &c) { return api.deleteTransition(c.sceneUuid); }},
+      {"editScript", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneEditScriptReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.script.text = "An edited script for the benchmark scene";
+         return api.editScript(req);
+       }},
+      {"setSceneTranscript", false,
+       [](Api &api, const Ctx &c) {
+         ProjectSceneSetTranscriptReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.newText = "A new transcript for the benchmark scene";
+         req.pacePercent = 50;
+         return api.setSceneTranscript(req);
+       }},
+      {"changeHighlight", false,
+       [](Api &api, const Ctx &c) {
+         EditSceneHighLightReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.highLights = {"word1", "word2"};
+         return api.changeHighlight(req);
+       }},
+      {"setMainStoryOrder", true,
+       [](Api &api, const Ctx &c) {
+         SetMainStoryOrderReqBody req;
+         req.timelineUuids = c.reversedSceneUuids;
+         return api.setMainStoryOrder(req);
+       }},
+      {"changeFitType", false,
+       [](Api &api, const Ctx &) {
+         ChangeFitTypeReqBody req;
+         req.fitType = 1;
+         return api.changeFitType(req);
+       }},
+      {"changeScaleToAll", false,
+       [](Api &api, const Ctx &c) {
+         UpdateProjectScaleReqBody req;
+         req.timelineUuid = c.bRollUuid;
+         req.scale.scaleX = 1.1;
+         return api.changeScaleToAll(req);
+       }},
+      {"addBgm", false,
+       [](Api &api, const Ctx &c) {
+         ProjectBgmAddReqBody req;
+         req.assetUuid = c.assetUuid;
+         return api.addBgm(req);
+       }},
+      {"deleteBgm", true,
+       [](Api &api, const Ctx &c) {
+         ProjectBgmDeleteReqBody req;
+         req.timelineUuid = c.bgmUuid;
+         return api.deleteBgm(req);
+       }},
+      {"editBgm", false,
+       [](Api &api, const Ctx &c) {
+         ProjectBgmEditReqBody req;
+         req.bgmUuid = c.bgmUuid;
+         req.volume = 0.4;
+         return api.editBgm(req);
+       }},
+      {"adjustBgmAudio", false,
+       [](Api &api, const Ctx &c) {
+         PsSceneTimelineVolumeReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.timelineVolumes[c.bRollUuid] = 0.2;
+         return api.adjustBgmAudio(req);
+       }},
+      {"setSceneBgStyle", false,
+       [](Api &api, const Ctx &c) {
+         PsSceneBgStyleReqBody req;
+         req.sceneUuid = c.sceneUuid;
+         req.bgColor = "#000000";
+         return api.setSceneBgStyle(req);
+       }},
+      {"updateGraphicLayers", false,
+       [](Api &api, const Ctx &) {
+         ProjectGraphicLayerSettingsReqBody req;
+         req.layers.push_back({"layer-0", "text", 0, 2000, {{"text", "Hi"}}});
+         return api.updateGraphicLayers(req);
+       }},
+      {"createBgImage", false,
+       [](Api &api, const Ctx &) {
+         CreateWallpaperReqBody req;
+         req.prompt = "sunset";
+         return api.createBgImage(req);
+       }},
+      {"addBgImage", false,
+       [](Api &api, const Ctx &) {
+         PsBgImageBo req;
+         req.imageUrl = "https://cdn.example.com/bg.png";
+         return api.addBgImage(req);
+       }},
+      {"addAvatar", false,
+       [](Api &api, const Ctx &) {
+         ChangeLookReqBody req;
+         req.lookUuid = "look-0";
+         return api.addAvatar(req);
+       }},
+      {"replaceAvatar", false,
+       [](Api &api, const Ctx &) {
+         ChangeLookReqBody req;
+         req.lookUuid = "look-1";
+         return api.replaceAvatar(req);
+       }},
+      {"deleteAvatar", false,
+       [](Api &api, const Ctx &) { return api.deleteAvatar(); }},
+      {"clearDeletedAvatar", false,
+       [](Api &api, const Ctx &) { return api.clearDeletedAvatar(); }},
+      {"changeDeletedAvatar", false,
+       [](Api &api, const Ctx &) { return api.changeDeletedAvatar(); }},
+  };
+  return cases;
+}
+
+void runHandler(benchmark::State &state, const HandlerCase &handler) {
+  BenchProject project(specFromState(state));
+  CallRecorder recorder;
+  for (auto _ : state) {
+    if (handler.resetEachIteration) {
+      project.reset();
+    }
+    recorder.measure(state, [&] {
+      ApiResult result = handler.run(project.api(), project.context());
+      benchmark::DoNotOptimize(result);
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_LoadSceneList(benchmark::State &state) {
+  nlohmann::json sceneList = makeSceneListResponse(specFromState(state));
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      ExtendedProjectAndScenesVo project(sceneList);
+      benchmark::DoNotOptimize(project);
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_LoadEditor(benchmark::State &state) {
+  nlohmann::json sceneList = makeSceneListResponse(specFromState(state));
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      PJsonEditor editor(sceneList);
+      benchmark::DoNotOptimize(editor);
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_ConvertProjectAndSceneVo(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      auto vo = project.api().convertProjectToProjectAndSceneVo(
+          project.context().sceneUuid);
+      benchmark::DoNotOptimize(vo);
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_ConvertProjectAndScenesVo(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      auto vo = project.api().convertProjectToProjectAndScenesVo();
+      benchmark::DoNotOptimize(vo);
+    });
+  }
+  recorder.report(state);
+}
+
+// Assembles a scene from its own timelines. The inputs are copied outside
+// the measured region and moved in, as a caller that is done with them would.
+void BM_AssembleSceneAndTimelines(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  const ExtendedProjectScene *scene =
+      project.dataStore().findScene(project.context().sceneUuid);
+  std::vector<ExtendedTimeline> timelines = scene->aRolls;
+  timelines.insert(timelines.end(), scene->bRolls.begin(), scene->bRolls.end());
+  const std::unordered_map<std::string, ProjectSceneAsset> assetMap;
+  CallRecorder recorder;
+  for (auto _ : state) {
+    ExtendedProjectScene sceneCopy = *scene;
+    std::vector<ExtendedTimeline> timelinesCopy = timelines;
+    recorder.measure(state, [&] {
+      auto assembled = project.api().assembleSceneAndTimelines(
+          std::move(sceneCopy), std::move(timelinesCopy), assetMap);
+      benchmark::DoNotOptimize(assembled);
+    });
+  }
+  recorder.report(state);
+}
+
+// An auto-edit pass: one setSceneTime per scene (up to 100), issued as
+// separate calls or as one batch.
+std::vector<ExtendedProjectSceneSetTimeReqBody>
+setSceneTimePass(const BenchContext &ctx) {
+  std::vector<ExtendedProjectSceneSetTimeReqBody> ops;
+  for (const auto &uuid : ctx.reversedSceneUuids) {
+    if (ops.size() == 100) {
+      break;
+    }
+    ExtendedProjectSceneSetTimeReqBody req;
+    req.sceneUuid = uuid;
+    req.newDuration = 6000 + static_cast<int>(ops.size()) * 10;
+    ops.push_back(req);
+  }
+  return ops;
+}
+
+void BM_SetSceneTimeEach(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  const auto ops = setSceneTimePass(project.context());
+  CallRecorder recorder;
+  for (auto _ : state) {
+    project.reset();
+    recorder.measure(state, [&] {
+      for (const auto &op : ops) {
+        ApiResult result = project.api().setSceneTime(op);
+        benchmark::DoNotOptimize(result);
+      }
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_SetSceneTimeBatch(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  ProjectBatchReqBody batch;
+  for (const auto &op : setSceneTimePass(project.context())) {
+    batch.operations.push_back(op);
+  }
+  CallRecorder recorder;
+  for (auto _ : state) {
+    project.reset();
+    recorder.measure(state, [&] {
+      ApiResult result = project.api().batch(batch);
+      benchmark::DoNotOptimize(result);
+    });
+  }
+  recorder.report(state);
+}
+
+// Discards everything written to it.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+};
+
+// Full PJsonEditor::call path: route matching, body decoding, handler and
+// response construction.
+void BM_RouteRenameScene(benchmark::State &state) {
+  SyntheticProjectSpec spec = specFromState(state);
+  BenchProject project(spec);
+  PJsonEditor editor(project.sceneListResponse());
+  const BenchContext &ctx = project.context();
+  Request req{"PUT", "/v3/project/" + ctx.projectUuid + "/scene/rename",
+              {{"sceneUuid", ctx.sceneUuid}, {"name", "Routed"}},
+              {}};
+
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      Response resp = editor.call(req);
+      benchmark::DoNotOptimize(resp);
+    });
+  }
+  recorder.report(state);
+}
+
+// BM_RouteRenameScene with an op log attached (default checkpoint
+// interval), written to a discarding stream.
+void BM_OpLogAppend(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  PJsonEditor editor(project.sceneListResponse());
+  const BenchContext &ctx = project.context();
+  Request req{"PUT", "/v3/project/" + ctx.projectUuid + "/scene/rename",
+              {{"sceneUuid", ctx.sceneUuid}, {"name", "Logged"}},
+              {}};
+  NullBuffer nullBuffer;
+  std::ostream nullStream(&nullBuffer);
+  editor.setOpLog(std::make_shared<OpLog>(nullStream));
+
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      Response resp = editor.call(req);
+      benchmark::DoNotOptimize(resp);
+    });
+  }
+  recorder.report(state);
+}
+
+// Recovery from a checkpoint followed by 100 renames.
+void BM_OpLogRecover(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  const BenchContext &ctx = project.context();
+
+  std::stringstream stream;
+  {
+    PJsonEditor editor(project.sceneListResponse());
+    editor.setOpLog(std::make_shared<OpLog>(stream));
+    for (int i = 0; i < 100; ++i) {
+      editor.call({"PUT", "/v3/project/" + ctx.projectUuid + "/scene/rename",
+                   {{"sceneUuid", ctx.sceneUuid},
+                    {"name", "Logged " + std::to_string(i)}},
+                   {}});
+    }
+  }
+  const std::string bytes = stream.str();
+  PJsonEditor editor(nlohmann::json::object());
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      std::istringstream in(bytes);
+      RecoveredLog log;
+      bool ok = loadOpLog(in, log) && editor.recover(log);
+      benchmark::DoNotOptimize(ok);
+    });
+  }
+  state.counters["logBytes"] = static_cast<double>(bytes.size());
+  recorder.report(state);
+}
+
+// Host-boundary cost of a full scene list read. json_string mirrors the
+// wasm module's callJson (request text parsed, response dumped to text);
+// msgpack goes through BinaryBridge buffers. The JS side of both paths is
+// measured by bench/wasm_bridge_bench.mjs.
+void BM_BridgeJsonString(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  PJsonEditor editor(project.sceneListResponse());
+  const std::string requestText =
+      nlohmann::json{{"method", "GET"},
+                     {"url", "/v3/project/" + project.context().projectUuid +
+                                 "/scenes"},
+                     {"body", nlohmann::json::object()}}
+          .dump();
+  CallRecorder recorder;
+  size_t responseBytes = 0;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      nlohmann::json message = nlohmann::json::parse(requestText);
+      Response resp = editor.call({message["method"], message["url"],
+                                   std::move(message["body"]), {}});
+      std::string out = nlohmann::json{{"status", resp.status_code},
+                                       {"headers", resp.headers},
+                                       {"body", std::move(resp.body)}}
+                            .dump();
+      responseBytes = out.size();
+      benchmark::DoNotOptimize(out);
+    });
+  }
+  state.counters["responseBytes"] = static_cast<double>(responseBytes);
+  recorder.report(state);
+}
+
+void BM_BridgeMsgpack(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  PJsonEditor editor(project.sceneListResponse());
+  BinaryBridge bridge(editor);
+  const std::vector<uint8_t> request = nlohmann::json::to_msgpack(
+      {{"method", "GET"},
+       {"url", "/v3/project/" + project.context().projectUuid + "/scenes"},
+       {"body", nlohmann::json::object()}});
+  CallRecorder recorder;
+  size_t responseBytes = 0;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      std::copy(request.begin(), request.end(),
+                bridge.requestBuffer(request.size()));
+      responseBytes = bridge.call(request.size());
+      benchmark::DoNotOptimize(bridge.responseData());
+    });
+  }
+  state.counters["responseBytes"] = static_cast<double>(responseBytes);
+  recorder.report(state);
+}
+
+// Size of the ProjectAndSceneVo every per-scene edit returns, with the
+// project's whole asset map or only the scene's assets.
+void BM_SceneVo(benchmark::State &state, bool scoped) {
+  BenchProject project(specFromState(state));
+  BackendParityOptions options;
+  options.scopeSceneVoAssets = scoped;
+  project.api().setParityOptions(options);
+  CallRecorder recorder;
+  size_t responseBytes = 0;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      std::string out = project.api()
+                            .convertProjectToProjectAndSceneVo(
+                                project.context().sceneUuid)
+                            .dump();
+      responseBytes = out.size();
+      benchmark::DoNotOptimize(out);
+    });
+  }
+  state.counters["responseBytes"] = static_cast<double>(responseBytes);
+  recorder.report(state);
+}
+
+// Times spread over the whole project, for the playback queries below.
+std::vector<int32_t> scrubTimes(const ExtendedProjectAndScenesVo &project) {
+  const auto &scenes = project.scenes;
+  const int32_t length =
+      scenes.empty() ? 0 : scenes.back().timeOffsetInProject + scenes.back().duration;
+  std::vector<int32_t> times;
+  for (int32_t i = 0; i < 256; ++i) {
+    times.push_back(static_cast<int32_t>(static_cast<int64_t>(length) * i / 256));
+  }
+  return times;
+}
+
+// What a scrub query costs without the index: every scene and timeline.
+size_t countActiveLinear(const ExtendedProjectAndScenesVo &project, int32_t t) {
+  size_t active = 0;
+  for (const auto &scene : project.scenes) {
+    const int32_t start = scene.timeOffsetInProject;
+    if (t < start || t >= start + scene.duration) {
+      continue;
+    }
+    for (const auto *track : {&scene.aRolls, &scene.bRolls}) {
+      for (const auto &timeline : *track) {
+        const int32_t begin = start + timeline.timeOffsetInScene;
+        active += begin <= t && t < begin + timeline.duration;
+      }
+    }
+    for (const auto &voiceOver : scene.voiceOvers) {
+      active += voiceOver.timeOffsetInProject <= t &&
+                t < voiceOver.timeOffsetInProject + voiceOver.duration;
+    }
+  }
+  return active;
+}
+
+void BM_TimelineQueryLinear(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  const auto &vo = project.dataStore().getCurrentProjectData();
+  const std::vector<int32_t> times = scrubTimes(vo);
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      for (int32_t t : times) {
+        benchmark::DoNotOptimize(countActiveLinear(vo, t));
+      }
+    });
+  }
+  recorder.report(state);
+}
+
+void BM_TimelineQueryIndex(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  const std::vector<int32_t> times =
+      scrubTimes(project.dataStore().getCurrentProjectData());
+  project.dataStore().timelineIndex();
+  CallRecorder recorder;
+  for (auto _ : state) {
+    recorder.measure(state, [&] {
+      for (int32_t t : times) {
+        TimelineQueryResult result = project.dataStore().activeAt(t);
+        benchmark::DoNotOptimize(result);
+      }
+    });
+  }
+  recorder.report(state);
+}
+
+// One edit, then one query: the index refresh that edit costs.
+void BM_TimelineQueryAfterEdit(benchmark::State &state) {
+  BenchProject project(specFromState(state));
+  ExtendedProjectSceneRenameReqBody rename;
+  rename.sceneUuid = project.context().sceneUuid;
+  project.dataStore().timelineIndex();
+  CallRecorder recorder;
+  int round = 0;
+  for (auto _ : state) {
+    rename.name = "Renamed " + std::to_string(round++);
+    recorder.measure(state, [&] {
+      ApiResult result = project.api().renameScene(rename);
+      benchmark::DoNotOptimize(result);
+      TimelineQueryResult active = project.dataStore().activeAt(0);
+      benchmark::DoNotOptimize(active);
+    });
+  }
+  state.counters["rebuiltScenes"] =
+      static_cast<double>(project.dataStore().timelineIndex().rebuiltScenes());
+  recorder.report(state);
+}
+
+void applyShapes(benchmark::internal::Benchmark *bench,
+                 const std::vector<std::vector<int64_t>> &shapes = kProjectShapes) {
+  bench->ArgNames({"scenes", "timelines", "transcript", "assets"});
+  for (const auto &shape : shapes) {
+    bench->Args(shape);
+  }
+  bench->UseManualTime()->Unit(benchmark::kMicrosecond);
+}
+
+void registerBenchmarks() {
+  for (const auto &handler : handlerCases()) {
+    auto *bench = benchmark::RegisterBenchmark(
+        (std::string("BM_Handler/") + handler.name).c_str(),
+        [&handler](benchmark::State &state) { runHandler(state, handler); });
+    applyShapes(bench);
+    if (handler.resetEachIteration) {
+      bench->Iterations(kResetIterations);
+    }
+  }
+  applyShapes(benchmark::RegisterBenchmark("BM_LoadSceneList", BM_LoadSceneList));
+  applyShapes(benchmark::RegisterBenchmark("BM_LoadEditor", BM_LoadEditor));
+  applyShapes(benchmark::RegisterBenchmark("BM_ConvertProjectAndSceneVo",
+                                           BM_ConvertProjectAndSceneVo));
+  applyShapes(benchmark::RegisterBenchmark("BM_ConvertProjectAndScenesVo",
+                                           BM_ConvertProjectAndScenesVo));
+  applyShapes(
+      benchmark::RegisterBenchmark("BM_RouteRenameScene", BM_RouteRenameScene));
+  for (auto *bench :
+       {benchmark::RegisterBenchmark("BM_Batch/setSceneTime_each",
+                                     BM_SetSceneTimeEach),
+        benchmark::RegisterBenchmark("BM_Batch/setSceneTime_batch",
+                                     BM_SetSceneTimeBatch)}) {
+    applyShapes(bench);
+    bench->Iterations(kResetIterations / 10);
+  }
+
+  applyShapes(benchmark::RegisterBenchmark("BM_OpLog/append", BM_OpLogAppend));
+  auto *recoverBench =
+      benchmark::RegisterBenchmark("BM_OpLog/recover", BM_OpLogRecover);
+  applyShapes(recoverBench);
+  recoverBench->Iterations(kResetIterations / 10);
+
+  applyShapes(benchmark::RegisterBenchmark("BM_SceneVo/all_assets", BM_SceneVo,
+                                           false));
+  applyShapes(benchmark::RegisterBenchmark("BM_SceneVo/scoped_assets",
+                                           BM_SceneVo, true));
+
+  applyShapes(benchmark::RegisterBenchmark("BM_TimelineQuery/linear_scan",
+                                           BM_TimelineQueryLinear));
+  applyShapes(benchmark::RegisterBenchmark("BM_TimelineQuery/index",
+                                           BM_TimelineQueryIndex));
+  applyShapes(benchmark::RegisterBenchmark("BM_TimelineQuery/after_edit",
+                                           BM_TimelineQueryAfterEdit));
+
+  applyShapes(
+      benchmark::RegisterBenchmark("BM_Bridge/json_string", BM_BridgeJsonString));
+  applyShapes(benchmark::RegisterBenchmark("BM_Bridge/msgpack", BM_BridgeMsgpack));
+
+  for (const auto &handler : handlerCases()) {
+    if (std::find(kHeavySceneHandlers.begin(), kHeavySceneHandlers.end(),
+                  handler.name) == kHeavySceneHandlers.end()) {
+      continue;
+    }
+    auto *bench = benchmark::RegisterBenchmark(
+        (std::string("BM_HeavyScene/") + handler.name).c_str(),
+        [&handler](benchmark::State &state) { runHandler(state, handler); });
+    applyShapes(bench, kHeavySceneShapes);
+    bench->Iterations(kResetIterations);
+  }
+  applyShapes(benchmark::RegisterBenchmark("BM_HeavyScene/assembleSceneAndTimelines",
+                                           BM_AssembleSceneAndTimelines),
+              kHeavySceneShapes);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  registerBenchmarks();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,331 @@
+#include "synthetic_project.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ExtendedModels.h>
+#include <pjson_editor/TimelineKernels.h>
+#include <string>
+#include <vector>
+
+// Microbenchmarks for the timeline kernels. Each operation is measured as
+// the loop ExtendedControllerAPI runs in place over the model structs
+// ("aos") and as every kernel variant this machine supports over int32
+// columns. Overlap and clamp are also measured the way a handler would have
+// to call a kernel, gathering each scene's b-rolls into scratch columns
+// first ("scene_columns").
+using namespace pjson;
+using namespace pjson::bench;
+
+namespace {
+
+// {scenes, timelines per scene}
+const std::vector<std::vector<int64_t>> kShapes = {
+    {50, 4},
+    {500, 8},
+    {5000, 8},
+};
+
+std::shared_ptr<ExtendedProjectAndScenesVo>
+makeProject(const benchmark::State &state) {
+  SyntheticProjectSpec spec;
+  spec.sceneCount = static_cast<int>(state.range(0));
+  spec.timelinesPerScene = static_cast<int>(state.range(1));
+  spec.transcriptItems = 0;
+  return std::make_shared<ExtendedProjectAndScenesVo>(
+      makeSceneListResponse(spec));
+}
+
+// The columns TimelineHotBlock keeps, flattened over every b-roll.
+struct Columns {
+  std::vector<int32_t> offsets;
+  std::vector<int32_t> ends;
+  std::vector<int32_t> startTimes;
+  std::vector<int32_t> endTimes;
+  std::vector<int32_t> durations;
+};
+
+Columns bRollColumns(const ExtendedProjectAndScenesVo &project) {
+  Columns columns;
+  for (const auto &scene : project.scenes) {
+    for (const auto &timeline : scene.bRolls) {
+      columns.offsets.push_back(timeline.timeOffsetInProject);
+      columns.ends.push_back(timeline.timeOffsetInProject + timeline.duration);
+      columns.startTimes.push_back(timeline.startTime);
+      columns.endTimes.push_back(timeline.endTime);
+      columns.durations.push_back(timeline.duration);
+    }
+  }
+  return columns;
+}
+
+size_t timelineCount(const ExtendedProjectAndScenesVo &project) {
+  size_t count = 0;
+  for (const auto &scene : project.scenes) {
+    count += scene.aRolls.size() + scene.bRolls.size() + scene.voiceOvers.size();
+  }
+  return count;
+}
+
+// ---- add delta to every offset from scene 1 on ------------------------------
+
+void BM_ShiftAos(benchmark::State &state) {
+  auto project = makeProject(state);
+  int delta = 1;
+  for (auto _ : state) {
+    for (size_t i = 1; i < project->scenes.size(); ++i) {
+      auto &scene = project->scenes[i];
+      scene.timeOffsetInProject += delta;
+      for (auto &timeline : scene.aRolls) {
+        timeline.timeOffsetInProject += delta;
+      }
+      for (auto &timeline : scene.bRolls) {
+        timeline.timeOffsetInProject += delta;
+      }
+      for (auto &voiceOver : scene.voiceOvers) {
+        voiceOver.timeOffsetInProject += delta;
+      }
+    }
+    delta = -delta;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * timelineCount(*project));
+}
+
+// Includes writing the offsets back to the models.
+void BM_ShiftHotBlock(benchmark::State &state) {
+  ExtendedDataStore store;
+  store.init(makeProject(state));
+  store.timelineBlock();
+  int delta = 1;
+  for (auto _ : state) {
+    store.shiftScenes(1, delta);
+    delta = -delta;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          timelineCount(store.getCurrentProjectData()));
+}
+
+void BM_ShiftKernel(benchmark::State &state, const TimelineKernels *kernels) {
+  auto project = makeProject(state);
+  ExtendedDataStore store;
+  store.init(project);
+  std::vector<int32_t> offsets = store.timelineBlock().offsets;
+  int32_t delta = 1;
+  for (auto _ : state) {
+    kernels->addDelta(offsets.data(), offsets.size(), delta);
+    delta = -delta;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * offsets.size());
+}
+
+// ---- overlap of one interval against every b-roll ---------------------------
+
+// Probe past the end of the project so every interval is tested.
+int32_t missProbe(const ExtendedProjectAndScenesVo &project) {
+  const auto &last = project.scenes.back();
+  return last.timeOffsetInProject + last.duration + 1000;
+}
+
+bool isFootage(const ExtendedTimeline &timeline) {
+  return timeline.category == ProjectTimelineCategoryEnum::FOOTAGE ||
+         timeline.category == ProjectTimelineCategoryEnum::BROLL;
+}
+
+size_t bRollCount(const ExtendedProjectAndScenesVo &project) {
+  size_t count = 0;
+  for (const auto &scene : project.scenes) {
+    count += scene.bRolls.size();
+  }
+  return count;
+}
+
+// addFootage's check, once per scene.
+void BM_OverlapAos(benchmark::State &state) {
+  auto project = makeProject(state);
+  const int newStart = missProbe(*project);
+  const int newEnd = newStart + 500;
+  for (auto _ : state) {
+    for (const auto &scene : project->scenes) {
+      bool overlap = std::any_of(
+          scene.bRolls.begin(), scene.bRolls.end(),
+          [newStart, newEnd](const ExtendedTimeline &timeline) {
+            return isFootage(timeline) &&
+                   timeline.timeOffsetInProject < newEnd &&
+                   newStart < timeline.timeOffsetInProject + timeline.duration;
+          });
+      benchmark::DoNotOptimize(overlap);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * bRollCount(*project));
+}
+
+void BM_OverlapSceneColumns(benchmark::State &state) {
+  auto project = makeProject(state);
+  const TimelineKernels &kernels = timelineKernels();
+  const int32_t newStart = missProbe(*project);
+  for (auto _ : state) {
+    for (const auto &scene : project->scenes) {
+      std::vector<int32_t> starts;
+      std::vector<int32_t> ends;
+      starts.reserve(scene.bRolls.size());
+      ends.reserve(scene.bRolls.size());
+      for (const auto &timeline : scene.bRolls) {
+        if (isFootage(timeline)) {
+          starts.push_back(timeline.timeOffsetInProject);
+          ends.push_back(timeline.timeOffsetInProject + timeline.duration);
+        }
+      }
+      benchmark::DoNotOptimize(kernels.findOverlap(
+          starts.data(), ends.data(), starts.size(), newStart, newStart + 500));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * bRollCount(*project));
+}
+
+void BM_OverlapKernel(benchmark::State &state, const TimelineKernels *kernels) {
+  auto project = makeProject(state);
+  Columns columns = bRollColumns(*project);
+  const int32_t newStart = missProbe(*project);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernels->findOverlap(
+        columns.offsets.data(), columns.ends.data(), columns.offsets.size(),
+        newStart, newStart + 500));
+  }
+  state.SetItemsProcessed(state.iterations() * columns.offsets.size());
+}
+
+// ---- clamp endTime to startTime + maxDuration -------------------------------
+
+constexpr int kClampDuration = 4000;
+
+// Puts back the end times and durations a clamp changed.
+void restoreBRolls(ExtendedProjectAndScenesVo &project, const Columns &pristine) {
+  size_t i = 0;
+  for (auto &scene : project.scenes) {
+    for (auto &timeline : scene.bRolls) {
+      timeline.endTime = pristine.endTimes[i];
+      timeline.duration = pristine.durations[i];
+      ++i;
+    }
+  }
+}
+
+// setSceneTime's clamp, once per scene.
+void BM_ClampAos(benchmark::State &state) {
+  auto project = makeProject(state);
+  const Columns pristine = bRollColumns(*project);
+  for (auto _ : state) {
+    state.PauseTiming();
+    restoreBRolls(*project, pristine);
+    state.ResumeTiming();
+    for (auto &scene : project->scenes) {
+      for (auto &footage : scene.bRolls) {
+        if (footage.endTime > footage.startTime + kClampDuration) {
+          footage.endTime = footage.startTime + kClampDuration;
+          footage.duration = kClampDuration;
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * pristine.startTimes.size());
+}
+
+void BM_ClampSceneColumns(benchmark::State &state) {
+  auto project = makeProject(state);
+  const TimelineKernels &kernels = timelineKernels();
+  const Columns pristine = bRollColumns(*project);
+  for (auto _ : state) {
+    state.PauseTiming();
+    restoreBRolls(*project, pristine);
+    state.ResumeTiming();
+    for (auto &scene : project->scenes) {
+      const size_t count = scene.bRolls.size();
+      std::vector<int32_t> startTimes(count);
+      std::vector<int32_t> endTimes(count);
+      std::vector<int32_t> durations(count);
+      for (size_t i = 0; i < count; ++i) {
+        startTimes[i] = scene.bRolls[i].startTime;
+        endTimes[i] = scene.bRolls[i].endTime;
+        durations[i] = scene.bRolls[i].duration;
+      }
+      if (kernels.clampEndTimes(startTimes.data(), endTimes.data(),
+                                durations.data(), count, kClampDuration) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+          scene.bRolls[i].endTime = endTimes[i];
+          scene.bRolls[i].duration = durations[i];
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * pristine.startTimes.size());
+}
+
+void BM_ClampKernel(benchmark::State &state, const TimelineKernels *kernels) {
+  auto project = makeProject(state);
+  const Columns pristine = bRollColumns(*project);
+  Columns columns = pristine;
+  for (auto _ : state) {
+    state.PauseTiming();
+    columns.endTimes = pristine.endTimes;
+    columns.durations = pristine.durations;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(kernels->clampEndTimes(
+        columns.startTimes.data(), columns.endTimes.data(),
+        columns.durations.data(), columns.startTimes.size(), kClampDuration));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * pristine.startTimes.size());
+}
+
+void applyShapes(benchmark::internal::Benchmark *bench) {
+  bench->ArgNames({"scenes", "timelines"});
+  for (const auto &shape : kShapes) {
+    bench->Args(shape);
+  }
+  bench->Unit(benchmark::kNanosecond);
+}
+
+void registerBenchmarks() {
+  applyShapes(benchmark::RegisterBenchmark("BM_Shift/aos", BM_ShiftAos));
+  applyShapes(
+      benchmark::RegisterBenchmark("BM_Shift/hot_block", BM_ShiftHotBlock));
+  applyShapes(benchmark::RegisterBenchmark("BM_Overlap/aos", BM_OverlapAos));
+  applyShapes(benchmark::RegisterBenchmark("BM_Overlap/scene_columns",
+                                           BM_OverlapSceneColumns));
+  applyShapes(benchmark::RegisterBenchmark("BM_Clamp/aos", BM_ClampAos));
+  applyShapes(benchmark::RegisterBenchmark("BM_Clamp/scene_columns",
+                                           BM_ClampSceneColumns));
+  for (KernelIsa isa : {KernelIsa::SCALAR, KernelIsa::SSE41, KernelIsa::AVX2,
+                        KernelIsa::WASM_SIMD128}) {
+    const TimelineKernels *kernels = timelineKernelsFor(isa);
+    if (!kernels) {
+      continue;
+    }
+    const std::string suffix = std::string("/") + kernels->name;
+    applyShapes(benchmark::RegisterBenchmark(
+        ("BM_Shift" + suffix).c_str(), BM_ShiftKernel, kernels));
+    applyShapes(benchmark::RegisterBenchmark(
+        ("BM_Overlap" + suffix).c_str(), BM_OverlapKernel, kernels));
+    applyShapes(benchmark::RegisterBenchmark(
+        ("BM_Clamp" + suffix).c_str(), BM_ClampKernel, kernels));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  registerBenchmarks();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,243 @@
+// Replays a session captured by pjson::SessionRecorder against
+// PJsonEditor::call and reports throughput.
+//
+//   pjson_replay <session.jsonl> [--repeat N]
+//   pjson_replay --synthesize <out.jsonl> [--seed S] [--scenes N]
+//                [--requests N]
+//
+// --synthesize builds a replay corpus without a backend: it generates a
+// seeded project, drives an editor with a deterministic request mix and
+// records the session through SessionRecorder.
+#include "synthetic_project.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <pjson_editor/SessionRecorder.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include <string>
+#include <vector>
+
+using namespace pjson;
+using namespace pjson::bench;
+
+namespace {
+
+// "POST /v3/project/p/scene/s/transition/set" -> "POST transition/set"
+std::string routeKey(const Request &req) {
+  const std::string &url = req.url;
+  size_t last = url.rfind('/');
+  size_t prev = last == std::string::npos || last == 0
+                    ? std::string::npos
+                    : url.rfind('/', last - 1);
+  std::string tail = prev == std::string::npos ? url : url.substr(prev + 1);
+  return req.method + " " + tail;
+}
+
+struct RouteStats {
+  size_t calls{0};
+  double totalUs{0};
+  std::vector<double> samplesUs;
+};
+
+double percentile(std::vector<double> &values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  return values[static_cast<size_t>(p * (values.size() - 1))];
+}
+
+int replay(const std::string &path, int repeat) {
+  RecordedSession session;
+  std::string error;
+  if (!loadSession(path, session, &error)) {
+    std::cerr << "pjson_replay: " << error << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, RouteStats> routes;
+  std::vector<double> allUs;
+  size_t statusMismatches = 0;
+  double loadUs = 0;
+  double callUs = 0;
+  for (int r = 0; r < repeat; ++r) {
+    auto loadStart = std::chrono::steady_clock::now();
+    PJsonEditor editor(session.sceneList);
+    loadUs += std::chrono::duration<double, std::micro>(
+                  std::chrono::steady_clock::now() - loadStart)
+                  .count();
+
+    for (const RecordedCall &call : session.calls) {
+      auto start = std::chrono::steady_clock::now();
+      Response resp = editor.call(call.request);
+      double us = std::chrono::duration<double, std::micro>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+      callUs += us;
+      allUs.push_back(us);
+      RouteStats &stats = routes[routeKey(call.request)];
+      ++stats.calls;
+      stats.totalUs += us;
+      stats.samplesUs.push_back(us);
+      if (call.statusCode != 0 && resp.status_code != call.statusCode) {
+        ++statusMismatches;
+      }
+    }
+  }
+
+  const size_t calls = allUs.size();
+  double recordedUs = 0;
+  for (const RecordedCall &call : session.calls) {
+    recordedUs += static_cast<double>(call.elapsedUs);
+  }
+
+  std::printf("session          %s\n", path.c_str());
+  std::printf("requests         %zu x %d repeat(s)\n", session.calls.size(),
+              repeat);
+  std::printf("load             %.1f us/editor\n", loadUs / repeat);
+  std::printf("replay           %.1f ms total, %.0f req/s\n", callUs / 1000.0,
+              callUs > 0 ? calls / (callUs / 1e6) : 0.0);
+  std::printf("latency          p50 %.1f us, p90 %.1f us, p99 %.1f us\n",
+              percentile(allUs, 0.50), percentile(allUs, 0.90),
+              percentile(allUs, 0.99));
+  if (recordedUs > 0) {
+    std::printf("recorded         %.1f ms total per pass\n", recordedUs / 1000.0);
+  }
+  std::printf("status mismatch  %zu\n\n", statusMismatches);
+
+  std::printf("%-28s %8s %12s %12s\n", "route", "calls", "mean_us", "p99_us");
+  for (auto &[key, stats] : routes) {
+    std::printf("%-28s %8zu %12.1f %12.1f\n", key.c_str(), stats.calls,
+                stats.totalUs / stats.calls,
+                percentile(stats.samplesUs, 0.99));
+  }
+  return statusMismatches == 0 ? 0 : 2;
+}
+
+int synthesize(const std::string &path, const SyntheticProjectSpec &spec,
+               int requestCount) {
+  nlohmann::json sceneList = makeSceneListResponse(spec);
+  const nlohmann::json &data = sceneList["data"];
+  const std::string projectUuid = data["projectUuid"];
+  const std::string base = "/v3/project/" + projectUuid;
+
+  std::vector<std::string> movable;
+  std::vector<std::string> all;
+  for (const auto &scene : data["scenes"]) {
+    std::string type = scene["sceneType"];
+    all.push_back(scene["sceneUuid"]);
+    if (type != "intro" && type != "outro") {
+      movable.push_back(scene["sceneUuid"]);
+    }
+  }
+  if (movable.empty()) {
+    std::cerr << "pjson_replay: project has no editable scenes" << std::endl;
+    return 1;
+  }
+
+  auto recorder = std::make_shared<SessionRecorder>(path, sceneList);
+  if (!recorder->isOpen()) {
+    std::cerr << "pjson_replay: cannot write " << path << std::endl;
+    return 1;
+  }
+
+  PJsonEditor editor(sceneList);
+  editor.setSessionRecorder(recorder);
+  SyntheticRng rng(spec.seed ^ 0x5EEDULL);
+  static const std::vector<std::string> transitions = {"fade", "dissolve",
+                                                       "slide", "none"};
+  for (int i = 0; i < requestCount; ++i) {
+    const std::string &sceneUuid = rng.pick(movable);
+    double kind = rng.unit();
+    Request req;
+    if (kind < 0.25) {
+      req = {"PUT",
+             base + "/scene/rename",
+             {{"sceneUuid", sceneUuid},
+              {"name", "Scene " + std::to_string(i)}},
+             {}};
+    } else if (kind < 0.40) {
+      req = {"POST",
+             base + "/scene/move",
+             {{"uuid", sceneUuid},
+              {"newIndex", 0},
+              {"afterSceneUuid", rng.pick(movable)}},
+             {}};
+    } else if (kind < 0.60) {
+      req = {"POST",
+             base + "/scene/time/set",
+             {{"sceneUuid", sceneUuid},
+              {"newDuration", rng.range(3, 20) * 1000}},
+             {}};
+    } else if (kind < 0.80) {
+      req = {"POST",
+             base + "/scene/" + sceneUuid + "/transition/set",
+             {{"sceneUuid", sceneUuid},
+              {"projectUuid", projectUuid},
+              {"type", rng.pick(transitions)},
+              {"duration", rng.range(2, 10) * 100}},
+             {}};
+    } else {
+      req = {"POST",
+             base + "/scene/" + sceneUuid + "/script/edit",
+             {{"sceneUuid", sceneUuid},
+              {"script",
+               {{"text", "Edited script " + std::to_string(i)},
+                {"modified", true}}}},
+             {}};
+    }
+    editor.call(req);
+  }
+  std::printf("wrote %zu requests over %zu scenes to %s\n",
+              recorder->recordedCount(), all.size(), path.c_str());
+  return 0;
+}
+
+int usage() {
+  std::cerr << "usage: pjson_replay <session.jsonl> [--repeat N]\n"
+               "       pjson_replay --synthesize <out.jsonl> [--seed S] "
+               "[--scenes N] [--requests N]"
+            << std::endl;
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string sessionPath;
+  std::string synthesizePath;
+  int repeat = 1;
+  int requestCount = 1000;
+  SyntheticProjectSpec spec;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--repeat" && hasValue) {
+      repeat = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--synthesize" && hasValue) {
+      synthesizePath = argv[++i];
+    } else if (arg == "--seed" && hasValue) {
+      spec.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--scenes" && hasValue) {
+      spec.sceneCount = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--requests" && hasValue) {
+      requestCount = std::max(0, std::atoi(argv[++i]));
+    } else if (!arg.empty() && arg[0] != '-' && sessionPath.empty()) {
+      sessionPath = arg;
+    } else {
+      return usage();
+    }
+  }
+
+  if (!synthesizePath.empty()) {
+    return synthesize(synthesizePath, spec, requestCount);
+  }
+  if (sessionPath.empty()) {
+    return usage();
+  }
+  return replay(sessionPath, repeat);
+}
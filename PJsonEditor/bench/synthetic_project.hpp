@@ -0,0 +1,307 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace pjson {
+namespace bench {
+
+// Shape of a generated project. The same spec (including the seed) always
+// produces the same payload, on every platform.
+//
+// Scene layout: an optional intro, then default scenes with a blank scene
+// sprinkled in at roughly blankSceneRatio, then an optional outro. Default
+// scenes pick one of three footage mixes (a-roll + b-rolls, a-roll only,
+// b-rolls only) with up to timelinesPerScene timelines, and get a voice-over
+// at roughly voiceOverRatio.
+struct SyntheticProjectSpec {
+  uint64_t seed{1};
+  int sceneCount{50};
+  int timelinesPerScene{4};
+  int transcriptItems{40}; // average timed words per default scene
+  int assetCount{100};
+  int sceneDuration{10000}; // average scene duration in ms
+  int bgmCount{1};
+  bool withIntro{true};
+  bool withOutro{true};
+  double blankSceneRatio{0.1};
+  double voiceOverRatio{0.5};
+};
+
+// splitmix64. Used instead of <random> distributions, whose output is
+// implementation defined, so a seed names the same corpus everywhere.
+class SyntheticRng {
+public:
+  explicit SyntheticRng(uint64_t seed) : state(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform integer in [lo, hi].
+  int range(int lo, int hi) {
+    if (hi <= lo) {
+      return lo;
+    }
+    uint64_t span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo) + 1;
+    return lo + static_cast<int>(next() % span);
+  }
+
+  // Uniform double in [0, 1).
+  double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+  bool chance(double p) { return unit() < p; }
+
+  template <typename T> const T &pick(const std::vector<T> &values) {
+    return values[static_cast<size_t>(range(0, static_cast<int>(values.size()) - 1))];
+  }
+
+private:
+  uint64_t state;
+};
+
+inline std::string syntheticUuid(const char *prefix, int a, int b = -1) {
+  std::string uuid = prefix;
+  uuid += "-" + std::to_string(a);
+  if (b >= 0) {
+    uuid += "-" + std::to_string(b);
+  }
+  return uuid;
+}
+
+namespace detail {
+
+enum class FootageMix { AROLL_AND_BROLLS, AROLL_ONLY, BROLLS_ONLY };
+
+inline const std::vector<std::string> &transcriptWords() {
+  static const std::vector<std::string> words = {
+      "welcome", "to",     "the",    "quarterly", "product", "update",
+      "today",   "we",     "will",   "walk",      "through", "our",
+      "new",     "editor", "scenes", "footage",   "and",     "voice",
+      "over",    "so",     "let's",  "get",       "started", "right",
+      "now",     "with",   "a",      "quick",     "demo",    "of",
+  };
+  return words;
+}
+
+// Splits [0, total) into `parts` contiguous, non-empty segments.
+inline std::vector<int> splitPoints(SyntheticRng &rng, int total, int parts) {
+  std::vector<int> points = {0};
+  for (int i = 1; i < parts; ++i) {
+    int lo = points.back() + 1;
+    int hi = total - (parts - i);
+    points.push_back(rng.range(lo, std::max(lo, hi)));
+  }
+  points.push_back(total);
+  return points;
+}
+
+inline nlohmann::json makeTimeline(const std::string &uuid,
+                                   const std::string &sceneUuid,
+                                   const std::string &assetUuid,
+                                   int timeOffsetInProject, int startTime,
+                                   int duration, double volume,
+                                   const char *category) {
+  return {{"timelineUuid", uuid},
+          {"sceneUuid", sceneUuid},
+          {"assetUuid", assetUuid},
+          {"timeOffsetInProject", timeOffsetInProject},
+          {"startTime", startTime},
+          {"endTime", startTime + duration},
+          {"timelineDuration", duration},
+          {"volume", volume},
+          {"category", category}};
+}
+
+// Timed words covering roughly the whole scene, with small pauses between
+// sentences.
+inline nlohmann::json makeTranscript(SyntheticRng &rng, int itemCount,
+                                     int sceneDuration) {
+  nlohmann::json items = nlohmann::json::array();
+  if (itemCount <= 0) {
+    return {{"items", items}};
+  }
+  const int slot = std::max(1, sceneDuration / itemCount);
+  int cursor = 0;
+  for (int i = 0; i < itemCount && cursor < sceneDuration; ++i) {
+    int length = rng.range(std::max(1, slot / 2), std::max(1, slot - 1));
+    int end = std::min(sceneDuration, cursor + length);
+    items.push_back({{"text", rng.pick(transcriptWords())},
+                     {"startMs", cursor},
+                     {"endMs", end}});
+    cursor = end + (rng.chance(0.15) ? slot / 2 : 1);
+  }
+  return {{"items", items}};
+}
+
+} // namespace detail
+
+// Builds a /v3/project/{projectUuid}/scene/list response in the format the
+// ExtendedProjectAndScenesVo constructor reads.
+inline nlohmann::json makeSceneListResponse(const SyntheticProjectSpec &spec) {
+  using detail::FootageMix;
+  SyntheticRng rng(spec.seed);
+
+  const std::string projectUuid = "bench-project";
+  const int assetCount = spec.assetCount > 0 ? spec.assetCount : 1;
+  const int avgDuration = std::max(2000, spec.sceneDuration);
+
+  nlohmann::json data;
+  data["projectUuid"] = projectUuid;
+  data["ownerUuid"] = "bench-owner";
+  data["status"] = "active";
+
+  // Assets: mostly video, with images and audio mixed in. Audio assets are
+  // also what bgms and voice-overs point at.
+  nlohmann::json assets = nlohmann::json::object();
+  std::vector<std::string> videoAssets;
+  std::vector<std::string> audioAssets;
+  for (int i = 0; i < assetCount; ++i) {
+    std::string assetUuid = syntheticUuid("asset", i);
+    double kind = rng.unit();
+    const char *assetType = kind < 0.7 ? "video" : kind < 0.85 ? "image" : "audio";
+    const bool audio = std::string(assetType) == "audio";
+    const bool image = std::string(assetType) == "image";
+    nlohmann::json asset = {
+        {"assetUuid", assetUuid},
+        {"assetLink", "https://cdn.example.com/media/" + assetUuid +
+                          (audio ? ".m4a" : image ? ".png" : ".mp4")},
+        {"assetType", assetType},
+        {"duration", image ? 0 : rng.range(30000, 600000)}};
+    if (!audio) {
+      bool portrait = rng.chance(0.2);
+      asset["width"] = portrait ? 1080 : 1920;
+      asset["height"] = portrait ? 1920 : 1080;
+    }
+    if (!image) {
+      asset["audioLink"] = "https://cdn.example.com/media/" + assetUuid + ".m4a";
+    }
+    assets[assetUuid] = asset;
+    (audio ? audioAssets : videoAssets).push_back(assetUuid);
+  }
+  if (videoAssets.empty()) {
+    videoAssets.push_back(syntheticUuid("asset", 0));
+  }
+  if (audioAssets.empty()) {
+    audioAssets.push_back(videoAssets.front());
+  }
+  data["assets"] = assets;
+
+  nlohmann::json scenes = nlohmann::json::array();
+  int offset = 0;
+  for (int s = 0; s < spec.sceneCount; ++s) {
+    const std::string sceneUuid = syntheticUuid("scene", s);
+    const bool intro = spec.withIntro && s == 0 && spec.sceneCount > 1;
+    const bool outro =
+        spec.withOutro && s == spec.sceneCount - 1 && spec.sceneCount > 1;
+    const bool blank =
+        !intro && !outro && rng.chance(spec.blankSceneRatio);
+    const char *sceneType =
+        intro ? "intro" : outro ? "outro" : blank ? "blankScene" : "default";
+    const int duration = (intro || outro)
+                             ? rng.range(3000, 5000)
+                             : rng.range(avgDuration / 2, avgDuration * 3 / 2);
+
+    nlohmann::json scene;
+    scene["sceneUuid"] = sceneUuid;
+    scene["projectUuid"] = projectUuid;
+    scene["name"] = intro ? "Intro" : outro ? "Outro" : "Scene " + std::to_string(s + 1);
+    scene["duration"] = duration;
+    scene["timeOffsetInProject"] = offset;
+    scene["pauseTime"] = rng.chance(0.2) ? rng.range(100, 1000) : 0;
+    scene["audioFlag"] = 0;
+    scene["sceneType"] = sceneType;
+
+    nlohmann::json arolls = nlohmann::json::array();
+    nlohmann::json brolls = nlohmann::json::array();
+    nlohmann::json voiceOvers = nlohmann::json::array();
+    if (!blank && spec.timelinesPerScene > 0) {
+      FootageMix mix = FootageMix::AROLL_ONLY;
+      if (!intro && !outro) {
+        double roll = rng.unit();
+        mix = roll < 0.6    ? FootageMix::AROLL_AND_BROLLS
+              : roll < 0.85 ? FootageMix::AROLL_ONLY
+                            : FootageMix::BROLLS_ONLY;
+      }
+
+      if (mix != FootageMix::BROLLS_ONLY) {
+        arolls.push_back(detail::makeTimeline(
+            syntheticUuid("aroll", s), sceneUuid, rng.pick(videoAssets),
+            offset, rng.range(0, 20) * 500, duration, 1.0, "MAIN_STORY"));
+      }
+
+      int brollCount = 0;
+      if (mix == FootageMix::AROLL_AND_BROLLS) {
+        brollCount = std::max(1, rng.range(1, spec.timelinesPerScene - 1));
+      } else if (mix == FootageMix::BROLLS_ONLY) {
+        brollCount = rng.range(1, spec.timelinesPerScene);
+      }
+      brollCount = std::min(brollCount, duration);
+      std::vector<int> points = detail::splitPoints(rng, duration, brollCount);
+      for (int b = 0; b < brollCount; ++b) {
+        brolls.push_back(detail::makeTimeline(
+            syntheticUuid("broll", s, b), sceneUuid, rng.pick(videoAssets),
+            offset + points[b], rng.range(0, 40) * 250,
+            points[b + 1] - points[b], 0.3, "FOOTAGE"));
+      }
+
+      if (!intro && !outro && rng.chance(spec.voiceOverRatio)) {
+        int voiceDuration = rng.range(duration / 2, duration);
+        nlohmann::json voiceOver = detail::makeTimeline(
+            syntheticUuid("voice", s), sceneUuid, rng.pick(audioAssets), offset,
+            0, voiceDuration, 1.0, "VOICE_OVER");
+        voiceOver.erase("timelineUuid");
+        voiceOver.erase("category");
+        voiceOver["voiceUuid"] = syntheticUuid("voice", s);
+        voiceOver["projectUuid"] = projectUuid;
+        voiceOvers.push_back(voiceOver);
+      }
+    }
+    scene["arolls"] = arolls;
+    scene["brolls"] = brolls;
+    scene["voiceOvers"] = voiceOvers;
+
+    if (!blank && !intro && !outro && spec.transcriptItems > 0) {
+      int spread = std::max(1, spec.transcriptItems / 4);
+      int itemCount = rng.range(std::max(1, spec.transcriptItems - spread),
+                                spec.transcriptItems + spread);
+      scene["transcript"] = detail::makeTranscript(rng, itemCount, duration);
+      scene["transcriptModified"] = rng.chance(0.1);
+    }
+
+    nlohmann::json transitions = nlohmann::json::array();
+    if (s + 1 < spec.sceneCount && rng.chance(0.7)) {
+      static const std::vector<std::string> types = {"fade", "dissolve",
+                                                     "slide", "zoom"};
+      transitions.push_back(
+          {{"type", rng.pick(types)}, {"duration", rng.range(2, 10) * 100}});
+    }
+    scene["transitions"] = transitions;
+
+    scenes.push_back(scene);
+    offset += duration;
+  }
+  data["scenes"] = scenes;
+
+  nlohmann::json bgms = nlohmann::json::array();
+  for (int i = 0; i < spec.bgmCount; ++i) {
+    const std::string &assetUuid = rng.pick(audioAssets);
+    bgms.push_back(
+        {{"assetUuid", assetUuid},
+         {"assetLink", "https://cdn.example.com/media/" + assetUuid + ".m4a"},
+         {"timelineUuid", syntheticUuid("bgm", i)},
+         {"duration", offset},
+         {"volume", 0.2 + 0.1 * rng.range(0, 6)}});
+  }
+  data["bgms"] = bgms;
+
+  return {{"code", 0}, {"msg", "success"}, {"data", data}};
+}
+
+} // namespace bench
+} // namespace pjson
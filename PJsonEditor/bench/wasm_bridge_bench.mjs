@@ -0,0 +1,103 @@
+// Compares the two ways of calling the wasm module from JS: JSON text
+// (Editor.callJson) and MessagePack bytes (Editor.call), both through the
+// module's linear-memory buffers.
+//
+//   npm install @msgpack/msgpack
+//   node bench/wasm_bridge_bench.mjs <build>/pjson_wasm.js [scenes] [iterations]
+//
+// Both paths are timed end to end as a JS caller sees them: building the
+// request, the call, and turning the response back into JS objects.
+import { createRequire } from 'node:module';
+import { performance } from 'node:perf_hooks';
+import path from 'node:path';
+import { encode, decode } from '@msgpack/msgpack';
+
+const [modulePath, sceneArg = '200', iterationArg = '200'] = process.argv.slice(2);
+if (!modulePath) {
+  console.error('usage: node wasm_bridge_bench.mjs <pjson_wasm.js> [scenes] [iterations]');
+  process.exit(1);
+}
+const sceneCount = Number(sceneArg);
+const iterations = Number(iterationArg);
+
+const require = createRequire(import.meta.url);
+const createModule = require(path.resolve(modulePath));
+const Module = await createModule();
+
+function sceneList(count) {
+  const scenes = [];
+  for (let i = 0; i < count; ++i) {
+    const uuid = `scene-${i}`;
+    scenes.push({
+      sceneUuid: uuid,
+      projectUuid: 'p1',
+      name: `Scene ${i}`,
+      duration: 5000,
+      timeOffsetInProject: i * 5000,
+      sceneType: 'default',
+      transcript: {
+        items: [
+          { text: 'hello', startMs: 0, endMs: 400 },
+          { text: 'world', startMs: 400, endMs: 900 },
+        ],
+      },
+      arolls: [{
+        timelineUuid: `a-${i}`, sceneUuid: uuid, assetUuid: 'asset',
+        timeOffsetInProject: i * 5000, startTime: 0, endTime: 5000,
+        timelineDuration: 5000,
+      }],
+    });
+  }
+  return {
+    code: 0,
+    msg: 'success',
+    data: {
+      projectUuid: 'p1',
+      scenes,
+      assets: { asset: { assetUuid: 'asset', assetType: 'video', duration: 60000 } },
+    },
+  };
+}
+
+const requests = [
+  { name: 'read scenes', make: () => ({ method: 'GET', url: '/v3/project/p1/scenes', body: {} }) },
+  {
+    name: 'rename scene',
+    make: (i) => ({
+      method: 'PUT',
+      url: '/v3/project/p1/scene/rename',
+      body: { sceneUuid: 'scene-0', name: `Renamed ${i}` },
+    }),
+  },
+];
+
+function jsonCall(editor, request) {
+  return editor.callJson(request);
+}
+
+function binaryCall(editor, request) {
+  return decode(editor.call(encode(request)));
+}
+
+function time(label, call, request) {
+  const editor = new Module.Editor(JSON.stringify(sceneList(sceneCount)));
+  for (let i = 0; i < 10; ++i) call(editor, request.make(i));
+  const start = performance.now();
+  for (let i = 0; i < iterations; ++i) {
+    const response = call(editor, request.make(i));
+    if (response.status !== 200) throw new Error(`${label}: status ${response.status}`);
+  }
+  const perCall = ((performance.now() - start) * 1000) / iterations;
+  editor.delete();
+  return perCall;
+}
+
+console.log(`${sceneCount} scenes, ${iterations} iterations`);
+for (const request of requests) {
+  const json = time('json', jsonCall, request);
+  const binary = time('msgpack', binaryCall, request);
+  console.log(
+    `${request.name.padEnd(14)} json ${json.toFixed(1).padStart(9)} us` +
+      `   msgpack ${binary.toFixed(1).padStart(9)} us   x${(json / binary).toFixed(2)}`,
+  );
+}
@@ -0,0 +1,75 @@
+#ifndef PJSON_EDITOR_ALLOC_STATS_H
+#define PJSON_EDITOR_ALLOC_STATS_H
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+
+namespace pjson {
+
+/**
+ * Opt-in heap instrumentation (configure with -DPJSON_ALLOC_STATS=ON).
+ *
+ * When enabled the library replaces the global operator new/delete and
+ * PJSON_ALLOC_SCOPE(name) accumulates, per name, the allocations, bytes and
+ * peak live bytes of everything that ran on the calling thread inside the
+ * scope. Every ExtendedControllerAPI handler and every routed URL opens one.
+ *
+ * When disabled the macro expands to nothing, no allocator is replaced and
+ * the queries below report {"enabled": false}.
+ */
+struct AllocCounters {
+    uint64_t allocations{0};
+    uint64_t deallocations{0};
+    uint64_t bytes{0};
+    uint64_t liveBytes{0};
+};
+
+class AllocStats {
+public:
+    static constexpr bool enabled() {
+#ifdef PJSON_ALLOC_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Totals of the calling thread since it started.
+    static AllocCounters threadTotals();
+
+    // {"enabled": bool, "scopes": {name: {calls, allocations, deallocations,
+    // bytes, peakLiveBytes}}}
+    static nlohmann::json snapshot();
+    static void reset();
+};
+
+#ifdef PJSON_ALLOC_STATS
+
+class AllocScope {
+public:
+    explicit AllocScope(std::string scopeName);
+    ~AllocScope();
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+    std::string name;
+    AllocCounters start;
+    uint64_t outerPeak;
+};
+
+#define PJSON_ALLOC_CONCAT_INNER(a, b) a##b
+#define PJSON_ALLOC_CONCAT(a, b) PJSON_ALLOC_CONCAT_INNER(a, b)
+#define PJSON_ALLOC_SCOPE(name) \
+    ::pjson::AllocScope PJSON_ALLOC_CONCAT(pjsonAllocScope_, __LINE__)(name)
+
+#else
+
+#define PJSON_ALLOC_SCOPE(name) ((void)0)
+
+#endif // PJSON_ALLOC_STATS
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_ALLOC_STATS_H
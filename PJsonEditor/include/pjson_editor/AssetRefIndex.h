@@ -0,0 +1,89 @@
+#ifndef PJSON_EDITOR_ASSET_REF_INDEX_H
+#define PJSON_EDITOR_ASSET_REF_INDEX_H
+
+#include "ExtendedModels.h"
+#include "SceneChangeSet.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pjson {
+
+enum class AssetRefKind : uint8_t { A_ROLL, B_ROLL, VOICE_OVER, BGM, PROJECT_TIMELINE };
+
+// One use of an asset: an a-roll, b-roll or voice-over (sceneIndex and its
+// index in that track), a bgm or an entry of the project-level timelines
+// (index only).
+struct AssetRef {
+    AssetRefKind kind;
+    size_t sceneIndex;
+    size_t index;
+};
+
+// The assets a scene's a-rolls, b-rolls and voice-overs use; sorted, each
+// once.
+std::vector<std::string> sceneAssetUuids(const ExtendedProjectScene &scene);
+
+/**
+ * Reverse index from assetUuid to everything in the project using it.
+ *
+ * Answers "who uses this asset" without walking every scene, so replacing an
+ * asset everywhere costs O(scenes using it + references) and finding
+ * unreferenced entries of project.assets costs one lookup per asset.
+ *
+ * Scene uses are kept per scene (by uuid) and re-read only for the scenes
+ * update() is given; positions are resolved against the project on query.
+ * Uses by bgms and project timelines are only counted, adjusted by whoever
+ * adds or removes one, and located by a walk over those lists when an asset
+ * that has some is queried.
+ */
+class AssetRefIndex {
+public:
+    void build(const ExtendedProjectAndScenesVo &project);
+    void clear();
+
+    // Re-reads the scenes in `changes`; after the scene list changed, also
+    // forgets the scenes that are gone and reads the new ones.
+    void update(const ExtendedProjectAndScenesVo &project, const SceneChangeSet &changes);
+
+    // A bgm or project timeline on `assetUuid` was added / removed.
+    void addProjectUse(const std::string &assetUuid);
+    void removeProjectUse(const std::string &assetUuid);
+
+    // In project order: scenes first (a-rolls, b-rolls, voice-overs of each),
+    // then bgms, then project timelines. Empty for an unused asset.
+    std::vector<AssetRef> refs(const ExtendedProjectAndScenesVo &project,
+                               const std::string &assetUuid) const;
+    bool referenced(const std::string &assetUuid) const { return useCounts.count(assetUuid) != 0; }
+    // Distinct assets with at least one reference.
+    size_t assetCount() const { return useCounts.size(); }
+    // sceneAssetUuids() of scene `sceneUuid` as of its last read; empty for
+    // a scene the index does not know.
+    const std::vector<std::string> &sceneAssets(const std::string &sceneUuid) const;
+
+    // Moves the references of `from` to `to`, after the models were changed
+    // the same way.
+    void retarget(const std::string &from, const std::string &to);
+
+private:
+    // A use inside a scene; AssetRef::sceneIndex is filled in on query.
+    using SceneUse = std::pair<std::string, AssetRef>;
+
+    void readScene(const ExtendedProjectScene &scene);
+    void forgetScene(const std::string &sceneUuid);
+    void count(const std::string &assetUuid, int delta);
+
+    std::unordered_map<std::string, std::vector<SceneUse>> sceneUses;  // scene uuid -> uses
+    std::unordered_map<std::string, std::vector<std::string>> scenesByAsset;
+    std::unordered_map<std::string, std::vector<std::string>> assetsByScene;
+    std::unordered_map<std::string, size_t> projectUses;
+    std::unordered_map<std::string, size_t> useCounts;
+    std::unordered_map<std::string, size_t> scenePositions;
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_ASSET_REF_INDEX_H
@@ -0,0 +1,56 @@
+#ifndef PJSON_EDITOR_BINARY_BRIDGE_H
+#define PJSON_EDITOR_BINARY_BRIDGE_H
+
+#include "pjson_editor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pjson {
+
+/**
+ * Byte-buffer front end of a PJsonEditor for hosts that share memory with
+ * the library (the WebAssembly module's linear memory).
+ *
+ * The host writes a MessagePack request {method, url, body, headers?} into
+ * requestBuffer(), calls call() with its size and decodes the MessagePack
+ * response {status, headers, body, patch} straight from responseData(),
+ * e.g. through a Uint8Array view on the wasm heap. `patch` holds the JSON
+ * Patch ops the call recorded (empty unless it changed the project). No JSON
+ * text is produced or parsed on either side. callJson() takes and returns
+ * the same messages as UTF-8 JSON text instead.
+ *
+ * Both buffers are reused across calls; responseData() is valid until the
+ * next call() and requestBuffer() pointers until the next
+ * requestBuffer(). On a WebAssembly heap that can grow, views have to be
+ * re-created after every call.
+ */
+class BinaryBridge {
+public:
+    explicit BinaryBridge(PJsonEditor &editor) : editor(editor) {}
+
+    // At least `size` writable bytes for the next request.
+    uint8_t *requestBuffer(size_t size);
+
+    // Runs the request in the first `size` bytes of the request buffer and
+    // returns the response size. A request that is not valid MessagePack of
+    // the shape above gets a 400 response.
+    size_t call(size_t size);
+
+    // call() with JSON text in both buffers.
+    size_t callJson(size_t size);
+
+    const uint8_t *responseData() const { return response.data(); }
+    size_t responseSize() const { return response.size(); }
+
+private:
+    nlohmann::json dispatch(nlohmann::json message);
+
+    PJsonEditor &editor;
+    std::vector<uint8_t> request;
+    std::vector<uint8_t> response;
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_BINARY_BRIDGE_H
@@ -0,0 +1,72 @@
+#ifndef PJSON_EDITOR_CHANGE_FEED_H
+#define PJSON_EDITOR_CHANGE_FEED_H
+
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace pjson {
+
+// One recorded mutation: the JSON Patch it produced and the project version
+// it led to. Patches are shared between readers, never copied.
+struct ChangeRecord {
+    uint64_t sequence{0};
+    int version{0};
+    std::shared_ptr<const nlohmann::json> patch;
+};
+
+/**
+ * Ordered, bounded log of the patches applied to one project.
+ *
+ * Sequence numbers start at 1 and never repeat, even across clear(). A
+ * consumer keeps the sequence of the last record it applied as its cursor
+ * (0 before the first) and reads everything after it. Only the newest
+ * `capacity` records are kept; a cursor older than that can no longer be
+ * caught up from the log and the consumer has to reload a snapshot, then
+ * continue from the sequence current at that point.
+ *
+ * Not synchronised: like the data store it belongs to, it is used from the
+ * thread that edits the project.
+ */
+class ChangeFeed {
+public:
+    explicit ChangeFeed(size_t capacity = 1024);
+
+    // Returns the sequence of the new record.
+    uint64_t append(int version, nlohmann::json patch);
+
+    // Drops every record, e.g. when a new project is loaded; cursors from
+    // before need a snapshot.
+    void clear();
+
+    void setCapacity(size_t capacity);
+    size_t capacity() const { return limit; }
+    size_t size() const { return records.size(); }
+
+    // Sequence of the newest record (0 if none was ever appended); a
+    // consumer that just loaded a snapshot starts from here.
+    uint64_t lastSequence() const { return nextSequence - 1; }
+
+    struct ReadResult {
+        std::vector<ChangeRecord> records;
+        uint64_t cursor{0};            // pass to the next read
+        bool snapshotRequired{false};  // records after the cursor were dropped
+    };
+
+    // Up to maxRecords records after `cursor`, oldest first.
+    ReadResult read(uint64_t cursor, size_t maxRecords = SIZE_MAX) const;
+
+private:
+    void trim();
+
+    std::deque<ChangeRecord> records;
+    size_t limit;
+    uint64_t nextSequence{1};
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_CHANGE_FEED_H
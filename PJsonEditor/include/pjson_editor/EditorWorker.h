@@ -0,0 +1,81 @@
+#ifndef PJSON_EDITOR_EDITOR_WORKER_H
+#define PJSON_EDITOR_EDITOR_WORKER_H
+
+#include "SpscRing.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pjson {
+
+/**
+ * A PJsonEditor that runs on its own thread, so long edits and full VO
+ * serializations stay off the caller's thread (the JS main thread in the
+ * pthreads build of the wasm module).
+ *
+ * Calls are the BinaryBridge messages. One producer thread submit()s them
+ * and one consumer thread poll()s the responses, in submission order, from
+ * two SpscRings; the worker sleeps on a condition variable only while the
+ * request ring is empty, and only a submit() that finds it asleep wakes it.
+ * The editor itself is built and used on the worker thread only.
+ *
+ * `notify` runs on the worker thread when a response is ready and the
+ * consumer has not been told since its last poll() that found nothing, so
+ * a consumer that polls until false after each notification misses none
+ * and is not woken once per call.
+ */
+class EditorWorker {
+public:
+    struct Call {
+        std::vector<uint8_t> bytes;
+        bool json{false};  // JSON text instead of MessagePack, both ways
+    };
+
+    explicit EditorWorker(nlohmann::json sceneList, std::function<void()> notify = {},
+                          size_t maxPending = 256);
+    // Lets the calls already submitted run, then joins the worker.
+    ~EditorWorker();
+
+    EditorWorker(const EditorWorker &) = delete;
+    EditorWorker &operator=(const EditorWorker &) = delete;
+
+    // False, leaving `call` untouched, when maxPending calls have not been
+    // polled yet.
+    bool submit(Call &call);
+
+    // The next response; false when none is ready.
+    bool poll(std::vector<uint8_t> &response);
+
+    // Calls submitted and not polled yet.
+    size_t pending() const { return inFlight.load(std::memory_order_acquire); }
+
+private:
+    void run(nlohmann::json sceneList);
+
+    // Both rings hold at least maxPending entries and at most maxPending
+    // calls are in flight, so the worker never finds the response ring full.
+    const size_t maxPending;
+    SpscRing<Call> requests;
+    SpscRing<std::vector<uint8_t>> responses;
+    std::function<void()> notify;
+    std::atomic<size_t> inFlight{0};
+    std::atomic<bool> notified{false};
+    // Set by the worker before it sleeps; submit() only wakes it then.
+    std::atomic<bool> parked{false};
+
+    std::mutex parkMutex;
+    std::condition_variable wake;
+    bool stopping{false};
+
+    std::thread thread;  // last: starts once everything above exists
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_EDITOR_WORKER_H
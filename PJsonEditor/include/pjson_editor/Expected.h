@@ -0,0 +1,66 @@
+#ifndef PJSON_EDITOR_EXPECTED_H
+#define PJSON_EDITOR_EXPECTED_H
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pjson {
+
+template <typename E>
+struct Unexpected {
+    E error;
+};
+
+template <typename E>
+Unexpected<std::decay_t<E>> makeUnexpected(E &&error) {
+    return {std::forward<E>(error)};
+}
+
+/**
+ * A value or the error that prevented it, in the shape of std::expected
+ * (C++23) / tl::expected, for code that has to work without exceptions.
+ * Accessing the side that is not there is a programming error (asserted),
+ * never a throw.
+ */
+template <typename T, typename E = std::string>
+class Expected {
+public:
+    Expected(const T &value) : storage(std::in_place_index<0>, value) {}
+    Expected(T &&value) : storage(std::in_place_index<0>, std::move(value)) {}
+    template <typename G>
+    Expected(Unexpected<G> unexpected) : storage(std::in_place_index<1>, std::move(unexpected.error)) {}
+
+    bool has_value() const { return storage.index() == 0; }
+    explicit operator bool() const { return has_value(); }
+
+    T &value() & {
+        assert(has_value());
+        return *std::get_if<0>(&storage);
+    }
+    const T &value() const & {
+        assert(has_value());
+        return *std::get_if<0>(&storage);
+    }
+    T &&value() && { return std::move(value()); }
+
+    T &operator*() & { return value(); }
+    const T &operator*() const & { return value(); }
+    T &&operator*() && { return std::move(value()); }
+    T *operator->() { return &value(); }
+    const T *operator->() const { return &value(); }
+
+    const E &error() const {
+        assert(!has_value());
+        return *std::get_if<1>(&storage);
+    }
+
+private:
+    std::variant<T, E> storage;
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_EXPECTED_H
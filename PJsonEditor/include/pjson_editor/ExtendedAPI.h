@@ -4,7 +4,15 @@
 
 #include "ExtendedModels.h"
 #include "ApiMessage.h"
+#include "AssetRefIndex.h"
+#include "ChangeFeed.h"
+#include "IdGenerator.h"
+#include "SceneChangeSet.h"
+#include "TimelineHotBlock.h"
+#include "TimelineIndex.h"
+#include <algorithm>
 #include <cassert>
+#include <initializer_list>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -14,7 +22,6 @@
 namespace pjson {
 
 class ExtendedDataStore; // fwd
-std::string genUuid();
 
 struct ApiResult {
     ApiMessage apiMessage{ApiMessage::SUCCESS};
@@ -58,27 +65,59 @@ struct BackendParityOptions {
     bool enforceBlankSceneMergeRule{true};
     bool markTranscriptsModifiedOnSplit{true};
     bool clampMergedSceneDuration{true};
+    // Off: ProjectAndSceneVo responses carry every asset of the project, as
+    // the backend sends. On: only the assets their scene uses.
+    bool scopeSceneVoAssets{false};
 };
 
 class ExtendedControllerAPI {
 private:
     std::shared_ptr<ExtendedDataStore> dataStore{nullptr};
     BackendParityOptions parityOptions{};
+    // Set while batch() runs its operations; handlers then skip their
+    // per-call result VO, the batch builds one at the end. Also set for a
+    // whole op log replay, see setResultDataSuppressed().
+    bool inBatch{false};
+    // Ids for created scenes, timelines, voice-overs and bgms.
+    std::shared_ptr<IdGenerator> idGenerator{std::make_shared<IdGenerator>()};
+    std::string newUuid() { return idGenerator->nextString(); }
     
     // Helper methods for VO conversion
     nlohmann::json convertSceneToProjectSceneVo(const ExtendedProjectScene& scene) const;
-    nlohmann::json convertProjectToProjectAndSceneVo(const std::string& sceneUuid) const;
-    nlohmann::json convertProjectToProjectAndScenesVo() const;
     nlohmann::json convertAssetsMap(const std::unordered_map<std::string, ProjectSceneAsset>& assets) const;
+    // Only the listed asset ids that exist in `assets`.
+    nlohmann::json convertAssetsMap(const std::unordered_map<std::string, ProjectSceneAsset>& assets,
+                                    const std::vector<std::string>& assetIds) const;
     
 public:
     void setDataStore(std::shared_ptr<ExtendedDataStore> ds) { dataStore = ds; }
     void setParityOptions(const BackendParityOptions& o) { parityOptions = o; }
     const BackendParityOptions& getParityOptions() const { return parityOptions; }
+    IdGenerator& getIdGenerator() { return *idGenerator; }
+    void setIdGenerator(std::shared_ptr<IdGenerator> generator) { idGenerator = std::move(generator); }
+    // While set, handlers skip their result VO as inside a batch; for
+    // replays, whose responses nobody reads.
+    void setResultDataSuppressed(bool suppressed) { inBatch = suppressed; }
     
     // Method to get current project data for external comparison
     const ExtendedProjectAndScenesVo& getCurrentProjectData() const;
 
+    // ProjectAndSceneVo / ProjectAndScenesVo views of the current project
+    nlohmann::json convertProjectToProjectAndSceneVo(const std::string& sceneUuid) const;
+    nlohmann::json convertProjectToProjectAndScenesVo() const;
+    // Only what changed after sinceVersion: the newer scenes and, if scenes
+    // were added, removed or moved, the scene order. The full view when
+    // something outside the scenes changed too.
+    nlohmann::json convertProjectToProjectAndScenesVoSince(int sinceVersion) const;
+
+    // Called by the route layer after a successful mutation.
+    void recordChange(const nlohmann::json& patch);
+    // The recorded patches after `cursor` as
+    // {"cursor", "changes": [{"sequence", "version", "patch"}]}, or
+    // {"cursor", "version", "snapshot": ProjectAndScenesVo} when the feed no
+    // longer holds them.
+    nlohmann::json changesSince(uint64_t cursor, size_t maxRecords = SIZE_MAX) const;
+
         ApiResult addScene(const ExtendedProjectSceneAddReqBody& reqBody);
         ApiResult renameScene(const ExtendedProjectSceneRenameReqBody& reqBody);
         ApiResult moveScene(const ExtendedProjectSceneMoveReqBody& reqBody);
@@ -113,6 +152,11 @@ public:
         ApiResult deleteBgm(const ProjectBgmDeleteReqBody& reqBody);
     ApiResult editBgm(const ProjectBgmEditReqBody& reqBody);
     ApiResult adjustBgmAudio(const PsSceneTimelineVolumeReqBody& reqBody);
+    // Points every timeline, voice-over and bgm using oldAssetUuid at
+    // newAssetUuid, in time proportional to those uses.
+    ApiResult replaceAsset(const ProjectAssetReplaceReqBody& reqBody);
+    // Removes the entries of project.assets that nothing uses any more.
+    ApiResult pruneAssets(const ProjectAssetPruneReqBody& reqBody);
     ApiResult setSceneBgStyle(const PsSceneBgStyleReqBody& reqBody);
     ApiResult updateGraphicLayers(const ProjectGraphicLayerSettingsReqBody& reqBody);
     ApiResult createBgImage(const CreateWallpaperReqBody& reqBody);
@@ -123,15 +167,42 @@ public:
     ApiResult clearDeletedAvatar();
     ApiResult changeDeletedAvatar();
 
+    // Runs the operations in order with one offset recompute and one result
+    // VO at the end. Stops at the first failing operation and restores the
+    // project as it was before the batch; the error carries its index as
+    // data.failedIndex.
+    ApiResult batch(const ProjectBatchReqBody& reqBody);
+
     ExtendedProjectScene assembleSceneAndTimelines(
-        const ExtendedProjectScene& scene,
-        const std::vector<ExtendedTimeline>& timelines,
+        ExtendedProjectScene scene,
+        std::vector<ExtendedTimeline> timelines,
         const std::unordered_map<std::string, ProjectSceneAsset>& assetMap);
 };
 
 class ExtendedDataStore {
 private:
     std::shared_ptr<ExtendedProjectAndScenesVo> project;
+    // Hot timing columns of every timeline; the working copy of their
+    // offsets. Handing out a scene for mutation marks that scene, handing
+    // out the project marks everything; marked scenes are re-read before
+    // the block is next used.
+    TimelineHotBlock hotBlock;
+    SceneChangeSet hotBlockChanges;
+    // Playback lookup; on the first query after a change it re-reads the
+    // scene offsets and rebuilds the trees of the marked scenes only.
+    TimelineIndex timeIndex;
+    SceneChangeSet timeIndexChanges;
+    bool sceneOffsetsMoved{true};
+    // Who uses which asset. Marked scenes are re-read on the next query;
+    // uses by bgms and project timelines are counted as they are added and
+    // removed below.
+    AssetRefIndex assetIndex;
+    SceneChangeSet assetIndexChanges;
+    bool recomputeDeferred{false};
+    bool recomputePending{false};
+    ChangeFeed changes;
+    void markSceneChanged(size_t index);
+    void syncHotBlock();
 public:
     void init(std::shared_ptr<ExtendedProjectAndScenesVo> initialProject);
     ExtendedProjectAndScenesVo& getProject();
@@ -139,15 +210,91 @@ public:
     // Method to get current project data for external comparison
     const ExtendedProjectAndScenesVo& getCurrentProjectData() const { return *project; }
     ExtendedProjectScene* findScene(const std::string& sceneUuid);
+    // As above, also giving the scene's position in the scene list.
+    ExtendedProjectScene* findScene(const std::string& sceneUuid, size_t& index);
+    // For adding, removing or reordering scenes without touching the
+    // timelines of the others; a scene whose timelines change is to be
+    // marked through findScene() as well.
+    std::vector<ExtendedProjectScene>& editSceneList();
+    // Project-level lists, for editing their timing and scene references;
+    // entries are added and removed (and assets changed) through the
+    // methods below, which keep the asset index in step.
+    std::vector<ExtendedTimeline>& projectTimelines() { return project->timelines; }
+    std::vector<ProjectBgm>& projectBgms() { return project->bgms; }
+    std::unordered_map<std::string, ProjectSceneAsset>& projectAssets() { return project->assets; }
+    void addProjectTimeline(const ExtendedTimeline& timeline);
+    template <typename Match>
+    void removeProjectTimelines(Match match);
+    // The project-level timelines mirror the a-rolls and b-rolls of each
+    // scene. Replaces the copies of scene `sceneUuid`'s tracks with the
+    // current tracks of `scenes` (the scene itself, or what it was split
+    // into), where the first copy was (at the end if there was none).
+    void syncProjectTimelines(const std::string& sceneUuid,
+                              std::initializer_list<const ExtendedProjectScene*> scenes);
+    void removeBgm(size_t index);
+    // Edit a scene's timelines before shifting or recomputing: from then on
+    // the offsets are taken from the hot block.
     void recomputeOffsets();
+    // Shift scenes [fromIndex, end) and all their timelines by delta ms
+    void shiftScenes(size_t fromIndex, int delta);
+    // Shift scenes [beginIndex, endIndex) and all their timelines by delta ms
+    void shiftSceneRange(size_t beginIndex, size_t endIndex, int delta);
+    const TimelineHotBlock& timelineBlock();
+    const TimelineIndex& timelineIndex();
+    // What plays at timeMs / during [beginMs, endMs): the scenes and their
+    // a-rolls, b-rolls and voice-overs, in O(log n + k).
+    TimelineQueryResult activeAt(int32_t timeMs) { return timelineIndex().activeAt(timeMs); }
+    TimelineQueryResult rangeQuery(int32_t beginMs, int32_t endMs) {
+        return timelineIndex().rangeQuery(beginMs, endMs);
+    }
+    const AssetRefIndex& assetRefs();
+    // Points every use of asset `from` at `to`; returns the references it
+    // changed, positioned as in the project. O(references to `from`).
+    std::vector<AssetRef> replaceAsset(const std::string& from, const std::string& to);
+    // Drops the entries of project.assets nothing uses; returns their ids,
+    // sorted.
+    std::vector<std::string> pruneAssets();
+    // While deferred, recomputeOffsets() only notes that a recompute is due;
+    // endDeferredRecompute() then runs it once.
+    void beginDeferredRecompute();
+    void endDeferredRecompute();
+    // Runs a recompute that is due now, for an operation that reads the
+    // offsets; later ones stay deferred.
+    void flushDeferredRecompute();
+    // Puts back a copy taken with getCurrentProjectData(); drops a pending
+    // deferred recompute.
+    void restoreProject(ExtendedProjectAndScenesVo snapshot);
+    // Bumps the project version for a successful mutation and stamps the
+    // scenes its patch touches; see ExtendedProjectAndScenesVo::version.
+    // An empty patch is not a change. Recorded changes are appended to the
+    // change feed.
+    void recordChange(const nlohmann::json& patch);
+    ChangeFeed& changeFeed() { return changes; }
+    const ChangeFeed& changeFeed() const { return changes; }
     // void insertScene(const ExtendedProjectScene& scene, int index = -1);
     // bool removeScene(const std::string& sceneUuid);
     // void moveScene(const std::string& sceneUuid, int newIndex);
 };
 
+template <typename Match>
+void ExtendedDataStore::removeProjectTimelines(Match match) {
+    auto& timelines = project->timelines;
+    if (!assetIndexChanges.all) {
+        for (const auto& timeline : timelines) {
+            if (match(timeline)) {
+                assetIndex.removeProjectUse(timeline.assetUuid);
+            }
+        }
+    }
+    timelines.erase(std::remove_if(timelines.begin(), timelines.end(), match), timelines.end());
+}
+
+// Defined in ControllerAPI.cpp; returned by the inline method below when no
+// data store is set.
+extern ExtendedProjectAndScenesVo EMPTY_PROJECT;
+
 } // namespace pjson
 
-extern pjson::ExtendedProjectAndScenesVo EMPTY_PROJECT; // global for inline method
 // Inline method implementations after class definitions
 inline const pjson::ExtendedProjectAndScenesVo& pjson::ExtendedControllerAPI::getCurrentProjectData() const {
     assert(dataStore && "Data store not set in ExtendedControllerAPI");
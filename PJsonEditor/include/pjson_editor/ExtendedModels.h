@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <variant>
 #include <nlohmann/json.hpp>
+#include "JsonBlob.h"
+#include "JsonReader.h"
 
 namespace pjson {
 
@@ -43,8 +45,8 @@ struct ExtendedTimeline {
     std::string blendMode{"normal"}; // visual blend mode (e.g., normal, multiply)
     
     // Crop and animation data
-    std::optional<json> cropData;
-    std::optional<json> kenburnsData;
+    JsonBlob cropData;
+    JsonBlob kenburnsData;
     
     // Internal IDs (for patch generation)
     std::optional<std::string> id;
@@ -126,15 +128,15 @@ struct BaseLayer {
     std::string type; // "text", "avatar", "sticker", "narration", etc.
     int timeOffsetInScene{0};
     int duration{0};
-    json data; // type-specific data as JSON
+    JsonBlob data; // type-specific data as JSON
 };
 
 // Transition structure
 struct SceneTransition {
     std::string type;
     int duration{0};
-    std::optional<json> easing;
-    std::optional<json> properties;
+    JsonBlob easing;
+    JsonBlob properties;
 };
 
 // Text on screen structure
@@ -221,13 +223,14 @@ struct ExtendedProjectScene {
     std::optional<SceneScale> scale;
     
     // Deprecated/compatibility fields
-    std::optional<json> deprecatedEffect;
-    std::optional<json> deprecatedScale;
-    std::optional<json> deprecatedAudio;
+    JsonBlob deprecatedEffect;
+    JsonBlob deprecatedScale;
+    JsonBlob deprecatedAudio;
     
     // Policy and metadata
     std::optional<int> brollShorterPolicyKey;
     std::optional<double> bgmVolume;
+    int version{0}; // project version of the last change to this scene
     
     // Legacy compatibility - unified timelines
     std::vector<ExtendedTimeline> timelines; // computed from aRolls + bRolls + voiceOvers
@@ -268,15 +271,18 @@ struct ExtendedProjectAndScenesVo {
     std::optional<json> text; // deprecated text style
     
     // Internal tracking
-    int version{1}; // for conflict detection
+    int version{1}; // for conflict detection; bumped by every recorded change
+    int sceneListVersion{1}; // last version that added, removed or moved a scene
+    int sharedVersion{1};    // last version that changed anything outside /scenes
 };
 
 // Request body structures (enhanced)
 struct ExtendedProjectSceneAddReqBody {
     ExtendedProjectSceneAddReqBody() = default;
-    ExtendedProjectSceneAddReqBody(const nlohmann::json &_data){
-        addPosition = _data["addPosition"];
-        duration = _data.value("duration", 0);
+    ExtendedProjectSceneAddReqBody(JsonReader &in) {
+        in.require("addPosition", addPosition);
+        duration = 0;
+        in.read("duration", duration);
     };
     int addPosition;              // 与API参数保持一致：position(index) to be added
     std::optional<int> duration;  // 与API参数保持一致：scene duration in ms
@@ -284,9 +290,9 @@ struct ExtendedProjectSceneAddReqBody {
 
 struct ExtendedProjectSceneRenameReqBody { 
     ExtendedProjectSceneRenameReqBody() = default;
-    ExtendedProjectSceneRenameReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("name")) name = _data["name"];
+    ExtendedProjectSceneRenameReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("name", name);
     }
     std::string sceneUuid; 
     std::string name; 
@@ -294,10 +300,10 @@ struct ExtendedProjectSceneRenameReqBody {
 
 struct ExtendedProjectSceneMoveReqBody { 
     ExtendedProjectSceneMoveReqBody() = default;
-    ExtendedProjectSceneMoveReqBody(const nlohmann::json &_data) {
-        if (_data.contains("uuid")) uuid = _data["uuid"];
-        if (_data.contains("newIndex")) newIndex = _data["newIndex"];
-        if (_data.contains("afterSceneUuid")) afterSceneUuid = _data["afterSceneUuid"];
+    ExtendedProjectSceneMoveReqBody(JsonReader &in) {
+        in.read("uuid", uuid);
+        in.read("newIndex", newIndex);
+        in.read("afterSceneUuid", afterSceneUuid);
     }
     std::string uuid; 
     int newIndex;
@@ -306,10 +312,10 @@ struct ExtendedProjectSceneMoveReqBody {
 
 struct ExtendedProjectSceneSetTimeReqBody { 
     ExtendedProjectSceneSetTimeReqBody() = default;
-    ExtendedProjectSceneSetTimeReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("newDuration")) newDuration = _data["newDuration"];
-        else if (_data.contains("duration")) newDuration = _data["duration"];
+    ExtendedProjectSceneSetTimeReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        if (in.has("newDuration")) in.read("newDuration", newDuration);
+        else in.read("duration", newDuration);
     }
     std::string sceneUuid; 
     int newDuration; 
@@ -323,16 +329,14 @@ struct TimePeriod {
 
 struct ExtendedProjectSceneCutReqBody { 
     ExtendedProjectSceneCutReqBody() = default;
-    ExtendedProjectSceneCutReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("cutList") && _data["cutList"].is_array()) {
-            for (const auto& period : _data["cutList"]) {
-                TimePeriod tp;
-                if (period.contains("start")) tp.start = period["start"];
-                if (period.contains("end")) tp.end = period["end"];
-                cutList.push_back(tp);
-            }
-        }
+    ExtendedProjectSceneCutReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.forEach("cutList", [this](JsonReader &period) {
+            TimePeriod tp;
+            period.read("start", tp.start);
+            period.read("end", tp.end);
+            cutList.push_back(tp);
+        });
     }
     std::string sceneUuid; 
     std::vector<TimePeriod> cutList;
@@ -340,9 +344,9 @@ struct ExtendedProjectSceneCutReqBody {
 
 struct ExtendedProjectSceneSplitReqBody { 
     ExtendedProjectSceneSplitReqBody() = default;
-    ExtendedProjectSceneSplitReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("splitTime")) splitTime = _data["splitTime"];
+    ExtendedProjectSceneSplitReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("splitTime", splitTime);
     }
     std::string sceneUuid; 
     int splitTime; 
@@ -350,28 +354,24 @@ struct ExtendedProjectSceneSplitReqBody {
 
 struct ExtendedProjectSceneMergeReqBody { 
     ExtendedProjectSceneMergeReqBody() = default;
-    ExtendedProjectSceneMergeReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuids") && _data["sceneUuids"].is_array()) {
-            for (const auto& uuid : _data["sceneUuids"]) {
-                sceneUuids.push_back(uuid.get<std::string>());
-            }
-        }
+    ExtendedProjectSceneMergeReqBody(JsonReader &in) {
+        in.read("sceneUuids", sceneUuids);
     }
     std::vector<std::string> sceneUuids; 
 };
 
 struct ExtendedProjectSceneDeleteReqBody { 
     ExtendedProjectSceneDeleteReqBody() = default;
-    ExtendedProjectSceneDeleteReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
+    ExtendedProjectSceneDeleteReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
     }
     std::string sceneUuid; 
 };
 
 struct ExtendedProjectSceneClearFootageReqBody { 
     ExtendedProjectSceneClearFootageReqBody() = default;
-    ExtendedProjectSceneClearFootageReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
+    ExtendedProjectSceneClearFootageReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
     }
     std::string sceneUuid; 
 };
@@ -379,12 +379,12 @@ struct ExtendedProjectSceneClearFootageReqBody {
 // Footage management
 struct ProjectSceneReplaceFootageReqBody {
     ProjectSceneReplaceFootageReqBody() = default;
-    ProjectSceneReplaceFootageReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("oldTimelineUuid")) oldTimelineUuid = _data["oldTimelineUuid"];
-        if (_data.contains("newAssetUuid")) newAssetUuid = _data["newAssetUuid"];
-        if (_data.contains("startTime")) startTime = _data["startTime"];
-        if (_data.contains("endTime")) endTime = _data["endTime"];
+    ProjectSceneReplaceFootageReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("oldTimelineUuid", oldTimelineUuid);
+        in.read("newAssetUuid", newAssetUuid);
+        in.read("startTime", startTime);
+        in.read("endTime", endTime);
     }
     std::string sceneUuid;
     std::string oldTimelineUuid;
@@ -395,14 +395,14 @@ struct ProjectSceneReplaceFootageReqBody {
 
 struct ProjectSceneAdjustFootageReqBody {
     ProjectSceneAdjustFootageReqBody() = default;
-    ProjectSceneAdjustFootageReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
-        if (_data.contains("startTime")) startTime = _data["startTime"];
-        if (_data.contains("endTime")) endTime = _data["endTime"];
-        if (_data.contains("timeOffsetInScene")) timeOffsetInScene = _data["timeOffsetInScene"];
-        if (_data.contains("volume")) volume = _data["volume"];
-        if (_data.contains("cropData")) cropData = _data["cropData"];
+    ProjectSceneAdjustFootageReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("timelineUuid", timelineUuid);
+        in.read("startTime", startTime);
+        in.read("endTime", endTime);
+        in.read("timeOffsetInScene", timeOffsetInScene);
+        in.read("volume", volume);
+        in.read("cropData", cropData);
     }
     std::string sceneUuid;
     std::string timelineUuid;
@@ -416,13 +416,13 @@ struct ProjectSceneAdjustFootageReqBody {
 // Voice over management
 struct AddVoiceOverReqBody {
     AddVoiceOverReqBody() = default;
-    AddVoiceOverReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("assetUuid")) assetUuid = _data["assetUuid"];
-        if (_data.contains("timeOffsetInScene")) timeOffsetInScene = _data["timeOffsetInScene"];
-        if (_data.contains("duration")) duration = _data["duration"];
-        if (_data.contains("audioOnly")) audioOnly = _data["audioOnly"];
-        if (_data.contains("shape")) shape = _data["shape"];
+    AddVoiceOverReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("assetUuid", assetUuid);
+        in.read("timeOffsetInScene", timeOffsetInScene);
+        in.read("duration", duration);
+        in.read("audioOnly", audioOnly);
+        in.read("shape", shape);
     }
     std::string sceneUuid;
     std::string assetUuid;
@@ -435,12 +435,13 @@ struct AddVoiceOverReqBody {
 // Add Scene Audio request body (matching API)
 struct AddSceneAudioReqBody {
     AddSceneAudioReqBody() = default;
-    AddSceneAudioReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("entityUuid")) entityUuid = _data["entityUuid"];
-        else if (_data.contains("assetUuid")) entityUuid = _data["assetUuid"];
-        if (_data.contains("entityType")) {
-            std::string typeStr = _data["entityType"];
+    AddSceneAudioReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        if (in.has("entityUuid")) in.read("entityUuid", entityUuid);
+        else in.read("assetUuid", entityUuid);
+        if (in.has("entityType")) {
+            std::string typeStr;
+            in.read("entityType", typeStr);
             if (typeStr == "PROJECT_ASSET") entityType = EntityTypeEnum::PROJECT_ASSET;
             else if (typeStr == "CLIP") entityType = EntityTypeEnum::CLIP;
             else entityType = EntityTypeEnum::PROJECT_ASSET; // default
@@ -455,9 +456,9 @@ struct AddSceneAudioReqBody {
 
 struct ProjectSceneSetPauseTimeReqBody {
     ProjectSceneSetPauseTimeReqBody() = default;
-    ProjectSceneSetPauseTimeReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("pauseTime")) pauseTime = _data["pauseTime"];
+    ProjectSceneSetPauseTimeReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("pauseTime", pauseTime);
     }
     std::string sceneUuid;
     int pauseTime{0};
@@ -465,12 +466,12 @@ struct ProjectSceneSetPauseTimeReqBody {
 
 struct ProjectSceneTransitionReqBody {
     ProjectSceneTransitionReqBody() = default;
-    ProjectSceneTransitionReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("projectUuid")) projectUuid = _data["projectUuid"];
-        if (_data.contains("type")) type = _data["type"];
-        if (_data.contains("duration")) duration = _data["duration"];
-        if (_data.contains("forAllScenes")) forAllScenes = _data["forAllScenes"];
+    ProjectSceneTransitionReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("projectUuid", projectUuid);
+        in.read("type", type);
+        in.read("duration", duration);
+        in.read("forAllScenes", forAllScenes);
     }
     std::string sceneUuid;
     std::string projectUuid;     // Added to match API
@@ -482,14 +483,14 @@ struct ProjectSceneTransitionReqBody {
 // Additional Tier 1 request bodies
 struct ProjectSceneFootageAddReqBody {
     ProjectSceneFootageAddReqBody() = default;
-    ProjectSceneFootageAddReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("assetUuid")) assetUuid = _data["assetUuid"];
-        if (_data.contains("timeOffsetInScene")) timeOffsetInScene = _data["timeOffsetInScene"];
-        if (_data.contains("duration")) duration = _data["duration"];
-        if (_data.contains("startTime")) startTime = _data["startTime"];
-        if (_data.contains("endTime")) endTime = _data["endTime"];
-        if (_data.contains("cropData")) cropData = _data["cropData"];
+    ProjectSceneFootageAddReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("assetUuid", assetUuid);
+        in.read("timeOffsetInScene", timeOffsetInScene);
+        in.read("duration", duration);
+        in.read("startTime", startTime);
+        in.read("endTime", endTime);
+        in.read("cropData", cropData);
     }
     std::string sceneUuid;
     std::string assetUuid;
@@ -502,9 +503,9 @@ struct ProjectSceneFootageAddReqBody {
 
 struct ProjectSceneFootageDeleteReqBody {
     ProjectSceneFootageDeleteReqBody() = default;
-    ProjectSceneFootageDeleteReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
+    ProjectSceneFootageDeleteReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("timelineUuid", timelineUuid);
     }
     std::string sceneUuid;
     std::string timelineUuid;
@@ -512,9 +513,9 @@ struct ProjectSceneFootageDeleteReqBody {
 
 struct DeleteVoiceOverReqBody {
     DeleteVoiceOverReqBody() = default;
-    DeleteVoiceOverReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
+    DeleteVoiceOverReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("timelineUuid", timelineUuid);
     }
     std::string sceneUuid;
     std::string timelineUuid;
@@ -522,14 +523,14 @@ struct DeleteVoiceOverReqBody {
 
 struct AdjustVoiceOverReqBody {
     AdjustVoiceOverReqBody() = default;
-    AdjustVoiceOverReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
-        if (_data.contains("timeOffsetInScene")) timeOffsetInScene = _data["timeOffsetInScene"];
-        if (_data.contains("duration")) duration = _data["duration"];
-        if (_data.contains("volume")) volume = _data["volume"];
-        if (_data.contains("audioOnly")) audioOnly = _data["audioOnly"];
-        if (_data.contains("shape")) shape = _data["shape"];
+    AdjustVoiceOverReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("timelineUuid", timelineUuid);
+        in.read("timeOffsetInScene", timeOffsetInScene);
+        in.read("duration", duration);
+        in.read("volume", volume);
+        in.read("audioOnly", audioOnly);
+        in.read("shape", shape);
     }
     std::string sceneUuid;
     std::string timelineUuid;
@@ -542,14 +543,14 @@ struct AdjustVoiceOverReqBody {
 
 struct ProjectSceneEditScriptReqBody {
     ProjectSceneEditScriptReqBody() = default;
-    ProjectSceneEditScriptReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("script")) {
+    ProjectSceneEditScriptReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        if (in.has("script")) {
             // Parse SceneTranscript from JSON - simplified version
-            auto scriptData = _data["script"];
-            if (scriptData.contains("text")) script.text = scriptData["text"];
-            if (scriptData.contains("duration")) script.duration = scriptData["duration"];
-            if (scriptData.contains("modified")) script.modified = scriptData["modified"];
+            JsonReader scriptIn = in.child("script");
+            scriptIn.read("text", script.text);
+            scriptIn.read("duration", script.duration);
+            scriptIn.read("modified", script.modified);
         }
     }
     std::string sceneUuid;
@@ -558,10 +559,10 @@ struct ProjectSceneEditScriptReqBody {
 
 struct ProjectSceneSetTranscriptReqBody {
     ProjectSceneSetTranscriptReqBody() = default;
-    ProjectSceneSetTranscriptReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("newText")) newText = _data["newText"];
-        if (_data.contains("pacePercent")) pacePercent = _data["pacePercent"];
+    ProjectSceneSetTranscriptReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("newText", newText);
+        in.read("pacePercent", pacePercent);
     }
     std::string sceneUuid;
     std::string newText;
@@ -570,13 +571,9 @@ struct ProjectSceneSetTranscriptReqBody {
 
 struct EditSceneHighLightReqBody {
     EditSceneHighLightReqBody() = default;
-    EditSceneHighLightReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("highLights") && _data["highLights"].is_array()) {
-            for (const auto& highlight : _data["highLights"]) {
-                highLights.push_back(highlight.get<std::string>());
-            }
-        }
+    EditSceneHighLightReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("highLights", highLights);
     }
     std::string sceneUuid;
     std::vector<std::string> highLights; // highlight keywords
@@ -584,35 +581,31 @@ struct EditSceneHighLightReqBody {
 
 struct SetMainStoryOrderReqBody {
     SetMainStoryOrderReqBody() = default;
-    SetMainStoryOrderReqBody(const nlohmann::json &_data) {
-        if (_data.contains("timelineUuids") && _data["timelineUuids"].is_array()) {
-            for (const auto& uuid : _data["timelineUuids"]) {
-                timelineUuids.push_back(uuid.get<std::string>());
-            }
-        }
+    SetMainStoryOrderReqBody(JsonReader &in) {
+        in.read("timelineUuids", timelineUuids);
     }
     std::vector<std::string> timelineUuids;
 };
 
 struct ChangeFitTypeReqBody {
     ChangeFitTypeReqBody() = default;
-    ChangeFitTypeReqBody(const nlohmann::json &_data) {
-        if (_data.contains("fitType")) fitType = _data["fitType"];
+    ChangeFitTypeReqBody(JsonReader &in) {
+        in.read("fitType", fitType);
     }
     int fitType{0}; // 0=fit, 1=fill, 2=stretch
 };
 
 struct UpdateProjectScaleReqBody {
     UpdateProjectScaleReqBody() = default;
-    UpdateProjectScaleReqBody(const nlohmann::json &_data) {
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
-        if (_data.contains("scale")) {
-            auto scaleData = _data["scale"];
-            if (scaleData.contains("scaleX")) scale.scaleX = scaleData["scaleX"];
-            if (scaleData.contains("scaleY")) scale.scaleY = scaleData["scaleY"];
-            if (scaleData.contains("offsetX")) scale.offsetX = scaleData["offsetX"];
-            if (scaleData.contains("offsetY")) scale.offsetY = scaleData["offsetY"];
-            if (scaleData.contains("cropRect")) scale.cropRect = scaleData["cropRect"];
+    UpdateProjectScaleReqBody(JsonReader &in) {
+        in.read("timelineUuid", timelineUuid);
+        if (in.has("scale")) {
+            JsonReader scaleIn = in.child("scale");
+            scaleIn.read("scaleX", scale.scaleX);
+            scaleIn.read("scaleY", scale.scaleY);
+            scaleIn.read("offsetX", scale.offsetX);
+            scaleIn.read("offsetY", scale.offsetY);
+            scaleIn.read("cropRect", scale.cropRect);
         }
     }
     std::string timelineUuid;
@@ -622,12 +615,12 @@ struct UpdateProjectScaleReqBody {
 // Tier 2 BGM Management request bodies
 struct ProjectBgmAddReqBody {
     ProjectBgmAddReqBody() = default;
-    ProjectBgmAddReqBody(const nlohmann::json &_data) {
-        if (_data.contains("assetUuid")) assetUuid = _data["assetUuid"];
-        if (_data.contains("startSceneIndex")) startSceneIndex = _data["startSceneIndex"];
-        if (_data.contains("endSceneIndex")) endSceneIndex = _data["endSceneIndex"];
-        if (_data.contains("volume")) volume = _data["volume"];
-        if (_data.contains("loop")) loop = _data["loop"];
+    ProjectBgmAddReqBody(JsonReader &in) {
+        in.read("assetUuid", assetUuid);
+        in.read("startSceneIndex", startSceneIndex);
+        in.read("endSceneIndex", endSceneIndex);
+        in.read("volume", volume);
+        in.read("loop", loop);
     }
     std::string assetUuid;
     int startSceneIndex{0};
@@ -638,20 +631,20 @@ struct ProjectBgmAddReqBody {
 
 struct ProjectBgmDeleteReqBody {
     ProjectBgmDeleteReqBody() = default;
-    ProjectBgmDeleteReqBody(const nlohmann::json &_data) {
-        if (_data.contains("timelineUuid")) timelineUuid = _data["timelineUuid"];
+    ProjectBgmDeleteReqBody(JsonReader &in) {
+        in.read("timelineUuid", timelineUuid);
     }
     std::string timelineUuid;  // 修改为与API一致的参数名
 };
 
 struct ProjectBgmEditReqBody {
     ProjectBgmEditReqBody() = default;
-    ProjectBgmEditReqBody(const nlohmann::json &_data) {
-        if (_data.contains("bgmUuid")) bgmUuid = _data["bgmUuid"];
-        if (_data.contains("volume")) volume = _data["volume"];
-        if (_data.contains("loop")) loop = _data["loop"];
-        if (_data.contains("startSceneIndex")) startSceneIndex = _data["startSceneIndex"];
-        if (_data.contains("endSceneIndex")) endSceneIndex = _data["endSceneIndex"];
+    ProjectBgmEditReqBody(JsonReader &in) {
+        in.read("bgmUuid", bgmUuid);
+        in.read("volume", volume);
+        in.read("loop", loop);
+        in.read("startSceneIndex", startSceneIndex);
+        in.read("endSceneIndex", endSceneIndex);
     }
     std::string bgmUuid;
     std::optional<double> volume;
@@ -660,15 +653,27 @@ struct ProjectBgmEditReqBody {
     std::optional<int> endSceneIndex;
 };
 
+// Project asset management request bodies
+struct ProjectAssetReplaceReqBody {
+    ProjectAssetReplaceReqBody() = default;
+    ProjectAssetReplaceReqBody(JsonReader &in) {
+        in.require("oldAssetUuid", oldAssetUuid);
+        in.require("newAssetUuid", newAssetUuid);
+    }
+    std::string oldAssetUuid;
+    std::string newAssetUuid;
+};
+
+struct ProjectAssetPruneReqBody {
+    ProjectAssetPruneReqBody() = default;
+    ProjectAssetPruneReqBody(JsonReader &) {}
+};
+
 struct PsSceneTimelineVolumeReqBody {
     PsSceneTimelineVolumeReqBody() = default;
-    PsSceneTimelineVolumeReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("timelineVolumes") && _data["timelineVolumes"].is_object()) {
-            for (auto& [key, value] : _data["timelineVolumes"].items()) {
-                timelineVolumes[key] = value.get<double>();
-            }
-        }
+    PsSceneTimelineVolumeReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("timelineVolumes", timelineVolumes);
     }
     std::string sceneUuid;
     std::unordered_map<std::string, double> timelineVolumes; // timelineUuid -> volume
@@ -677,10 +682,10 @@ struct PsSceneTimelineVolumeReqBody {
 // Style and effects request bodies
 struct PsSceneBgStyleReqBody {
     PsSceneBgStyleReqBody() = default;
-    PsSceneBgStyleReqBody(const nlohmann::json &_data) {
-        if (_data.contains("sceneUuid")) sceneUuid = _data["sceneUuid"];
-        if (_data.contains("bgColor")) bgColor = _data["bgColor"];
-        if (_data.contains("bgImageUuid")) bgImageUuid = _data["bgImageUuid"];
+    PsSceneBgStyleReqBody(JsonReader &in) {
+        in.read("sceneUuid", sceneUuid);
+        in.read("bgColor", bgColor);
+        in.read("bgImageUuid", bgImageUuid);
     }
     std::string sceneUuid;
     std::string bgColor;
@@ -689,29 +694,27 @@ struct PsSceneBgStyleReqBody {
 
 struct ProjectGraphicLayerSettingsReqBody {
     ProjectGraphicLayerSettingsReqBody() = default;
-    ProjectGraphicLayerSettingsReqBody(const nlohmann::json &_data) {
-        if (_data.contains("layers") && _data["layers"].is_array()) {
-            for (const auto& layerData : _data["layers"]) {
-                BaseLayer layer;
-                if (layerData.contains("uuid")) layer.uuid = layerData["uuid"];
-                if (layerData.contains("type")) layer.type = layerData["type"];
-                if (layerData.contains("timeOffsetInScene")) layer.timeOffsetInScene = layerData["timeOffsetInScene"];
-                if (layerData.contains("duration")) layer.duration = layerData["duration"];
-                if (layerData.contains("data")) layer.data = layerData["data"];
-                layers.push_back(layer);
-            }
-        }
+    ProjectGraphicLayerSettingsReqBody(JsonReader &in) {
+        in.forEach("layers", [this](JsonReader &layerIn) {
+            BaseLayer layer;
+            layerIn.read("uuid", layer.uuid);
+            layerIn.read("type", layer.type);
+            layerIn.read("timeOffsetInScene", layer.timeOffsetInScene);
+            layerIn.read("duration", layer.duration);
+            layerIn.read("data", layer.data);
+            layers.push_back(layer);
+        });
     }
     std::vector<BaseLayer> layers;
 };
 
 struct CreateWallpaperReqBody {
     CreateWallpaperReqBody() = default;
-    CreateWallpaperReqBody(const nlohmann::json &_data) {
-        if (_data.contains("prompt")) prompt = _data["prompt"];
-        if (_data.contains("style")) style = _data["style"];
-        if (_data.contains("width")) width = _data["width"];
-        if (_data.contains("height")) height = _data["height"];
+    CreateWallpaperReqBody(JsonReader &in) {
+        in.read("prompt", prompt);
+        in.read("style", style);
+        in.read("width", width);
+        in.read("height", height);
     }
     std::string prompt;
     std::string style;
@@ -721,10 +724,10 @@ struct CreateWallpaperReqBody {
 
 struct PsBgImageBo {
     PsBgImageBo() = default;
-    PsBgImageBo(const nlohmann::json &_data) {
-        if (_data.contains("imageUrl")) imageUrl = _data["imageUrl"];
-        if (_data.contains("name")) name = _data["name"];
-        if (_data.contains("description")) description = _data["description"];
+    PsBgImageBo(JsonReader &in) {
+        in.read("imageUrl", imageUrl);
+        in.read("name", name);
+        in.read("description", description);
     }
     std::string imageUrl;
     std::string name;
@@ -734,12 +737,92 @@ struct PsBgImageBo {
 // Avatar management request bodies
 struct ChangeLookReqBody {
     ChangeLookReqBody() = default;
-    ChangeLookReqBody(const nlohmann::json &_data) {
-        if (_data.contains("lookUuid")) lookUuid = _data["lookUuid"];
+    ChangeLookReqBody(JsonReader &in) {
+        in.read("lookUuid", lookUuid);
     }
     std::string lookUuid;
 };
 
+// Batch editing: one request carrying many scene and timeline operations.
+// Each operation is the request body of the matching single-call route.
+using BatchOperation = std::variant<
+    ExtendedProjectSceneAddReqBody,
+    ExtendedProjectSceneRenameReqBody,
+    ExtendedProjectSceneMoveReqBody,
+    ExtendedProjectSceneSetTimeReqBody,
+    ExtendedProjectSceneCutReqBody,
+    ExtendedProjectSceneSplitReqBody,
+    ExtendedProjectSceneMergeReqBody,
+    ExtendedProjectSceneDeleteReqBody,
+    AddSceneAudioReqBody,
+    ExtendedProjectSceneClearFootageReqBody,
+    ProjectSceneReplaceFootageReqBody,
+    ProjectSceneAdjustFootageReqBody,
+    ProjectSceneFootageAddReqBody,
+    ProjectSceneFootageDeleteReqBody,
+    AddVoiceOverReqBody,
+    DeleteVoiceOverReqBody,
+    AdjustVoiceOverReqBody,
+    ProjectSceneSetPauseTimeReqBody,
+    ProjectSceneTransitionReqBody,
+    ProjectSceneEditScriptReqBody,
+    ProjectSceneSetTranscriptReqBody,
+    SetMainStoryOrderReqBody>;
+
+struct ProjectBatchReqBody {
+    ProjectBatchReqBody() = default;
+    // {"operations": [{"op": "<ExtendedControllerAPI method>", "body": {...}}, ...]}
+    ProjectBatchReqBody(JsonReader &in) {
+        in.forEach("operations", [this](JsonReader &op) {
+            std::string name;
+            op.require("op", name);
+            JsonReader body = op.child("body");
+            Parser parser = findParser(name);
+            if (!parser) {
+                if (op.ok()) op.fail("unknown batch operation: " + name);
+                return;
+            }
+            operations.push_back(parser(body));
+        });
+    }
+    std::vector<BatchOperation> operations;
+
+private:
+    using Parser = BatchOperation (*)(JsonReader &);
+
+    template <typename T>
+    static BatchOperation parse(JsonReader &body) { return T(body); }
+
+    static Parser findParser(const std::string &name) {
+        static const std::unordered_map<std::string, Parser> parsers = {
+            {"addScene", &parse<ExtendedProjectSceneAddReqBody>},
+            {"renameScene", &parse<ExtendedProjectSceneRenameReqBody>},
+            {"moveScene", &parse<ExtendedProjectSceneMoveReqBody>},
+            {"setSceneTime", &parse<ExtendedProjectSceneSetTimeReqBody>},
+            {"cutScene", &parse<ExtendedProjectSceneCutReqBody>},
+            {"splitScene", &parse<ExtendedProjectSceneSplitReqBody>},
+            {"mergeScenes", &parse<ExtendedProjectSceneMergeReqBody>},
+            {"deleteScene", &parse<ExtendedProjectSceneDeleteReqBody>},
+            {"addSceneAudio", &parse<AddSceneAudioReqBody>},
+            {"clearFootage", &parse<ExtendedProjectSceneClearFootageReqBody>},
+            {"replaceFootage", &parse<ProjectSceneReplaceFootageReqBody>},
+            {"adjustFootage", &parse<ProjectSceneAdjustFootageReqBody>},
+            {"addFootage", &parse<ProjectSceneFootageAddReqBody>},
+            {"deleteFootage", &parse<ProjectSceneFootageDeleteReqBody>},
+            {"addVoiceOver", &parse<AddVoiceOverReqBody>},
+            {"deleteVoiceOver", &parse<DeleteVoiceOverReqBody>},
+            {"adjustVoiceOver", &parse<AdjustVoiceOverReqBody>},
+            {"setPauseTime", &parse<ProjectSceneSetPauseTimeReqBody>},
+            {"setSceneTransition", &parse<ProjectSceneTransitionReqBody>},
+            {"editScript", &parse<ProjectSceneEditScriptReqBody>},
+            {"setSceneTranscript", &parse<ProjectSceneSetTranscriptReqBody>},
+            {"setMainStoryOrder", &parse<SetMainStoryOrderReqBody>},
+        };
+        auto it = parsers.find(name);
+        return it == parsers.end() ? nullptr : it->second;
+    }
+};
+
 // Serialization helpers (basic implementations)
 NLOHMANN_JSON_SERIALIZE_ENUM(SceneTypeEnum, {
     {SceneTypeEnum::DEFAULT, "default"},
@@ -0,0 +1,64 @@
+#ifndef PJSON_EDITOR_JSON_BLOB_H
+#define PJSON_EDITOR_JSON_BLOB_H
+
+#include <cassert>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <utility>
+
+namespace pjson {
+
+/**
+ * An optional JSON value that models pass through but never edit in place
+ * (crop and Ken Burns data, layer data, transition easing, the deprecated
+ * scene fields).
+ *
+ * The value is immutable and shared: copying a timeline, a scene or a whole
+ * project snapshot bumps a reference count instead of cloning the DOM, and
+ * a blob costs one pointer pair instead of an inline nlohmann::json plus
+ * the optional flag. Changing it means assigning a new value. Reads go
+ * through the same operators as std::optional<json>.
+ */
+class JsonBlob {
+public:
+    JsonBlob() = default;
+    JsonBlob(std::nullopt_t) {}
+    JsonBlob(nlohmann::json value)
+        : blob(std::make_shared<const nlohmann::json>(std::move(value))) {}
+
+    JsonBlob &operator=(nlohmann::json value) {
+        blob = std::make_shared<const nlohmann::json>(std::move(value));
+        return *this;
+    }
+    void reset() { blob.reset(); }
+
+    bool has_value() const { return blob != nullptr; }
+    explicit operator bool() const { return has_value(); }
+    const nlohmann::json &value() const {
+        assert(blob && "empty JsonBlob");
+        return *blob;
+    }
+    const nlohmann::json &operator*() const { return value(); }
+    const nlohmann::json *operator->() const { return &value(); }
+
+    // True when both hold the very same value, as copies of one blob do.
+    bool shares(const JsonBlob &other) const { return blob == other.blob; }
+
+    friend bool operator==(const JsonBlob &a, const JsonBlob &b) {
+        return a.blob == b.blob || (a.blob && b.blob && *a.blob == *b.blob);
+    }
+    friend bool operator!=(const JsonBlob &a, const JsonBlob &b) { return !(a == b); }
+
+private:
+    std::shared_ptr<const nlohmann::json> blob;
+};
+
+// An empty blob serializes as null.
+inline void to_json(nlohmann::json &j, const JsonBlob &blob) {
+    j = blob ? *blob : nlohmann::json();
+}
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_JSON_BLOB_H
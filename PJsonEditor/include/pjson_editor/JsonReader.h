@@ -0,0 +1,233 @@
+#ifndef PJSON_EDITOR_JSON_READER_H
+#define PJSON_EDITOR_JSON_READER_H
+
+#include "Expected.h"
+#include "JsonBlob.h"
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pjson {
+
+// Checked conversions that never throw: true with `out` set when `value`
+// has a matching JSON type, false with `out` untouched otherwise. Integers
+// accept any JSON number (fractions truncate), as nlohmann's own
+// conversions do. Enums are read from their numeric value.
+bool readValue(const nlohmann::json &value, std::string &out);
+bool readValue(const nlohmann::json &value, int &out);
+bool readValue(const nlohmann::json &value, int64_t &out);
+bool readValue(const nlohmann::json &value, uint64_t &out);
+bool readValue(const nlohmann::json &value, double &out);
+bool readValue(const nlohmann::json &value, bool &out);
+bool readValue(const nlohmann::json &value, nlohmann::json &out);
+// Any value, null included, is kept as it is.
+bool readValue(const nlohmann::json &value, std::optional<nlohmann::json> &out);
+bool readValue(const nlohmann::json &value, JsonBlob &out);
+template <typename E, std::enable_if_t<std::is_enum<E>::value, int> = 0>
+bool readValue(const nlohmann::json &value, E &out);
+
+// The containers nest (optional<vector<string>>, map<string, vector<int>>),
+// so each template has to see the others before it is defined.
+template <typename T>
+bool readValue(const nlohmann::json &value, std::optional<T> &out);
+template <typename T>
+bool readValue(const nlohmann::json &value, std::vector<T> &out);
+template <typename T>
+bool readValue(const nlohmann::json &value, std::unordered_map<std::string, T> &out);
+
+template <typename E, std::enable_if_t<std::is_enum<E>::value, int>>
+bool readValue(const nlohmann::json &value, E &out) {
+    int number = 0;
+    if (!readValue(value, number)) {
+        return false;
+    }
+    out = static_cast<E>(number);
+    return true;
+}
+
+// null reads as an empty optional.
+template <typename T>
+bool readValue(const nlohmann::json &value, std::optional<T> &out) {
+    if (value.is_null()) {
+        out.reset();
+        return true;
+    }
+    T item{};
+    if (!readValue(value, item)) {
+        return false;
+    }
+    out = std::move(item);
+    return true;
+}
+
+template <typename T>
+bool readValue(const nlohmann::json &value, std::vector<T> &out) {
+    if (!value.is_array()) {
+        return false;
+    }
+    std::vector<T> items;
+    items.reserve(value.size());
+    for (const auto &element : value) {
+        T item{};
+        if (!readValue(element, item)) {
+            return false;
+        }
+        items.push_back(std::move(item));
+    }
+    out = std::move(items);
+    return true;
+}
+
+template <typename T>
+bool readValue(const nlohmann::json &value, std::unordered_map<std::string, T> &out) {
+    if (!value.is_object()) {
+        return false;
+    }
+    std::unordered_map<std::string, T> items;
+    for (const auto &[key, element] : value.items()) {
+        T item{};
+        if (!readValue(element, item)) {
+            return false;
+        }
+        items.emplace(key, std::move(item));
+    }
+    out = std::move(items);
+    return true;
+}
+
+/**
+ * Field-by-field decoder for a JSON object that records errors instead of
+ * throwing.
+ *
+ * read() fills a field when its key is present, require() also fails when
+ * it is missing; a value of the wrong type fails and leaves the field as it
+ * was. child(), forEach() and forEachMember() descend into nested objects,
+ * arrays and maps and report into the same error, with the path of the
+ * offending value ("operations[2].body.sceneUuid: unexpected number").
+ * Only the first error is kept; decoding carries on so a caller can still
+ * look at what was read.
+ *
+ * Readers only borrow the JSON they read and their parents: use them
+ * within the scope that created them.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const nlohmann::json &data);
+    JsonReader(const JsonReader &) = delete;
+    JsonReader &operator=(const JsonReader &) = delete;
+
+    const nlohmann::json &data() const { return value; }
+    bool has(const char *key) const { return find(key) != nullptr; }
+
+    template <typename T>
+    JsonReader &read(const char *key, T &out) {
+        if (const nlohmann::json *field = find(key)) {
+            if (!readValue(*field, out)) {
+                failType(key, *field);
+            }
+        }
+        return *this;
+    }
+
+    template <typename T>
+    JsonReader &require(const char *key, T &out) {
+        if (!has(key)) {
+            failField(key, "missing");
+            return *this;
+        }
+        return read(key, out);
+    }
+
+    // Reader for the object at `key`; an absent or null key reads as an
+    // object without fields.
+    JsonReader child(const char *key);
+
+    // f(JsonReader &element) for each element of the array at `key`.
+    template <typename F>
+    JsonReader &forEach(const char *key, F &&f) {
+        const nlohmann::json *field = container(key, nlohmann::json::value_t::array);
+        if (field) {
+            JsonReader list(*field, this, key);
+            for (size_t i = 0; i < field->size(); ++i) {
+                JsonReader element((*field)[i], &list, std::string_view(), i);
+                f(element);
+            }
+        }
+        return *this;
+    }
+
+    // f(const std::string &name, JsonReader &member) for each member of the
+    // object at `key`.
+    template <typename F>
+    JsonReader &forEachMember(const char *key, F &&f) {
+        const nlohmann::json *field = container(key, nlohmann::json::value_t::object);
+        if (field) {
+            JsonReader map(*field, this, key);
+            for (const auto &[name, member] : field->items()) {
+                JsonReader element(member, &map, name);
+                f(name, element);
+            }
+        }
+        return *this;
+    }
+
+    // Records `message` for this reader's path unless an error was already
+    // recorded.
+    void fail(const std::string &message);
+
+    bool ok() const { return !root->failed; }
+    const std::string &error() const { return root->firstError; }
+
+private:
+    static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+    JsonReader(const nlohmann::json &value, JsonReader *parent, std::string_view key,
+               size_t index = NO_INDEX);
+
+    const nlohmann::json *find(const char *key) const;
+    // The array or object at `key`, null when absent or null, and an error
+    // when it is something else.
+    const nlohmann::json *container(const char *key, nlohmann::json::value_t type);
+    std::string path() const;
+
+    void failField(const char *key, const std::string &message);
+    void failType(const char *key, const nlohmann::json &field) {
+        failField(key, std::string("unexpected ") + field.type_name());
+    }
+
+    const nlohmann::json &value;
+    JsonReader *parent{nullptr};
+    JsonReader *root{this};
+    std::string_view key;
+    size_t index{NO_INDEX};
+    bool failed{false};
+    std::string firstError;
+};
+
+/**
+ * Decodes a request body with T's `T(JsonReader &)` constructor. The body
+ * has to be an object; null (no body) decodes like an empty one.
+ */
+template <typename T>
+Expected<T> decodeBody(const nlohmann::json &body) {
+    if (!body.is_object() && !body.is_null()) {
+        return makeUnexpected(std::string("expected an object, got ") + body.type_name());
+    }
+    JsonReader in(body);
+    T decoded(in);
+    if (!in.ok()) {
+        return makeUnexpected(in.error());
+    }
+    return decoded;
+}
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_JSON_READER_H
@@ -0,0 +1,47 @@
+#ifndef PJSON_EDITOR_LAYER_PARTITIONER_H
+#define PJSON_EDITOR_LAYER_PARTITIONER_H
+
+#include "ExtendedModels.h"
+#include "SceneCutUtils.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+/**
+ * Re-timing of a scene's graphic layers (stickers, text, narration, avatar)
+ * when the scene is split, merged or cut, one pass over the layers each.
+ *
+ * A layer plays for [timeOffsetInScene, timeOffsetInScene + duration) in
+ * scene time and is clipped to the scene. A negative duration means the
+ * whole scene (as addAvatar creates them); such layers keep covering
+ * whatever scene they end up in. Zero-length layers are markers: they move
+ * with their offset and are never dropped.
+ */
+
+inline bool coversWholeScene(const BaseLayer &layer) { return layer.duration < 0; }
+
+// Moves `layers` of a scene of length sceneDuration into the halves of a
+// split at splitTime. A layer spanning the split is truncated in the first
+// half and continues at 0 in the second under a uuid from newUuid, as do
+// whole-scene layers.
+void splitLayers(std::vector<BaseLayer> &layers, int splitTime, int sceneDuration,
+                 std::vector<BaseLayer> &first, std::vector<BaseLayer> &second,
+                 const std::function<std::string()> &newUuid);
+
+// Appends the latter scene's layers to the former's, rebased by
+// formerDuration and clipped to mergedDuration. A layer type with a
+// whole-scene layer in both scenes keeps the former's, covering the merged
+// scene; a whole-scene layer only one side has is limited to that side's
+// part.
+void mergeLayers(std::vector<BaseLayer> &former, std::vector<BaseLayer> &latter,
+                 int formerDuration, int latterDuration, int mergedDuration);
+
+// Clips layers to a scene of length sceneDuration and shortens them by the
+// removed ranges; layers entirely inside a cut are dropped.
+void cutLayers(std::vector<BaseLayer> &layers, const SceneCutList &cuts, int sceneDuration);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_LAYER_PARTITIONER_H
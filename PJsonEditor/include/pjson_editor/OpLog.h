@@ -0,0 +1,99 @@
+#ifndef PJSON_EDITOR_OP_LOG_H
+#define PJSON_EDITOR_OP_LOG_H
+
+#include "IdGenerator.h"
+#include "pjson_editor.hpp"
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+struct OpLogOptions {
+    // The editor writes a new checkpoint once this many ops were appended
+    // after the last one.
+    size_t checkpointInterval{256};
+    // Flush after every op. Off by default: ops are buffered and reach the
+    // file at the next checkpoint, flush() or when the log is destroyed, so
+    // a crash can lose the ops since then.
+    bool flushEachOp{false};
+};
+
+/**
+ * Append-only binary log of the requests that changed a project, for
+ * resuming a session after the tab or worker running it died.
+ *
+ * The file starts with the magic "PJOL" and a little-endian u32 format
+ * version, followed by frames: a kind byte ('C' checkpoint, 'O' op), the
+ * u32 payload length, the u32 FNV-1a hash of the payload and the payload
+ * itself in CBOR. A checkpoint holds the project version, the id generator
+ * state and the project in encodeProjectCheckpoint() form; an op holds the
+ * request, the version it produced and the id generator state before it
+ * ran.
+ *
+ * Recovery loads the latest checkpoint and replays the ops after it. A log
+ * opened on a path is compacted at every checkpoint: the checkpoint is
+ * written to a new file that then replaces the old one, so the file never
+ * holds more than one checkpoint interval of ops. A log on a stream only
+ * appends.
+ */
+class OpLog {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    explicit OpLog(std::ostream &out, OpLogOptions options = {});
+    explicit OpLog(const std::string &path, OpLogOptions options = {});
+    ~OpLog();
+
+    bool isOpen() const { return out != nullptr && out->good(); }
+    const OpLogOptions &options() const { return opts; }
+
+    void appendOp(const Request &req, int version, const IdGenerator::State &ids);
+    void appendCheckpoint(int version, const IdGenerator::State &ids,
+                          const nlohmann::json &project);
+
+    size_t opsSinceCheckpoint() const { return pendingOps; }
+    bool checkpointDue() const { return pendingOps >= opts.checkpointInterval; }
+
+    void flush();
+
+private:
+    void writeHeader(std::ostream &stream);
+    void writeFrame(std::ostream &stream, char kind, const nlohmann::json &payload);
+    bool compactInto(const nlohmann::json &checkpoint);
+
+    OpLogOptions opts;
+    std::string path;
+    std::ofstream file;
+    std::ostream *out{nullptr};
+    std::vector<uint8_t> scratch;
+    size_t pendingOps{0};
+};
+
+struct LoggedOp {
+    Request request;
+    int version{0};
+    IdGenerator::State ids;
+};
+
+struct RecoveredLog {
+    int version{0};
+    IdGenerator::State ids;
+    nlohmann::json project;     // latest checkpoint
+    std::vector<LoggedOp> ops;  // appended after it, oldest first
+    bool truncated{false};      // an incomplete last frame was dropped
+};
+
+// Reads a log written by OpLog. A torn frame at the end (a crash during a
+// write) is dropped and reported through `truncated`; anything else that
+// is not a valid log returns false and fills `error`.
+bool loadOpLog(std::istream &in, RecoveredLog &log, std::string *error = nullptr);
+bool loadOpLog(const std::string &path, RecoveredLog &log, std::string *error = nullptr);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_OP_LOG_H
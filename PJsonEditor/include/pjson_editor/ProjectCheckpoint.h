@@ -0,0 +1,27 @@
+#ifndef PJSON_EDITOR_PROJECT_CHECKPOINT_H
+#define PJSON_EDITOR_PROJECT_CHECKPOINT_H
+
+#include "Expected.h"
+#include "ExtendedModels.h"
+#include <nlohmann/json.hpp>
+
+namespace pjson {
+
+/**
+ * Lossless JSON form of the in-memory project, for checkpoints.
+ *
+ * Unlike the /scene/list payload the project is parsed from (which only
+ * carries what the backend sends) or the views sent back to clients, this
+ * keeps every model field, including the version counters, so a decoded
+ * checkpoint edits exactly like the project it was taken from. Enums are
+ * stored as their numeric values. Field names follow the model structs;
+ * missing fields decode to the struct defaults.
+ */
+nlohmann::json encodeProjectCheckpoint(const ExtendedProjectAndScenesVo &project);
+
+// Fails with the path of the first field that has the wrong type.
+Expected<ExtendedProjectAndScenesVo> decodeProjectCheckpoint(const nlohmann::json &checkpoint);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_PROJECT_CHECKPOINT_H
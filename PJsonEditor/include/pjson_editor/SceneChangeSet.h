@@ -0,0 +1,59 @@
+#ifndef PJSON_EDITOR_SCENE_CHANGE_SET_H
+#define PJSON_EDITOR_SCENE_CHANGE_SET_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+/**
+ * The scenes a derived structure (hot block, timeline index, ...) has to
+ * re-read before its next use.
+ *
+ * Handing out one scene for mutation marks that scene; handing out the whole
+ * project marks everything. A scene is recorded both by position and by
+ * uuid, so a consumer can still find it after the scene list was reordered:
+ * `sceneList` says scenes were added, removed or moved, without their
+ * timelines changing.
+ */
+struct SceneChangeSet {
+    bool all{true};
+    bool sceneList{false};
+    std::vector<size_t> sceneIndices;
+    std::vector<std::string> sceneUuids;
+
+    void markAll() {
+        all = true;
+        sceneIndices.clear();
+        sceneUuids.clear();
+    }
+
+    void markSceneList() { sceneList = true; }
+
+    // Once there are more marks than scenes it is cheaper to start over.
+    void markScene(size_t index, const std::string& uuid, size_t sceneCount) {
+        if (all || (!sceneIndices.empty() && sceneIndices.back() == index && sceneUuids.back() == uuid)) {
+            return;
+        }
+        if (sceneIndices.size() >= sceneCount) {
+            markAll();
+            return;
+        }
+        sceneIndices.push_back(index);
+        sceneUuids.push_back(uuid);
+    }
+
+    bool empty() const { return !all && !sceneList && sceneIndices.empty(); }
+
+    void clear() {
+        all = false;
+        sceneList = false;
+        sceneIndices.clear();
+        sceneUuids.clear();
+    }
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_SCENE_CHANGE_SET_H
@@ -0,0 +1,84 @@
+#ifndef PJSON_EDITOR_SCENE_CUT_UTILS_H
+#define PJSON_EDITOR_SCENE_CUT_UTILS_H
+
+#include "ExtendedModels.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+// Playback rate of a timeline; voice-overs always play at 1x.
+inline double playbackSpeed(const ExtendedTimeline &timeline) { return timeline.speed; }
+inline double playbackSpeed(const VoiceOver &) { return 1.0; }
+
+// Media time covered by timelineMs of playback at `speed`, rounded to the
+// millisecond. Anything but a positive speed counts as 1x.
+inline int mediaSpan(double speed, int timelineMs) {
+    if (!(speed > 0.0) || speed == 1.0) {
+        return timelineMs;
+    }
+    return static_cast<int>(std::llround(timelineMs * speed));
+}
+
+/**
+ * The ranges removed from one scene, in scene time.
+ *
+ * Built once per cut: the requested periods are clipped to the scene, sorted
+ * and merged, and a prefix sum of the removed time is kept, so mapping a time
+ * or a timeline through the cut is a binary search instead of a loop over
+ * every period.
+ */
+class SceneCutList {
+public:
+    SceneCutList(const std::vector<TimePeriod> &cutList, int sceneDuration);
+
+    bool empty() const { return ranges.empty(); }
+    // Total time removed from the scene
+    int removed() const { return removedBefore.back(); }
+    const std::vector<TimePeriod> &periods() const { return ranges; }
+
+    // Where scene time t ends up once the ranges are removed. Times inside a
+    // removed range map to where that range was.
+    int mapTime(int t) const;
+
+    // Calls f(start, end) for every part of [start, end) that is not removed,
+    // in order.
+    template <typename F>
+    void forEachKept(int start, int end, F &&f) const {
+        size_t k = firstEndingAfter(start);
+        int cursor = start;
+        while (cursor < end) {
+            if (k == ranges.size() || ranges[k].start >= end) {
+                f(cursor, end);
+                return;
+            }
+            if (ranges[k].start > cursor) {
+                f(cursor, ranges[k].start);
+            }
+            cursor = std::max(cursor, ranges[k].end);
+            ++k;
+        }
+    }
+
+private:
+    size_t firstEndingAfter(int t) const;
+
+    std::vector<TimePeriod> ranges;  // sorted, disjoint, non-touching
+    std::vector<int> removedBefore;  // removedBefore[k]: length of ranges[0..k)
+};
+
+// Removes the cut ranges from a scene: a-rolls, b-rolls and voice-overs are
+// trimmed, or split into one timeline per kept part (the extra parts get
+// uuids from newUuid), transcript items inside a cut are dropped and the
+// rest are re-timed, layers are shortened (see cutLayers()), and the scene
+// is shortened by cuts.removed().
+// Offsets of other scenes are left to the caller.
+void applySceneCut(ExtendedProjectScene &scene, const SceneCutList &cuts,
+                   const std::function<std::string()> &newUuid);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_SCENE_CUT_UTILS_H
@@ -0,0 +1,49 @@
+#ifndef PJSON_EDITOR_SCENE_PERMUTATION_H
+#define PJSON_EDITOR_SCENE_PERMUTATION_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace pjson {
+
+// A permutation is given as `order`, where order[k] is the current index of
+// the item that ends up at position k.
+
+// Reorders items in place so that items[k] becomes the old items[order[k]].
+// Follows the permutation's cycles, so every element is moved exactly once
+// and nothing is copied.
+template <typename T>
+void applyPermutation(std::vector<T> &items, const std::vector<size_t> &order) {
+    std::vector<bool> done(items.size(), false);
+    for (size_t start = 0; start < items.size(); ++start) {
+        if (done[start] || order[start] == start) {
+            continue;
+        }
+        T carried = std::move(items[start]);
+        size_t dest = start;
+        while (order[dest] != start) {
+            items[dest] = std::move(items[order[dest]]);
+            done[dest] = true;
+            dest = order[dest];
+        }
+        items[dest] = std::move(carried);
+        done[dest] = true;
+    }
+}
+
+// One JSON Patch "move": remove the item at `from`, then insert it at `to`
+// (an index into the list after the removal).
+struct PermutationMove {
+    size_t from;
+    size_t to;
+};
+
+// Fewest single-item moves that turn the current order into `order`: items
+// on a longest increasing run of old indices stay put, every other item is
+// moved once, right behind its new predecessor. O(n log n).
+std::vector<PermutationMove> permutationMoves(const std::vector<size_t> &order);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_SCENE_PERMUTATION_H
@@ -0,0 +1,62 @@
+#ifndef PJSON_EDITOR_SESSION_RECORDER_H
+#define PJSON_EDITOR_SESSION_RECORDER_H
+
+#include "pjson_editor.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+/**
+ * Captures the Request sequence sent to a PJsonEditor into a replay file.
+ *
+ * The file is JSON Lines: one "init" record holding the /scene/list response
+ * the editor was created from, then one "request" record per call with the
+ * status code and the time spent inside PJsonEditor::call.
+ *
+ * Attach the recorder before the first call so the init payload matches the
+ * state the requests were applied to.
+ */
+class SessionRecorder {
+public:
+    static constexpr int FORMAT_VERSION = 1;
+
+    SessionRecorder(std::ostream &out, const nlohmann::json &sceneListResp);
+    SessionRecorder(const std::string &path, const nlohmann::json &sceneListResp);
+
+    bool isOpen() const { return out != nullptr && out->good(); }
+    size_t recordedCount() const { return count; }
+
+    void record(const Request &req, const Response &resp, int64_t elapsedUs);
+
+private:
+    void writeInit(const nlohmann::json &sceneListResp);
+
+    std::ofstream file;
+    std::ostream *out{nullptr};
+    size_t count{0};
+};
+
+struct RecordedCall {
+    Request request;
+    int statusCode{0};
+    int64_t elapsedUs{0};
+};
+
+struct RecordedSession {
+    nlohmann::json sceneList;
+    std::vector<RecordedCall> calls;
+};
+
+// Reads a file written by SessionRecorder. Returns false and fills `error`
+// when the stream is not a valid session.
+bool loadSession(std::istream &in, RecordedSession &session, std::string *error = nullptr);
+bool loadSession(const std::string &path, RecordedSession &session, std::string *error = nullptr);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_SESSION_RECORDER_H
@@ -0,0 +1,76 @@
+#ifndef PJSON_EDITOR_SPSC_RING_H
+#define PJSON_EDITOR_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace pjson {
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread.
+ *
+ * The producer only writes `tail` and the consumer only writes `head`; a
+ * release store of either publishes the slot it covers, so no slot is
+ * read and written at the same time. The two indices sit on separate cache
+ * lines. Capacity is rounded up to a power of two. Items are moved in and
+ * out; a popped slot keeps a moved-from T until it is reused.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask(roundUp(capacity) - 1), slots(new T[mask + 1]) {}
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer side; false (and `item` untouched) when the ring is full.
+    bool push(T &&item) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[t & mask] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when the ring is empty.
+    bool pop(T &item) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(slots[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Exact on the consumer side, a snapshot anywhere else.
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t mask;
+    std::unique_ptr<T[]> slots;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_SPSC_RING_H
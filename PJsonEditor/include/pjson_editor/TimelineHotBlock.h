@@ -0,0 +1,85 @@
+#ifndef PJSON_EDITOR_TIMELINE_HOT_BLOCK_H
+#define PJSON_EDITOR_TIMELINE_HOT_BLOCK_H
+
+#include "ExtendedModels.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pjson {
+
+enum class TimelineTrack : uint8_t { A_ROLL, B_ROLL, VOICE_OVER };
+
+/**
+ * Struct-of-arrays copy of the timing fields of every timeline in a project
+ * (a-rolls, b-rolls and voice-overs, in scene order).
+ *
+ * ExtendedTimeline / VoiceOver are large (strings, optional<json>,
+ * blendMode), so walking them to touch one int per element wastes most of
+ * every cache line. The block keeps the hot ints contiguous and is the
+ * working copy of the offsets: bulk updates run over the int32 columns and
+ * write the results back through per-entry pointers into the cold structs,
+ * without reading them first. Scenes edited through the models have to be
+ * re-read with refreshScene() before the next bulk update.
+ *
+ * Entries of scene s occupy [sceneBegin(s), sceneEnd(s)), so "every timeline
+ * from scene i on" is always one contiguous suffix.
+ */
+class TimelineHotBlock {
+public:
+    // Hot columns, one entry per timeline.
+    std::vector<int32_t> offsets;        // timeOffsetInProject
+    std::vector<int32_t> offsetsInScene; // timeOffsetInScene
+    std::vector<int32_t> durations;
+    std::vector<int32_t> startTimes;
+    std::vector<int32_t> endTimes;
+    std::vector<int32_t> sceneIndex;
+    std::vector<TimelineTrack> tracks;
+
+    void build(std::vector<ExtendedProjectScene> &scenes);
+    void clear();
+
+    // Re-reads the timelines of scene `scene`, which may have gained or lost
+    // some; the entries of the scenes behind it move along.
+    void refreshScene(std::vector<ExtendedProjectScene> &scenes, size_t scene);
+
+    // True when the block was built from `scenes` and no timeline vector has
+    // been resized, reallocated or reordered since.
+    bool matches(const std::vector<ExtendedProjectScene> &scenes) const;
+
+    size_t size() const { return offsets.size(); }
+    size_t sceneCount() const { return sceneStart.empty() ? 0 : sceneStart.size() - 1; }
+    size_t sceneBegin(size_t scene) const { return sceneStart[scene]; }
+    size_t sceneEnd(size_t scene) const { return sceneStart[scene + 1]; }
+
+    // offsets[i] += delta for every entry of scenes [beginScene, endScene),
+    // written back to the timelines.
+    void shiftScenes(size_t beginScene, size_t endScene, int32_t delta);
+
+    // offsets[i] = sceneOffsets[sceneIndex[i]] + offsetsInScene[i]; only the
+    // entries that moved are written back to the timelines.
+    void rebaseOnScenes(const std::vector<int32_t> &sceneOffsets);
+
+private:
+    void writeBackOffsets(size_t begin, size_t end);
+
+    struct SceneLayout {
+        const void *aRolls;
+        size_t aRollCount;
+        const void *bRolls;
+        size_t bRollCount;
+        const void *voiceOvers;
+        size_t voiceOverCount;
+    };
+    static SceneLayout layoutOf(const ExtendedProjectScene &scene);
+
+    // Cold back-references: where each entry's offset lives in the models.
+    std::vector<int *> offsetSlots;
+    std::vector<size_t> sceneStart;
+    std::vector<SceneLayout> layout;
+    const void *scenesData{nullptr};
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_TIMELINE_HOT_BLOCK_H
@@ -0,0 +1,95 @@
+#ifndef PJSON_EDITOR_TIMELINE_INDEX_H
+#define PJSON_EDITOR_TIMELINE_INDEX_H
+
+#include "ExtendedModels.h"
+#include "SceneChangeSet.h"
+#include "TimelineHotBlock.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pjson {
+
+// A timeline playing in a queried span: which one (its scene and its index
+// in that scene's aRolls, bRolls or voiceOvers) and the project time
+// [begin, end) it plays for, cut to its scene.
+struct TimelineHit {
+    TimelineTrack track;
+    size_t sceneIndex;
+    size_t index;
+    int32_t begin;
+    int32_t end;
+};
+
+struct TimelineQueryResult {
+    // Scenes overlapping the span, [sceneBegin, sceneEnd); empty when the
+    // span is outside the project.
+    size_t sceneBegin{0};
+    size_t sceneEnd{0};
+    // By scene, then by start within the scene.
+    std::vector<TimelineHit> timelines;
+};
+
+/**
+ * Time-to-scene and time-to-timeline lookup for playback and scrubbing.
+ *
+ * Scene start offsets are kept sorted for a binary search; the a-roll,
+ * b-roll and voice-over intervals of each scene sit in an interval tree in
+ * scene-relative time, so moving a scene does not touch its tree. A query
+ * costs O(log n) for the scenes plus O(log m + k) per scene it overlaps.
+ * A timeline only counts as playing inside its own scene.
+ *
+ * update() re-reads the scene offsets and rebuilds only the trees of the
+ * scenes in `changes`. After the scene list changed, trees are matched to
+ * scenes by uuid, so edits that shift, add, remove or reorder scenes reuse
+ * the other scenes' trees.
+ */
+class TimelineIndex {
+public:
+    void update(const std::vector<ExtendedProjectScene> &scenes, const SceneChangeSet &changes);
+    void clear();
+
+    // Scene playing at `timeMs`, or SIZE_MAX outside the project.
+    size_t sceneAt(int32_t timeMs) const;
+
+    // What plays at `timeMs`.
+    TimelineQueryResult activeAt(int32_t timeMs) const;
+    // What plays at some point in [beginMs, endMs).
+    TimelineQueryResult rangeQuery(int32_t beginMs, int32_t endMs) const;
+
+    size_t sceneCount() const { return sceneStarts.size(); }
+    // Trees the last update() had to build.
+    size_t rebuiltScenes() const { return lastRebuilt; }
+
+private:
+    struct Interval {
+        int32_t begin;  // scene-relative
+        int32_t end;
+        TimelineTrack track;
+        uint32_t index;
+    };
+
+    // Implicit interval tree over intervals sorted by begin: the node of a
+    // range [lo, hi) is its middle element, maxEnd[i] the largest end in the
+    // subtree of node i.
+    struct SceneTree {
+        std::string uuid;
+        std::vector<Interval> intervals;
+        std::vector<int32_t> maxEnd;
+
+        void build(const ExtendedProjectScene &scene);
+    };
+
+    void collect(size_t scene, int32_t beginMs, int32_t endMs,
+                 TimelineQueryResult &result) const;
+
+    std::vector<int32_t> sceneStarts;
+    std::vector<int32_t> sceneEnds;
+    std::vector<SceneTree> trees;
+    size_t lastRebuilt{0};
+};
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_TIMELINE_INDEX_H
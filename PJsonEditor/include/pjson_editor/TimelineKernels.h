@@ -0,0 +1,52 @@
+#ifndef PJSON_EDITOR_TIMELINE_KERNELS_H
+#define PJSON_EDITOR_TIMELINE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pjson {
+
+/**
+ * Vectorised int32 kernels for timing columns such as TimelineHotBlock's.
+ * They pay off on data that already is in columns: shiftScenes runs addDelta
+ * over the block's offsets. A handler checking a scene's few b-rolls loops
+ * over them in place instead, since gathering them into scratch columns for
+ * findOverlap or clampEndTimes costs more than the loop saves
+ * (bench/pjson_kernels_bench.cpp measures both).
+ *
+ * x86 builds carry SSE4.1 and AVX2 variants and pick the widest one the CPU
+ * supports at first use. WebAssembly builds compiled with -msimd128 use the
+ * SIMD128 variant. Everything else (or -DPJSON_SIMD=OFF) uses the scalar loops.
+ * All variants give identical results.
+ */
+enum class KernelIsa : uint8_t { SCALAR, SSE41, AVX2, WASM_SIMD128 };
+
+struct TimelineKernels {
+    KernelIsa isa;
+    const char *name;
+
+    // values[i] += delta for i in [0, n)
+    void (*addDelta)(int32_t *values, size_t n, int32_t delta);
+
+    // Index of the first interval [starts[i], ends[i]) that overlaps
+    // [start, end), or -1 when none does. Touching intervals do not overlap.
+    ptrdiff_t (*findOverlap)(const int32_t *starts, const int32_t *ends, size_t n,
+                             int32_t start, int32_t end);
+
+    // endTimes[i] = min(endTimes[i], startTimes[i] + maxDuration); durations
+    // of the clamped entries become endTimes[i] - startTimes[i]. Returns the
+    // number of entries clamped.
+    size_t (*clampEndTimes)(const int32_t *startTimes, int32_t *endTimes, int32_t *durations,
+                            size_t n, int32_t maxDuration);
+};
+
+// Best variant available on this machine.
+const TimelineKernels &timelineKernels();
+
+// A specific variant, or nullptr when it is not compiled in or the CPU lacks
+// the instructions. SCALAR is always available.
+const TimelineKernels *timelineKernelsFor(KernelIsa isa);
+
+} // namespace pjson
+
+#endif // PJSON_EDITOR_TIMELINE_KERNELS_H
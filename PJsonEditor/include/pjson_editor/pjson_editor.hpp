@@ -1,10 +1,19 @@
+#ifndef PJSON_EDITOR_HPP
+#define PJSON_EDITOR_HPP
+
 #include "nlohmann/json.hpp"
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 namespace pjson {
 
 class ExtendedDataStore;
 class ExtendedControllerAPI;
+class SessionRecorder;
+class OpLog;
+class IdGenerator;
+struct RecoveredLog;
 // define me a HttpRequest and HttpResponse structs
 struct Request {
   std::string method;
@@ -23,11 +32,46 @@ class PJsonEditor {
 public:
   PJsonEditor(const nlohmann::json &);
   Response call(Request req);
-  virtual ~PJsonEditor() = default;
+  virtual ~PJsonEditor();
+
+  // Per-handler and per-route heap counters; {"enabled": false} unless the
+  // library was built with PJSON_ALLOC_STATS.
+  nlohmann::json allocStats() const;
+  void resetAllocStats();
+
+  // Every call made after this is appended to the recorder; pass nullptr to
+  // stop recording.
+  void setSessionRecorder(std::shared_ptr<SessionRecorder> recorder);
+
+  // Crash-recovery log: writes a checkpoint of the current project now, then
+  // appends every call that changes the project, with a new checkpoint every
+  // OpLogOptions::checkpointInterval ops. Pass nullptr to stop logging.
+  void setOpLog(std::shared_ptr<OpLog> log);
+
+  // Replaces the project with the log's checkpoint and replays the ops after
+  // it. Returns false and fills `error` when a replayed op does not reach
+  // the version it was logged with; the ops before it stay applied.
+  bool recover(const RecoveredLog &log, std::string *error = nullptr);
+
+  // Generator of the ids this editor creates; reseed or switch to v7 ids
+  // before the first call.
+  IdGenerator &idGenerator();
+
+  // Change feed of successful mutations, for clients that sync
+  // incrementally. Pass the returned "cursor" to the next call (0 to start);
+  // see ExtendedControllerAPI::changesSince for the result shape.
+  nlohmann::json changesSince(uint64_t cursor,
+                              size_t maxRecords = SIZE_MAX) const;
 
 private:
   std::unique_ptr<ExtendedControllerAPI> controller;
   std::unique_ptr<ExtendedDataStore> dataStore;
+  std::shared_ptr<SessionRecorder> recorder;
+  std::shared_ptr<OpLog> opLog;
+
+  void writeCheckpoint();
 };
 
-} // namespace pjson
\ No newline at end of file
+} // namespace pjson
+
+#endif // PJSON_EDITOR_HPP
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "pjson_editor/AllocStats.h"
+
+#ifdef PJSON_ALLOC_STATS
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#endif
+
+namespace pjson {
+
+#ifdef PJSON_ALLOC_STATS
+
+namespace {
+
+// Every block carries its size in a header so delete can update the live
+// byte count. The header keeps the default new alignment.
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+// Trivially initialised, so they are safe to touch from operator new.
+thread_local uint64_t tAllocations = 0;
+thread_local uint64_t tDeallocations = 0;
+thread_local uint64_t tBytes = 0;
+thread_local uint64_t tLiveBytes = 0;
+thread_local uint64_t tPeakLiveBytes = 0;
+// Set while the stats table itself allocates, so that bookkeeping never
+// shows up in the scopes it is recording.
+thread_local bool tSuspended = false;
+
+struct ScopeTotals {
+    uint64_t calls{0};
+    uint64_t allocations{0};
+    uint64_t deallocations{0};
+    uint64_t bytes{0};
+    uint64_t peakLiveBytes{0};
+};
+
+std::mutex &tableMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, ScopeTotals> &table() {
+    static std::map<std::string, ScopeTotals> scopes;
+    return scopes;
+}
+
+void *countedAlloc(std::size_t size) {
+    void *raw = std::malloc(size + kHeaderSize);
+    if (!raw) {
+        return nullptr;
+    }
+    *static_cast<std::size_t *>(raw) = size;
+    if (!tSuspended) {
+        ++tAllocations;
+        tBytes += size;
+    }
+    tLiveBytes += size;
+    tPeakLiveBytes = std::max(tPeakLiveBytes, tLiveBytes);
+    return static_cast<char *>(raw) + kHeaderSize;
+}
+
+void countedFree(void *p) {
+    if (!p) {
+        return;
+    }
+    void *raw = static_cast<char *>(p) - kHeaderSize;
+    std::size_t size = *static_cast<std::size_t *>(raw);
+    if (!tSuspended) {
+        ++tDeallocations;
+    }
+    // Blocks may be freed on another thread than the one that allocated them.
+    tLiveBytes = tLiveBytes >= size ? tLiveBytes - size : 0;
+    std::free(raw);
+}
+
+} // namespace
+
+AllocScope::AllocScope(std::string scopeName)
+    : name(std::move(scopeName)), start(AllocStats::threadTotals()), outerPeak(tPeakLiveBytes) {
+    tPeakLiveBytes = tLiveBytes;
+}
+
+AllocScope::~AllocScope() {
+    AllocCounters end = AllocStats::threadTotals();
+    uint64_t peak = tPeakLiveBytes > start.liveBytes ? tPeakLiveBytes - start.liveBytes : 0;
+    tPeakLiveBytes = std::max(outerPeak, tPeakLiveBytes);
+
+    tSuspended = true;
+    {
+        std::lock_guard<std::mutex> lock(tableMutex());
+        ScopeTotals &totals = table()[name];
+        ++totals.calls;
+        totals.allocations += end.allocations - start.allocations;
+        totals.deallocations += end.deallocations - start.deallocations;
+        totals.bytes += end.bytes - start.bytes;
+        totals.peakLiveBytes = std::max(totals.peakLiveBytes, peak);
+    }
+    tSuspended = false;
+}
+
+AllocCounters AllocStats::threadTotals() {
+    AllocCounters counters;
+    counters.allocations = tAllocations;
+    counters.deallocations = tDeallocations;
+    counters.bytes = tBytes;
+    counters.liveBytes = tLiveBytes;
+    return counters;
+}
+
+nlohmann::json AllocStats::snapshot() {
+    std::map<std::string, ScopeTotals> copy;
+    tSuspended = true;
+    {
+        std::lock_guard<std::mutex> lock(tableMutex());
+        copy = table();
+    }
+    tSuspended = false;
+
+    nlohmann::json result;
+    result["enabled"] = true;
+    nlohmann::json scopes = nlohmann::json::object();
+    for (const auto &[scopeName, totals] : copy) {
+        scopes[scopeName] = {
+            {"calls", totals.calls},
+            {"allocations", totals.allocations},
+            {"deallocations", totals.deallocations},
+            {"bytes", totals.bytes},
+            {"peakLiveBytes", totals.peakLiveBytes}};
+    }
+    result["scopes"] = std::move(scopes);
+    return result;
+}
+
+void AllocStats::reset() {
+    tSuspended = true;
+    {
+        std::lock_guard<std::mutex> lock(tableMutex());
+        table().clear();
+    }
+    tSuspended = false;
+}
+
+#else
+
+AllocCounters AllocStats::threadTotals() { return AllocCounters(); }
+
+nlohmann::json AllocStats::snapshot() { return {{"enabled", false}}; }
+
+void AllocStats::reset() {}
+
+#endif // PJSON_ALLOC_STATS
+
+} // namespace pjson
+
+#ifdef PJSON_ALLOC_STATS
+
+void *operator new(std::size_t size) {
+    if (void *p = pjson::countedAlloc(size ? size : 1)) {
+        return p;
+    }
+#if defined(__cpp_exceptions)
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return pjson::countedAlloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return pjson::countedAlloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept { pjson::countedFree(p); }
+void operator delete[](void *p) noexcept { pjson::countedFree(p); }
+void operator delete(void *p, std::size_t) noexcept { pjson::countedFree(p); }
+void operator delete[](void *p, std::size_t) noexcept { pjson::countedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { pjson::countedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { pjson::countedFree(p); }
+
+#endif // PJSON_ALLOC_STATS
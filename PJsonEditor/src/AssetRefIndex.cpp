@@ -0,0 +1,236 @@
+#include "pjson_editor/AssetRefIndex.h"
+#include <algorithm>
+#include <utility>
+
+namespace pjson {
+
+std::vector<std::string> sceneAssetUuids(const ExtendedProjectScene &scene) {
+    std::vector<std::string> uuids;
+    uuids.reserve(scene.aRolls.size() + scene.bRolls.size() + scene.voiceOvers.size());
+    auto add = [&uuids](const auto &items) {
+        for (const auto &item : items) {
+            if (!item.assetUuid.empty()) {
+                uuids.push_back(item.assetUuid);
+            }
+        }
+    };
+    add(scene.aRolls);
+    add(scene.bRolls);
+    add(scene.voiceOvers);
+    std::sort(uuids.begin(), uuids.end());
+    uuids.erase(std::unique(uuids.begin(), uuids.end()), uuids.end());
+    return uuids;
+}
+
+void AssetRefIndex::build(const ExtendedProjectAndScenesVo &project) {
+    clear();
+    SceneChangeSet everything;
+    update(project, everything);
+    for (const auto &bgm : project.bgms) {
+        addProjectUse(bgm.assetUuid);
+    }
+    for (const auto &timeline : project.timelines) {
+        addProjectUse(timeline.assetUuid);
+    }
+}
+
+void AssetRefIndex::clear() {
+    sceneUses.clear();
+    scenesByAsset.clear();
+    assetsByScene.clear();
+    projectUses.clear();
+    useCounts.clear();
+    scenePositions.clear();
+}
+
+void AssetRefIndex::update(const ExtendedProjectAndScenesVo &project, const SceneChangeSet &changes) {
+    const auto &scenes = project.scenes;
+    if (!changes.all && !changes.sceneList) {
+        for (size_t index : changes.sceneIndices) {
+            if (index < scenes.size()) {
+                readScene(scenes[index]);
+            }
+        }
+        return;
+    }
+
+    scenePositions.clear();
+    scenePositions.reserve(scenes.size());
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        scenePositions.emplace(scenes[i].uuid, i);
+    }
+    std::vector<std::string> gone;
+    for (const auto &entry : sceneUses) {
+        if (changes.all || scenePositions.count(entry.first) == 0) {
+            gone.push_back(entry.first);
+        }
+    }
+    for (const auto &uuid : gone) {
+        forgetScene(uuid);
+    }
+    for (const auto &scene : scenes) {
+        if (sceneUses.count(scene.uuid) == 0) {
+            readScene(scene);
+        }
+    }
+    if (!changes.all) {
+        for (const auto &uuid : changes.sceneUuids) {
+            auto it = scenePositions.find(uuid);
+            if (it != scenePositions.end()) {
+                readScene(scenes[it->second]);
+            }
+        }
+    }
+}
+
+void AssetRefIndex::readScene(const ExtendedProjectScene &scene) {
+    forgetScene(scene.uuid);
+    std::vector<SceneUse> uses;
+    auto add = [&uses](const auto &items, AssetRefKind kind) {
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (!items[i].assetUuid.empty()) {
+                uses.push_back({items[i].assetUuid, {kind, 0, i}});
+            }
+        }
+    };
+    add(scene.aRolls, AssetRefKind::A_ROLL);
+    add(scene.bRolls, AssetRefKind::B_ROLL);
+    add(scene.voiceOvers, AssetRefKind::VOICE_OVER);
+    std::vector<std::string> assets = sceneAssetUuids(scene);
+    for (const std::string &assetUuid : assets) {
+        scenesByAsset[assetUuid].push_back(scene.uuid);
+    }
+    for (const auto &use : uses) {
+        count(use.first, 1);
+    }
+    sceneUses[scene.uuid] = std::move(uses);
+    assetsByScene[scene.uuid] = std::move(assets);
+}
+
+void AssetRefIndex::forgetScene(const std::string &sceneUuid) {
+    auto it = sceneUses.find(sceneUuid);
+    if (it == sceneUses.end()) {
+        return;
+    }
+    for (const auto &use : it->second) {
+        count(use.first, -1);
+        auto scenesIt = scenesByAsset.find(use.first);
+        if (scenesIt == scenesByAsset.end()) {
+            continue;  // an asset used twice in the scene is unlinked once
+        }
+        auto &users = scenesIt->second;
+        users.erase(std::remove(users.begin(), users.end(), sceneUuid), users.end());
+        if (users.empty()) {
+            scenesByAsset.erase(scenesIt);
+        }
+    }
+    sceneUses.erase(it);
+    assetsByScene.erase(sceneUuid);
+}
+
+void AssetRefIndex::count(const std::string &assetUuid, int delta) {
+    if (delta > 0) {
+        ++useCounts[assetUuid];
+        return;
+    }
+    auto it = useCounts.find(assetUuid);
+    if (it != useCounts.end() && --it->second == 0) {
+        useCounts.erase(it);
+    }
+}
+
+void AssetRefIndex::addProjectUse(const std::string &assetUuid) {
+    if (!assetUuid.empty()) {
+        ++projectUses[assetUuid];
+        count(assetUuid, 1);
+    }
+}
+
+void AssetRefIndex::removeProjectUse(const std::string &assetUuid) {
+    auto it = projectUses.find(assetUuid);
+    if (it == projectUses.end()) {
+        return;
+    }
+    if (--it->second == 0) {
+        projectUses.erase(it);
+    }
+    count(assetUuid, -1);
+}
+
+std::vector<AssetRef> AssetRefIndex::refs(const ExtendedProjectAndScenesVo &project,
+                                          const std::string &assetUuid) const {
+    std::vector<AssetRef> result;
+    auto scenesIt = scenesByAsset.find(assetUuid);
+    if (scenesIt != scenesByAsset.end()) {
+        std::vector<std::pair<size_t, const std::vector<SceneUse> *>> users;
+        users.reserve(scenesIt->second.size());
+        for (const auto &sceneUuid : scenesIt->second) {
+            users.emplace_back(scenePositions.at(sceneUuid), &sceneUses.at(sceneUuid));
+        }
+        std::sort(users.begin(), users.end());
+        for (const auto &user : users) {
+            for (const auto &use : *user.second) {
+                if (use.first == assetUuid) {
+                    result.push_back({use.second.kind, user.first, use.second.index});
+                }
+            }
+        }
+    }
+    if (projectUses.count(assetUuid) != 0) {
+        for (size_t i = 0; i < project.bgms.size(); ++i) {
+            if (project.bgms[i].assetUuid == assetUuid) {
+                result.push_back({AssetRefKind::BGM, 0, i});
+            }
+        }
+        for (size_t i = 0; i < project.timelines.size(); ++i) {
+            if (project.timelines[i].assetUuid == assetUuid) {
+                result.push_back({AssetRefKind::PROJECT_TIMELINE, 0, i});
+            }
+        }
+    }
+    return result;
+}
+
+const std::vector<std::string> &AssetRefIndex::sceneAssets(const std::string &sceneUuid) const {
+    static const std::vector<std::string> none;
+    auto it = assetsByScene.find(sceneUuid);
+    return it == assetsByScene.end() ? none : it->second;
+}
+
+void AssetRefIndex::retarget(const std::string &from, const std::string &to) {
+    if (from == to) {
+        return;
+    }
+    auto scenesIt = scenesByAsset.find(from);
+    if (scenesIt != scenesByAsset.end()) {
+        std::vector<std::string> moved = std::move(scenesIt->second);
+        scenesByAsset.erase(scenesIt);
+        auto &target = scenesByAsset[to];
+        for (const auto &sceneUuid : moved) {
+            for (auto &use : sceneUses[sceneUuid]) {
+                if (use.first == from) {
+                    use.first = to;
+                }
+            }
+            if (std::find(target.begin(), target.end(), sceneUuid) == target.end()) {
+                target.push_back(sceneUuid);
+            }
+            auto &assets = assetsByScene[sceneUuid];
+            std::replace(assets.begin(), assets.end(), from, to);
+            std::sort(assets.begin(), assets.end());
+            assets.erase(std::unique(assets.begin(), assets.end()), assets.end());
+        }
+    }
+    auto moveCount = [&from, &to](std::unordered_map<std::string, size_t> &counts) {
+        auto it = counts.find(from);
+        if (it != counts.end()) {
+            const size_t n = it->second;
+            counts.erase(it);
+            counts[to] += n;
+        }
+    };
+    moveCount(projectUses);
+    moveCount(useCounts);
+}
+
+} // namespace pjson
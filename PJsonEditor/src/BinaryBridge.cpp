@@ -0,0 +1,72 @@
+#include "pjson_editor/BinaryBridge.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace pjson {
+
+uint8_t *BinaryBridge::requestBuffer(size_t size) {
+    if (request.size() < size) {
+        request.resize(size);
+    }
+    return request.data();
+}
+
+size_t BinaryBridge::call(size_t size) {
+    size = std::min(size, request.size());
+    nlohmann::json out = dispatch(nlohmann::json::from_msgpack(
+        request.begin(), request.begin() + static_cast<std::ptrdiff_t>(size), true, false));
+    response.clear();
+    nlohmann::json::to_msgpack(out, response);
+    return response.size();
+}
+
+size_t BinaryBridge::callJson(size_t size) {
+    size = std::min(size, request.size());
+    nlohmann::json out = dispatch(nlohmann::json::parse(
+        request.begin(), request.begin() + static_cast<std::ptrdiff_t>(size), nullptr, false));
+    const std::string text = out.dump();
+    response.assign(text.begin(), text.end());
+    return response.size();
+}
+
+nlohmann::json BinaryBridge::dispatch(nlohmann::json message) {
+    nlohmann::json out;
+    if (message.is_discarded() || !message.is_object() ||
+        !message.contains("method") || !message["method"].is_string() ||
+        !message.contains("url") || !message["url"].is_string()) {
+        out["status"] = 400;
+        out["headers"] = nlohmann::json::object();
+        out["body"] = {{"code", -1}, {"msg", "Invalid request: expected {method, url, body}"}};
+        out["patch"] = nlohmann::json::array();
+        return out;
+    }
+
+    Request req;
+    req.method = message["method"].get<std::string>();
+    req.url = message["url"].get<std::string>();
+    if (message.contains("body")) {
+        req.body = std::move(message["body"]);
+    }
+    if (message.contains("headers") && message["headers"].is_object()) {
+        for (const auto &[key, value] : message["headers"].items()) {
+            if (value.is_string()) {
+                req.headers[key] = value.get<std::string>();
+            }
+        }
+    }
+
+    const uint64_t cursor = editor.changesSince(UINT64_MAX, 0)["cursor"].get<uint64_t>();
+    Response resp = editor.call(std::move(req));
+    nlohmann::json changes = editor.changesSince(cursor)["changes"];
+
+    out["status"] = resp.status_code;
+    out["headers"] = std::move(resp.headers);
+    out["body"] = std::move(resp.body);
+    out["patch"] = changes.empty() ? nlohmann::json::array()
+                                   : std::move(changes[0]["patch"]);
+    return out;
+}
+
+} // namespace pjson
@@ -0,0 +1,58 @@
+#include "pjson_editor/ChangeFeed.h"
+#include <algorithm>
+#include <utility>
+
+namespace pjson {
+
+ChangeFeed::ChangeFeed(size_t capacity) : limit(std::max<size_t>(capacity, 1)) {}
+
+uint64_t ChangeFeed::append(int version, nlohmann::json patch) {
+    ChangeRecord record;
+    record.sequence = nextSequence++;
+    record.version = version;
+    record.patch = std::make_shared<const nlohmann::json>(std::move(patch));
+    records.push_back(std::move(record));
+    trim();
+    return records.back().sequence;
+}
+
+void ChangeFeed::clear() {
+    records.clear();
+}
+
+void ChangeFeed::setCapacity(size_t capacity) {
+    limit = std::max<size_t>(capacity, 1);
+    trim();
+}
+
+void ChangeFeed::trim() {
+    while (records.size() > limit) {
+        records.pop_front();
+    }
+}
+
+ChangeFeed::ReadResult ChangeFeed::read(uint64_t cursor, size_t maxRecords) const {
+    ReadResult result;
+    result.cursor = std::min(cursor, lastSequence());
+
+    // Sequences in the log are contiguous, so the first record after the
+    // cursor is found by offset.
+    const uint64_t firstKept = records.empty() ? nextSequence : records.front().sequence;
+    if (result.cursor + 1 < firstKept) {
+        result.snapshotRequired = true;
+        result.cursor = lastSequence();
+        return result;
+    }
+    if (records.empty()) {
+        return result;
+    }
+    const size_t begin = static_cast<size_t>(result.cursor + 1 - firstKept);
+    const size_t count = std::min(records.size() - begin, maxRecords);
+    result.records.assign(records.begin() + begin, records.begin() + begin + count);
+    if (count > 0) {
+        result.cursor = result.records.back().sequence;
+    }
+    return result;
+}
+
+} // namespace pjson
@@ -1,18 +1,23 @@
 #include "pjson_editor/ExtendedAPI.h"
+#include "pjson_editor/AllocStats.h"
+#include "pjson_editor/JsonReader.h"
+#include "pjson_editor/LayerPartitioner.h"
+#include "pjson_editor/SceneCutUtils.h"
+#include "pjson_editor/ScenePermutation.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
-#include <iostream>
 #include <sstream>
 
 namespace pjson {
 
-// UUID generation utility
-std::string genUuid() {
-    static int counter = 0;
-    return "uuid-" + std::to_string(++counter);
-}
-
 pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::json &scene_list_resp) {
     // /v3/project/{projectUuid}/scene/list response parsing
     // initialize from JSON response
@@ -21,17 +26,18 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
         
         // Extract basic project information
         if (data.contains("projectUuid")) {
-            projectUuid = data["projectUuid"].get<std::string>();
+            readValue(data["projectUuid"], projectUuid);
             project.uuid = projectUuid;
         }
         
         if (data.contains("ownerUuid")) {
-            ownerUuid = data["ownerUuid"].get<std::string>();
+            readValue(data["ownerUuid"], ownerUuid);
         }
         
         // Parse status
         if (data.contains("status")) {
-            std::string statusStr = data["status"].get<std::string>();
+            std::string statusStr;
+            readValue(data["status"], statusStr);
             if (statusStr == "active") {
                 status = StatusEnum::ACTIVE;
             } else if (statusStr == "deleted") {
@@ -49,30 +55,31 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                 
                 // Basic scene properties
                 if (sceneJson.contains("sceneUuid")) {
-                    scene.uuid = sceneJson["sceneUuid"].get<std::string>();
+                    readValue(sceneJson["sceneUuid"], scene.uuid);
                 }
                 if (sceneJson.contains("projectUuid")) {
-                    scene.projectUuid = sceneJson["projectUuid"].get<std::string>();
+                    readValue(sceneJson["projectUuid"], scene.projectUuid);
                 }
                 if (sceneJson.contains("name")) {
-                    scene.name = sceneJson["name"].get<std::string>();
+                    readValue(sceneJson["name"], scene.name);
                 }
                 if (sceneJson.contains("duration")) {
-                    scene.duration = sceneJson["duration"].get<int>();
+                    readValue(sceneJson["duration"], scene.duration);
                 }
                 if (sceneJson.contains("timeOffsetInProject")) {
-                    scene.timeOffsetInProject = sceneJson["timeOffsetInProject"].get<int>();
+                    readValue(sceneJson["timeOffsetInProject"], scene.timeOffsetInProject);
                 }
                 if (sceneJson.contains("pauseTime")) {
-                    scene.pauseTime = sceneJson["pauseTime"].get<int>();
+                    readValue(sceneJson["pauseTime"], scene.pauseTime);
                 }
                 if (sceneJson.contains("audioFlag")) {
-                    scene.audioFlag = sceneJson["audioFlag"].get<int>();
+                    readValue(sceneJson["audioFlag"], scene.audioFlag);
                 }
                 
                 // Parse scene type
                 if (sceneJson.contains("sceneType")) {
-                    std::string sceneTypeStr = sceneJson["sceneType"].get<std::string>();
+                    std::string sceneTypeStr;
+                    readValue(sceneJson["sceneType"], sceneTypeStr);
                     if (sceneTypeStr == "intro") {
                         scene.sceneType = SceneTypeEnum::INTRO;
                     } else if (sceneTypeStr == "outro") {
@@ -90,28 +97,36 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                     for (const auto& timelineJson : sceneJson["arolls"]) {
                         ExtendedTimeline timeline;
                         if (timelineJson.contains("timelineUuid")) {
-                            timeline.uuid = timelineJson["timelineUuid"].get<std::string>();
+                            readValue(timelineJson["timelineUuid"], timeline.uuid);
                         }
                         if (timelineJson.contains("sceneUuid")) {
-                            timeline.sceneUuid = timelineJson["sceneUuid"].get<std::string>();
+                            readValue(timelineJson["sceneUuid"], timeline.sceneUuid);
                         }
                         if (timelineJson.contains("assetUuid")) {
-                            timeline.assetUuid = timelineJson["assetUuid"].get<std::string>();
+                            readValue(timelineJson["assetUuid"], timeline.assetUuid);
                         }
                         if (timelineJson.contains("timeOffsetInProject")) {
-                            timeline.timeOffsetInProject = timelineJson["timeOffsetInProject"].get<int>();
+                            readValue(timelineJson["timeOffsetInProject"], timeline.timeOffsetInProject);
                         }
                         if (timelineJson.contains("startTime")) {
-                            timeline.startTime = timelineJson["startTime"].get<int>();
+                            readValue(timelineJson["startTime"], timeline.startTime);
                         }
                         if (timelineJson.contains("endTime")) {
-                            timeline.endTime = timelineJson["endTime"].get<int>();
+                            readValue(timelineJson["endTime"], timeline.endTime);
                         }
                         if (timelineJson.contains("timelineDuration")) {
-                            timeline.duration = timelineJson["timelineDuration"].get<int>();
+                            readValue(timelineJson["timelineDuration"], timeline.duration);
                         }
                         if (timelineJson.contains("volume")) {
-                            timeline.volume = timelineJson["volume"].get<double>();
+                            readValue(timelineJson["volume"], timeline.volume);
+                        }
+                        if (timelineJson.contains("speed")) {
+                            readValue(timelineJson["speed"], timeline.speed);
+                        }
+                        if (timelineJson.contains("timeOffsetInScene")) {
+                            readValue(timelineJson["timeOffsetInScene"], timeline.timeOffsetInScene);
+                        } else {
+                            timeline.timeOffsetInScene = timeline.timeOffsetInProject - scene.timeOffsetInProject;
                         }
                         if (timelineJson.contains("category")) {
                             // Parse category enum - would need proper mapping
@@ -129,28 +144,36 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                     for (const auto& timelineJson : sceneJson["brolls"]) {
                         ExtendedTimeline timeline;
                         if (timelineJson.contains("timelineUuid")) {
-                            timeline.uuid = timelineJson["timelineUuid"].get<std::string>();
+                            readValue(timelineJson["timelineUuid"], timeline.uuid);
                         }
                         if (timelineJson.contains("sceneUuid")) {
-                            timeline.sceneUuid = timelineJson["sceneUuid"].get<std::string>();
+                            readValue(timelineJson["sceneUuid"], timeline.sceneUuid);
                         }
                         if (timelineJson.contains("assetUuid")) {
-                            timeline.assetUuid = timelineJson["assetUuid"].get<std::string>();
+                            readValue(timelineJson["assetUuid"], timeline.assetUuid);
                         }
                         if (timelineJson.contains("timeOffsetInProject")) {
-                            timeline.timeOffsetInProject = timelineJson["timeOffsetInProject"].get<int>();
+                            readValue(timelineJson["timeOffsetInProject"], timeline.timeOffsetInProject);
                         }
                         if (timelineJson.contains("startTime")) {
-                            timeline.startTime = timelineJson["startTime"].get<int>();
+                            readValue(timelineJson["startTime"], timeline.startTime);
                         }
                         if (timelineJson.contains("endTime")) {
-                            timeline.endTime = timelineJson["endTime"].get<int>();
+                            readValue(timelineJson["endTime"], timeline.endTime);
                         }
                         if (timelineJson.contains("timelineDuration")) {
-                            timeline.duration = timelineJson["timelineDuration"].get<int>();
+                            readValue(timelineJson["timelineDuration"], timeline.duration);
                         }
                         if (timelineJson.contains("volume")) {
-                            timeline.volume = timelineJson["volume"].get<double>();
+                            readValue(timelineJson["volume"], timeline.volume);
+                        }
+                        if (timelineJson.contains("speed")) {
+                            readValue(timelineJson["speed"], timeline.speed);
+                        }
+                        if (timelineJson.contains("timeOffsetInScene")) {
+                            readValue(timelineJson["timeOffsetInScene"], timeline.timeOffsetInScene);
+                        } else {
+                            timeline.timeOffsetInScene = timeline.timeOffsetInProject - scene.timeOffsetInProject;
                         }
                         timeline.category = ProjectTimelineCategoryEnum::FOOTAGE;
                         
@@ -165,31 +188,31 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                     for (const auto& voiceJson : sceneJson["voiceOvers"]) {
                         VoiceOver voiceOver;
                         if (voiceJson.contains("voiceUuid")) {
-                            voiceOver.uuid = voiceJson["voiceUuid"].get<std::string>();
+                            readValue(voiceJson["voiceUuid"], voiceOver.uuid);
                         }
                         if (voiceJson.contains("sceneUuid")) {
-                            voiceOver.sceneUuid = voiceJson["sceneUuid"].get<std::string>();
+                            readValue(voiceJson["sceneUuid"], voiceOver.sceneUuid);
                         }
                         if (voiceJson.contains("projectUuid")) {
-                            voiceOver.projectUuid = voiceJson["projectUuid"].get<std::string>();
+                            readValue(voiceJson["projectUuid"], voiceOver.projectUuid);
                         }
                         if (voiceJson.contains("assetUuid")) {
-                            voiceOver.assetUuid = voiceJson["assetUuid"].get<std::string>();
+                            readValue(voiceJson["assetUuid"], voiceOver.assetUuid);
                         }
                         if (voiceJson.contains("timeOffsetInProject")) {
-                            voiceOver.timeOffsetInProject = voiceJson["timeOffsetInProject"].get<int>();
+                            readValue(voiceJson["timeOffsetInProject"], voiceOver.timeOffsetInProject);
                         }
                         if (voiceJson.contains("startTime")) {
-                            voiceOver.startTime = voiceJson["startTime"].get<int>();
+                            readValue(voiceJson["startTime"], voiceOver.startTime);
                         }
                         if (voiceJson.contains("endTime")) {
-                            voiceOver.endTime = voiceJson["endTime"].get<int>();
+                            readValue(voiceJson["endTime"], voiceOver.endTime);
                         }
                         if (voiceJson.contains("timelineDuration")) {
-                            voiceOver.duration = voiceJson["timelineDuration"].get<int>();
+                            readValue(voiceJson["timelineDuration"], voiceOver.duration);
                         }
                         if (voiceJson.contains("volume")) {
-                            voiceOver.volume = voiceJson["volume"].get<double>();
+                            readValue(voiceJson["volume"], voiceOver.volume);
                         }
                         voiceOver.category = ProjectTimelineCategoryEnum::VOICE_OVER;
                         
@@ -206,13 +229,13 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                         for (const auto& itemJson : transcriptJson["items"]) {
                             TranscriptItem item;
                             if (itemJson.contains("text")) {
-                                item.text = itemJson["text"].get<std::string>();
+                                readValue(itemJson["text"], item.text);
                             }
                             if (itemJson.contains("startMs")) {
-                                item.startMs = itemJson["startMs"].get<int>();
+                                readValue(itemJson["startMs"], item.startMs);
                             }
                             if (itemJson.contains("endMs")) {
-                                item.endMs = itemJson["endMs"].get<int>();
+                                readValue(itemJson["endMs"], item.endMs);
                             }
                             transcript.items.push_back(item);
                         }
@@ -227,22 +250,37 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
                     }
                     
                     if (sceneJson.contains("transcriptModified")) {
-                        transcript.modified = sceneJson["transcriptModified"].get<bool>();
+                        readValue(sceneJson["transcriptModified"], transcript.modified);
                     }
                     
                     scene.transcript = transcript;
                 }
                 
+                // Parse layers
+                if (sceneJson.contains("layers") && sceneJson["layers"].is_array()) {
+                    scene.layers.clear();
+                    for (const auto& layerJson : sceneJson["layers"]) {
+                        BaseLayer layer;
+                        JsonReader layerIn(layerJson);
+                        layerIn.read("uuid", layer.uuid);
+                        layerIn.read("type", layer.type);
+                        layerIn.read("timeOffsetInScene", layer.timeOffsetInScene);
+                        layerIn.read("duration", layer.duration);
+                        layerIn.read("data", layer.data);
+                        scene.layers.push_back(std::move(layer));
+                    }
+                }
+                
                 // Parse transitions
                 if (sceneJson.contains("transitions") && sceneJson["transitions"].is_array()) {
                     scene.transitions.clear();
                     for (const auto& transitionJson : sceneJson["transitions"]) {
                         SceneTransition transition;
                         if (transitionJson.contains("type")) {
-                            transition.type = transitionJson["type"].get<std::string>();
+                            readValue(transitionJson["type"], transition.type);
                         }
                         if (transitionJson.contains("duration")) {
-                            transition.duration = transitionJson["duration"].get<int>();
+                            readValue(transitionJson["duration"], transition.duration);
                         }
                         scene.transitions.push_back(transition);
                     }
@@ -258,26 +296,26 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
             for (const auto& [assetId, assetJson] : data["assets"].items()) {
                 ProjectSceneAsset asset;
                 if (assetJson.contains("assetUuid")) {
-                    asset.uuid = assetJson["assetUuid"].get<std::string>();
-                    asset.assetId = assetJson["assetUuid"].get<std::string>();
+                    readValue(assetJson["assetUuid"], asset.uuid);
+                    readValue(assetJson["assetUuid"], asset.assetId);
                 }
                 if (assetJson.contains("assetLink")) {
-                    asset.assetLink = assetJson["assetLink"].get<std::string>();
+                    readValue(assetJson["assetLink"], asset.assetLink);
                 }
                 if (assetJson.contains("assetType")) {
-                    asset.assetType = assetJson["assetType"].get<std::string>();
+                    readValue(assetJson["assetType"], asset.assetType);
                 }
                 if (assetJson.contains("duration")) {
-                    asset.duration = assetJson["duration"].get<int>();
+                    readValue(assetJson["duration"], asset.duration);
                 }
                 if (assetJson.contains("width")) {
-                    asset.width = assetJson["width"].get<int>();
+                    readValue(assetJson["width"], asset.width);
                 }
                 if (assetJson.contains("height")) {
-                    asset.height = assetJson["height"].get<int>();
+                    readValue(assetJson["height"], asset.height);
                 }
                 if (assetJson.contains("audioLink")) {
-                    asset.audioLink = assetJson["audioLink"].get<std::string>();
+                    readValue(assetJson["audioLink"], asset.audioLink);
                 }
                 
                 assets[assetId] = asset;
@@ -290,22 +328,22 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
             for (const auto& bgmJson : data["bgms"]) {
                 ProjectBgm bgm;
                 if (bgmJson.contains("assetUuid")) {
-                    bgm.assetUuid = bgmJson["assetUuid"].get<std::string>();
+                    readValue(bgmJson["assetUuid"], bgm.assetUuid);
                 }
                 if (bgmJson.contains("assetLink")) {
-                    bgm.assetLink = bgmJson["assetLink"].get<std::string>();
+                    readValue(bgmJson["assetLink"], bgm.assetLink);
                 }
                 if (bgmJson.contains("timelineUuid")) {
-                    bgm.uuid = bgmJson["timelineUuid"].get<std::string>();
+                    readValue(bgmJson["timelineUuid"], bgm.uuid);
                 }
                 if (bgmJson.contains("duration")) {
-                    bgm.duration = bgmJson["duration"].get<int>();
+                    readValue(bgmJson["duration"], bgm.duration);
                 }
                 if (bgmJson.contains("volume")) {
-                    bgm.volume = bgmJson["volume"].get<double>();
+                    readValue(bgmJson["volume"], bgm.volume);
                 }
                 if (bgmJson.contains("adjustedBgmLink")) {
-                    bgm.adjustedBgmLink = bgmJson["adjustedBgmLink"].get<std::string>();
+                    readValue(bgmJson["adjustedBgmLink"], bgm.adjustedBgmLink);
                 }
                 
                 bgms.push_back(bgm);
@@ -318,16 +356,16 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
             for (const auto& [voiceId, voiceJson] : data["syntheticVoices"].items()) {
                 SyntheticVoiceMetadata voice;
                 if (voiceJson.contains("uuid")) {
-                    voice.voiceId = voiceJson["uuid"].get<std::string>();
+                    readValue(voiceJson["uuid"], voice.voiceId);
                 }
                 if (voiceJson.contains("voiceName")) {
-                    voice.voiceName = voiceJson["voiceName"].get<std::string>();
+                    readValue(voiceJson["voiceName"], voice.voiceName);
                 }
                 if (voiceJson.contains("locale")) {
-                    voice.language = voiceJson["locale"].get<std::string>();
+                    readValue(voiceJson["locale"], voice.language);
                 }
                 if (voiceJson.contains("gender")) {
-                    voice.gender = voiceJson["gender"].get<std::string>();
+                    readValue(voiceJson["gender"], voice.gender);
                 }
                 // Store additional parameters as JSON
                 nlohmann::json additionalParams;
@@ -356,10 +394,11 @@ pjson::ExtendedProjectAndScenesVo::ExtendedProjectAndScenesVo(const nlohmann::js
     }
 }
 
-pjson::ExtendedProjectAndScenesVo EMPTY_PROJECT;
+ExtendedProjectAndScenesVo EMPTY_PROJECT;
 
 // /v3/project/{projectUuid}/scene/add 
 ApiResult ExtendedControllerAPI::addScene(const ExtendedProjectSceneAddReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addScene");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -367,7 +406,7 @@ ApiResult ExtendedControllerAPI::addScene(const ExtendedProjectSceneAddReqBody&
     nlohmann::json patches = nlohmann::json::array();
     
     // Step 1: Get project scenes
-    auto& scenes = dataStore->getProject().scenes;
+    auto& scenes = dataStore->editSceneList();
     
     // Step 2: Validate insertion position and intro/outro restrictions
     int addPosition = reqBody.addPosition;
@@ -401,34 +440,21 @@ ApiResult ExtendedControllerAPI::addScene(const ExtendedProjectSceneAddReqBody&
         timeOffsetInProject = scenes[addPosition].timeOffsetInProject;
         
         // Step 4: Update timeOffsets for all subsequent scenes and their timelines
+        dataStore->shiftScenes(addPosition, duration);
         for (size_t i = addPosition; i < scenes.size(); ++i) {
-            auto& scene = scenes[i];
-            scene.timeOffsetInProject += duration;
-            
-            // Update timelines within the affected scene
-            for (auto& timeline : scene.aRolls) {
-                timeline.timeOffsetInProject += duration;
-            }
-            for (auto& timeline : scene.bRolls) {
-                timeline.timeOffsetInProject += duration;
-            }
-            for (auto& voiceOver : scene.voiceOvers) {
-                voiceOver.timeOffsetInProject += duration;
-            }
-            
             // Generate patches for affected scenes
             patches.push_back({
                 {"op", "replace"},
                 {"path", "/scenes/" + std::to_string(i + 1) + "/timeOffsetInProject"}, // +1 because we'll insert new scene
-                {"value", scene.timeOffsetInProject}
+                {"value", scenes[i].timeOffsetInProject}
             });
         }
     }
     
     // Step 5: Create new scene (following Java backend structure)
     ExtendedProjectScene newScene;
-    newScene.uuid = genUuid();
-    newScene.projectUuid = dataStore->getProject().projectUuid;
+    newScene.uuid = newUuid();
+    newScene.projectUuid = dataStore->getCurrentProjectData().projectUuid;
     
     // Use name from reqBody if provided, otherwise default
     std::string sceneName = "New scene";
@@ -483,6 +509,7 @@ ApiResult ExtendedControllerAPI::addScene(const ExtendedProjectSceneAddReqBody&
 }
 
 ApiResult ExtendedControllerAPI::renameScene(const ExtendedProjectSceneRenameReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("renameScene");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -516,12 +543,13 @@ ApiResult ExtendedControllerAPI::renameScene(const ExtendedProjectSceneRenameReq
 }
 
 ApiResult ExtendedControllerAPI::moveScene(const ExtendedProjectSceneMoveReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("moveScene");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
     nlohmann::json patches = nlohmann::json::array();
-    auto& scenes = dataStore->getProject().scenes;
+    auto& scenes = dataStore->editSceneList();
     
     // Step 1: Validate project has scenes
     if (scenes.empty()) {
@@ -545,15 +573,15 @@ ApiResult ExtendedControllerAPI::moveScene(const ExtendedProjectSceneMoveReqBody
         return ApiResult::error(ApiMessage::ACTION_DENIED);
     }
     
-    // Step 4: Determine insertion position and time offset
-    int insertTimeOffset = 0;
+    // Step 4: Determine the scene's new index
+    const size_t currIndex = static_cast<size_t>(std::distance(scenes.begin(), currSceneIt));
+    size_t newIndex = 0;
     
     if (!reqBody.afterSceneUuid.has_value() || reqBody.afterSceneUuid.value().empty()) {
         // Move to beginning (after intro if exists)
         if (!scenes.empty() && scenes[0].sceneType == SceneTypeEnum::INTRO) {
             return ApiResult::error(ApiMessage::ACTION_DENIED);
         }
-        insertTimeOffset = 0;
     } else {
         // Move after specified scene
         auto afterSceneIt = std::find_if(scenes.begin(), scenes.end(), 
@@ -565,102 +593,69 @@ ApiResult ExtendedControllerAPI::moveScene(const ExtendedProjectSceneMoveReqBody
             return ApiResult::error(ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND);
         }
         
-        ExtendedProjectScene& afterScene = *afterSceneIt;
-        
-        // Check outro restrictions
-        if (currScene.sceneType == SceneTypeEnum::OUTRO) {
-            return ApiResult::error(ApiMessage::ACTION_DENIED);
-        }
-        
-        // Calculate insertion time offset
-        if (afterScene.timeOffsetInProject == currScene.timeOffsetInProject) {
-            // No change needed, return current scene count
-            nlohmann::json resultData = static_cast<int>(scenes.size());
-            return ApiResult::success(patches, resultData);
-        } else if (afterScene.timeOffsetInProject < currScene.timeOffsetInProject) {
-            // Moving backward
-            insertTimeOffset = afterScene.timeOffsetInProject + afterScene.duration;
-        } else {
-            // Moving forward
-            insertTimeOffset = afterScene.timeOffsetInProject + afterScene.duration - currScene.duration;
-        }
+        const size_t afterIndex = static_cast<size_t>(std::distance(scenes.begin(), afterSceneIt));
+        // Once the scene is taken out, everything behind it moves up by one
+        newIndex = afterIndex < currIndex ? afterIndex + 1 : afterIndex;
     }
     
     // Step 5: Check if position unchanged
-    if (insertTimeOffset == currScene.timeOffsetInProject) {
+    if (newIndex == currIndex) {
         // No change needed, return current scene count
         nlohmann::json resultData = static_cast<int>(scenes.size());
         return ApiResult::success(patches, resultData);
     }
     
-    // Step 6: Calculate affected scenes and update their time offsets
-    int timeOffsetChange;
-    
-    if (insertTimeOffset < currScene.timeOffsetInProject) {
+    // Step 6: Shift the scenes in [first, last] while they are still in place.
+    // Only this range changes; the scenes around it keep their offsets.
+    const size_t first = std::min(currIndex, newIndex);
+    const size_t last = std::max(currIndex, newIndex);
+    const int rangeStart = scenes[first].timeOffsetInProject;
+    const int movedDuration = currScene.duration;
+    int movedDelta;
+    if (newIndex < currIndex) {
         // Moving backward - scenes between new position and old position move forward
-        timeOffsetChange = currScene.duration;
-        
-        for (auto& scene : scenes) {
-            if (scene.uuid != currScene.uuid && 
-                scene.timeOffsetInProject >= insertTimeOffset && 
-                scene.timeOffsetInProject < currScene.timeOffsetInProject) {
-                
-                scene.timeOffsetInProject += timeOffsetChange;
-                
-                // Update timelines within affected scene
-                for (auto& timeline : scene.aRolls) {
-                    timeline.timeOffsetInProject += timeOffsetChange;
-                }
-                for (auto& timeline : scene.bRolls) {
-                    timeline.timeOffsetInProject += timeOffsetChange;
-                }
-                for (auto& voiceOver : scene.voiceOvers) {
-                    voiceOver.timeOffsetInProject += timeOffsetChange;
-                }
-            }
-        }
+        movedDelta = rangeStart - currScene.timeOffsetInProject;
+        dataStore->shiftSceneRange(first, currIndex, movedDuration);
     } else {
         // Moving forward - scenes between old position and new position move backward
-        timeOffsetChange = -currScene.duration;
-        
-        for (auto& scene : scenes) {
-            if (scene.uuid != currScene.uuid && 
-                scene.timeOffsetInProject > currScene.timeOffsetInProject && 
-                scene.timeOffsetInProject <= insertTimeOffset + currScene.duration) {
-                
-                scene.timeOffsetInProject += timeOffsetChange;
-                
-                // Update timelines within affected scene
-                for (auto& timeline : scene.aRolls) {
-                    timeline.timeOffsetInProject += timeOffsetChange;
-                }
-                for (auto& timeline : scene.bRolls) {
-                    timeline.timeOffsetInProject += timeOffsetChange;
-                }
-                for (auto& voiceOver : scene.voiceOvers) {
-                    voiceOver.timeOffsetInProject += timeOffsetChange;
-                }
+        movedDelta = scenes[last].timeOffsetInProject + scenes[last].duration
+                     - movedDuration - currScene.timeOffsetInProject;
+        dataStore->shiftSceneRange(currIndex + 1, last + 1, -movedDuration);
+    }
+    dataStore->shiftSceneRange(currIndex, currIndex + 1, movedDelta);
+    
+    // Project-level timelines follow the scenes they belong to
+    auto& projectTimelines = dataStore->projectTimelines();
+    if (!projectTimelines.empty()) {
+        std::unordered_map<std::string_view, int> deltaByScene;
+        deltaByScene.reserve(last - first + 1);
+        for (size_t i = first; i <= last; ++i) {
+            deltaByScene[scenes[i].uuid] = i == currIndex
+                ? movedDelta
+                : (newIndex < currIndex ? movedDuration : -movedDuration);
+        }
+        for (auto& timeline : projectTimelines) {
+            auto it = deltaByScene.find(timeline.sceneUuid);
+            if (it != deltaByScene.end()) {
+                timeline.timeOffsetInProject += it->second;
             }
         }
     }
     
-    // Step 7: Update current scene time offset and its timelines
-    int sceneOffsetChange = insertTimeOffset - currScene.timeOffsetInProject;
-    currScene.timeOffsetInProject = insertTimeOffset;
-    
-    // Update timelines within current scene
-    for (auto& timeline : currScene.aRolls) {
-        timeline.timeOffsetInProject += sceneOffsetChange;
-    }
-    for (auto& timeline : currScene.bRolls) {
-        timeline.timeOffsetInProject += sceneOffsetChange;
-    }
-    for (auto& voiceOver : currScene.voiceOvers) {
-        voiceOver.timeOffsetInProject += sceneOffsetChange;
+    // Step 7: Move the scene into place
+    if (newIndex < currIndex) {
+        std::rotate(scenes.begin() + first, scenes.begin() + currIndex, scenes.begin() + last + 1);
+    } else {
+        std::rotate(scenes.begin() + first, scenes.begin() + first + 1, scenes.begin() + last + 1);
     }
     
-    // Step 8: Generate patches for all affected scenes
-    for (size_t i = 0; i < scenes.size(); ++i) {
+    // Step 8: One move, then the offsets that changed
+    patches.push_back({
+        {"op", "move"},
+        {"from", "/scenes/" + std::to_string(currIndex)},
+        {"path", "/scenes/" + std::to_string(newIndex)}
+    });
+    for (size_t i = first; i <= last; ++i) {
         patches.push_back({
             {"op", "replace"},
             {"path", "/scenes/" + std::to_string(i) + "/timeOffsetInProject"},
@@ -668,40 +663,29 @@ ApiResult ExtendedControllerAPI::moveScene(const ExtendedProjectSceneMoveReqBody
         });
     }
     
-    // Step 9: Sort scenes by timeOffsetInProject to maintain proper order
-    std::sort(scenes.begin(), scenes.end(), 
-        [](const ExtendedProjectScene& a, const ExtendedProjectScene& b) {
-            return a.timeOffsetInProject < b.timeOffsetInProject;
-        });
-    
-    // Step 10: Recompute all offsets to ensure consistency
-    dataStore->recomputeOffsets();
-    
-    // Step 11: Create Integer return data for API compatibility (Java API returns Integer)
+    // Step 9: Create Integer return data for API compatibility (Java API returns Integer)
     nlohmann::json resultData = static_cast<int>(scenes.size()); // Return scene count as Integer
     
     return ApiResult::success(patches, resultData);
 }
 
 ApiResult ExtendedControllerAPI::setSceneTime(const ExtendedProjectSceneSetTimeReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setSceneTime");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
     nlohmann::json patches = nlohmann::json::array();
-    auto& scenes = dataStore->getProject().scenes;
+    const auto& scenes = dataStore->getCurrentProjectData().scenes;
     
     // Step 1: Find and validate the target scene
-    auto sceneIt = std::find_if(scenes.begin(), scenes.end(), 
-        [&reqBody](const ExtendedProjectScene& scene) {
-            return scene.uuid == reqBody.sceneUuid;
-        });
-    
-    if (sceneIt == scenes.end()) {
+    size_t sceneIndex = 0;
+    ExtendedProjectScene* scene = dataStore->findScene(reqBody.sceneUuid, sceneIndex);
+    if (!scene) {
         return ApiResult::error(ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND);
     }
     
-    ExtendedProjectScene& targetScene = *sceneIt;
+    ExtendedProjectScene& targetScene = *scene;
     int oldDuration = targetScene.duration;
     int newDuration = reqBody.newDuration;
     int timeChange = newDuration - oldDuration;
@@ -723,7 +707,7 @@ ApiResult ExtendedControllerAPI::setSceneTime(const ExtendedProjectSceneSetTimeR
         
         patches.push_back({
             {"op", "replace"},
-            {"path", "/scenes/" + std::to_string(std::distance(scenes.begin(), sceneIt)) + "/pauseTime"},
+            {"path", "/scenes/" + std::to_string(sceneIndex) + "/pauseTime"},
             {"value", targetScene.pauseTime.value()}
         });
         
@@ -758,33 +742,17 @@ ApiResult ExtendedControllerAPI::setSceneTime(const ExtendedProjectSceneSetTimeR
     }
     
     // Step 7: Update time offsets for all subsequent scenes and their timelines
-    for (size_t i = std::distance(scenes.begin(), sceneIt) + 1; i < scenes.size(); ++i) {
-        auto& scene = scenes[i];
-        
-        // Update scene time offset
-        scene.timeOffsetInProject += timeChange;
-        
-        // Update all timeline offsets within the affected scene
-        for (auto& timeline : scene.aRolls) {
-            timeline.timeOffsetInProject += timeChange;
-        }
-        for (auto& timeline : scene.bRolls) {
-            timeline.timeOffsetInProject += timeChange;
-        }
-        for (auto& voiceOver : scene.voiceOvers) {
-            voiceOver.timeOffsetInProject += timeChange;
-        }
-        
+    dataStore->shiftScenes(sceneIndex + 1, timeChange);
+    for (size_t i = sceneIndex + 1; i < scenes.size(); ++i) {
         // Generate patches for affected scenes
         patches.push_back({
             {"op", "replace"},
             {"path", "/scenes/" + std::to_string(i) + "/timeOffsetInProject"},
-            {"value", scene.timeOffsetInProject}
+            {"value", scenes[i].timeOffsetInProject}
         });
     }
     
     // Step 8: Generate patch for the updated scene
-    size_t sceneIndex = std::distance(scenes.begin(), sceneIt);
     patches.push_back({
         {"op", "replace"},
         {"path", "/scenes/" + std::to_string(sceneIndex) + "/duration"},
@@ -810,18 +778,202 @@ ApiResult ExtendedControllerAPI::setSceneTime(const ExtendedProjectSceneSetTimeR
 }
 
 ApiResult ExtendedControllerAPI::cutScene(const ExtendedProjectSceneCutReqBody& reqBody) {
-    nlohmann::json patch = nlohmann::json::array();
-    // Simplified implementation - would need complex timeline cutting logic
-    patch.push_back({
+    PJSON_ALLOC_SCOPE("cutScene");
+    if (!dataStore) {
+        return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
+    }
+    
+    nlohmann::json patches = nlohmann::json::array();
+    const auto& scenes = dataStore->getCurrentProjectData().scenes;
+    
+    // Step 1: Find and validate the scene
+    size_t sceneIndex = 0;
+    ExtendedProjectScene* scene = dataStore->findScene(reqBody.sceneUuid, sceneIndex);
+    if (!scene) {
+        return ApiResult::error(ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND);
+    }
+    
+    ExtendedProjectScene& targetScene = *scene;
+    
+    if (targetScene.sceneType == SceneTypeEnum::INTRO || targetScene.sceneType == SceneTypeEnum::OUTRO) {
+        return ApiResult::error(ApiMessage::ACTION_DENIED);
+    }
+    
+    // Step 2: Sort and merge the cut ranges; nothing to do if none of them
+    // lies inside the scene
+    SceneCutList cuts(reqBody.cutList, targetScene.duration);
+    if (cuts.empty()) {
+        return ApiResult::success(patches, convertProjectToProjectAndSceneVo(reqBody.sceneUuid));
+    }
+    
+    // The scene must keep some content
+    if (cuts.removed() >= targetScene.duration) {
+        return ApiResult::error(ApiMessage::SCENE_CUT_DURATION_LIMITATION);
+    }
+    
+    // Step 3: Trim and split the scene's timelines and transcript in one pass
+    applySceneCut(targetScene, cuts, [this] { return newUuid(); });
+    dataStore->syncProjectTimelines(targetScene.uuid, {&targetScene});
+    
+    // Step 4: Shift all subsequent scenes and their timelines once; the BGM
+    // follows the project length
+    dataStore->shiftScenes(sceneIndex + 1, -cuts.removed());
+    auto& projectTimelines = dataStore->projectTimelines();
+    if (!projectTimelines.empty() && sceneIndex + 1 < scenes.size()) {
+        std::unordered_set<std::string_view> laterScenes;
+        laterScenes.reserve(scenes.size() - sceneIndex - 1);
+        for (size_t i = sceneIndex + 1; i < scenes.size(); ++i) {
+            laterScenes.insert(scenes[i].uuid);
+        }
+        for (auto& timeline : projectTimelines) {
+            if (laterScenes.count(timeline.sceneUuid)) {
+                timeline.timeOffsetInProject -= cuts.removed();
+            }
+        }
+    }
+    const int totalDuration = scenes.back().timeOffsetInProject + scenes.back().duration;
+    auto& bgms = dataStore->projectBgms();
+    std::vector<size_t> resizedBgms;
+    for (size_t i = 0; i < bgms.size(); ++i) {
+        if (bgms[i].duration != totalDuration) {
+            bgms[i].duration = totalDuration;
+            resizedBgms.push_back(i);
+        }
+    }
+    
+    // Step 5: Generate patches for the cut scene and the scenes behind it.
+    // The result VO already holds the scene (except inside a batch).
+    nlohmann::json resultData = convertProjectToProjectAndSceneVo(reqBody.sceneUuid);
+    patches.push_back({
         {"op", "replace"},
-        {"path", "/scenes/[uuid=" + reqBody.sceneUuid + "]/timelines"},
-        {"value", nlohmann::json::array()} // Cut timelines placeholder
+        {"path", "/scenes/" + std::to_string(sceneIndex)},
+        {"value", resultData.contains("scene") ? resultData["scene"] : convertSceneToProjectSceneVo(targetScene)}
     });
+    for (size_t i = sceneIndex + 1; i < scenes.size(); ++i) {
+        patches.push_back({
+            {"op", "replace"},
+            {"path", "/scenes/" + std::to_string(i) + "/timeOffsetInProject"},
+            {"value", scenes[i].timeOffsetInProject}
+        });
+    }
     
-    return ApiResult::success(patch);
+    for (size_t i : resizedBgms) {
+        patches.push_back({
+            {"op", "replace"},
+            {"path", "/bgms/" + std::to_string(i) + "/duration"},
+            {"value", totalDuration}
+        });
+    }
+    
+    return ApiResult::success(patches, resultData);
 }
 
+namespace {
+
+// Layers as scene VOs and patches carry them.
+nlohmann::json layersToJson(const std::vector<BaseLayer>& layers) {
+    nlohmann::json layersArray = nlohmann::json::array();
+    for (const auto& layer : layers) {
+        layersArray.push_back({
+            {"uuid", layer.uuid},
+            {"type", layer.type},
+            {"timeOffsetInScene", layer.timeOffsetInScene},
+            {"duration", layer.duration},
+            {"data", layer.data}
+        });
+    }
+    return layersArray;
+}
+
+// A scene's a-rolls or b-rolls as scene VOs and patches carry them.
+nlohmann::json timelinesToJson(const std::vector<ExtendedTimeline>& timelines) {
+    nlohmann::json timelinesArray = nlohmann::json::array();
+    for (const auto& timeline : timelines) {
+        nlohmann::json timelineJson;
+        timelineJson["uuid"] = timeline.uuid;
+        timelineJson["assetUuid"] = timeline.assetUuid;
+        timelineJson["category"] = static_cast<int>(timeline.category);
+        timelineJson["timeOffsetInScene"] = timeline.timeOffsetInScene;
+        timelineJson["timeOffsetInProject"] = timeline.timeOffsetInProject;
+        timelineJson["duration"] = timeline.duration;
+        timelineJson["startTime"] = timeline.startTime;
+        timelineJson["endTime"] = timeline.endTime;
+        timelineJson["volume"] = timeline.volume;
+        timelineJson["mute"] = timeline.mute;
+        timelineJson["speed"] = timeline.speed;
+        timelinesArray.push_back(timelineJson);
+    }
+    return timelinesArray;
+}
+
+nlohmann::json voiceOversToJson(const std::vector<VoiceOver>& voiceOvers) {
+    nlohmann::json voiceOversArray = nlohmann::json::array();
+    for (const auto& vo : voiceOvers) {
+        nlohmann::json voJson;
+        voJson["uuid"] = vo.uuid;
+        voJson["assetUuid"] = vo.assetUuid;
+        voJson["category"] = static_cast<int>(vo.category);
+        voJson["timeOffsetInProject"] = vo.timeOffsetInProject;
+        voJson["duration"] = vo.duration;
+        voJson["startTime"] = vo.startTime;
+        voJson["endTime"] = vo.endTime;
+        voJson["volume"] = vo.volume;
+        voJson["audioLink"] = vo.audioLink;
+        voJson["voiceUuid"] = vo.voiceUuid;
+        voJson["audioOnly"] = vo.audioOnly;
+        voiceOversArray.push_back(voJson);
+    }
+    return voiceOversArray;
+}
+
+// In-scene offset bookkeeping for splitScene. Voice-overs only carry a
+// project offset, which does not change when their scene is split.
+void startsSecondScene(ExtendedTimeline& timeline) { timeline.timeOffsetInScene = 0; }
+void startsSecondScene(VoiceOver&) {}
+void movesToSecondScene(ExtendedTimeline& timeline, int splitTime) { timeline.timeOffsetInScene -= splitTime; }
+void movesToSecondScene(VoiceOver&, int) {}
+
+// Moves every item of one track into the first or second half of a split
+// scene. Items spanning the split point are truncated in the first half and
+// continue at the start of the second; those are the only copies made.
+// The halves split the media window [startTime, endTime) at the same point,
+// scaled by the playback speed.
+template <typename T>
+void splitTrack(std::vector<T>& items, int splitOffset, int splitTime,
+                std::vector<T>& first, std::vector<T>& second) {
+    for (auto& item : items) {
+        if (item.timeOffsetInProject >= splitOffset) {
+            // Entirely in second scene: same place in the project, but the
+            // scene now starts splitTime later
+            movesToSecondScene(item, splitTime);
+            second.push_back(std::move(item));
+        } else if (item.timeOffsetInProject + item.duration <= splitOffset) {
+            // Entirely in first scene
+            first.push_back(std::move(item));
+        } else {
+            // Spans split point - truncate for first scene, continue in second
+            // where the first half's media window ends. The media end stays
+            // where it was.
+            int newDuration = splitOffset - item.timeOffsetInProject;
+            const int mediaSplit = std::min(item.startTime + mediaSpan(playbackSpeed(item), newDuration),
+                                            item.endTime);
+            T continuation = item;
+            continuation.timeOffsetInProject = splitOffset;
+            continuation.duration = item.duration - newDuration;
+            continuation.startTime = mediaSplit;
+            startsSecondScene(continuation);
+            item.duration = newDuration;
+            item.endTime = mediaSplit;
+            first.push_back(std::move(item));
+            second.push_back(std::move(continuation));
+        }
+    }
+}
+
+} // namespace
+
 ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("splitScene");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -850,13 +1002,30 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
         return ApiResult::error(ApiMessage::ACTION_DENIED);
     }
     
-    // Step 2: Create two new scenes based on original scene
+    // Step 2: Create two new scenes based on original scene. The timelines and
+    // transcript are detached first so only the scalar properties get copied;
+    // the original is replaced by firstScene below.
+    std::vector<ExtendedTimeline> originARolls = std::move(originScene->aRolls);
+    std::vector<ExtendedTimeline> originBRolls = std::move(originScene->bRolls);
+    std::vector<VoiceOver> originVoiceOvers = std::move(originScene->voiceOvers);
+    std::optional<SceneTranscript> originTranscript = std::move(originScene->transcript);
+    std::vector<BaseLayer> originLayers = std::move(originScene->layers);
+    originScene->aRolls.clear();
+    originScene->bRolls.clear();
+    originScene->voiceOvers.clear();
+    originScene->transcript.reset();
+    originScene->layers.clear();
+    
     ExtendedProjectScene firstScene = *originScene;  // Copy all properties
     ExtendedProjectScene secondScene = *originScene;
     
     // Generate new UUIDs
-    firstScene.uuid = genUuid();
-    secondScene.uuid = genUuid();
+    UuidText sceneIds[2];
+    idGenerator->nextBatch(sceneIds, 2);
+    firstScene.uuid.assign(sceneIds[0].data(), sceneIds[0].size());
+    secondScene.uuid.assign(sceneIds[1].data(), sceneIds[1].size());
+    const std::string firstSceneUuid = firstScene.uuid;
+    const std::string secondSceneUuid = secondScene.uuid;
     
     // Set scene names (following Java backend pattern)
     firstScene.name = originScene->name + "(1)";
@@ -872,8 +1041,8 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
     
     // Step 4: Split transcripts (Java backend: TranscriptUtil.splitTranscript with complex pace logic)
     bool transcriptWasSplit = false;
-    if (originScene->transcript.has_value()) {
-        SceneTranscript originalTranscript = originScene->transcript.value();
+    if (originTranscript.has_value()) {
+        const SceneTranscript& originalTranscript = originTranscript.value();
         
         // Complex transcript splitting - Java backend uses pace calculation and timing analysis
         SceneTranscript firstTranscript, secondTranscript;
@@ -907,8 +1076,8 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
         firstTranscript.modified = false;  // Java: NO_CHANGED for non-voice templates
         secondTranscript.modified = false;
         
-    firstScene.transcript = firstTranscript;
-    secondScene.transcript = secondTranscript;
+    firstScene.transcript = std::move(firstTranscript);
+    secondScene.transcript = std::move(secondTranscript);
     // Mark transcripts as modified only if parity option enabled
     if (parityOptions.markTranscriptsModifiedOnSplit) {
         firstScene.transcript->modified = true;
@@ -918,101 +1087,30 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
     }
     
     // Step 5: Split timelines within each scene
-    firstScene.aRolls.clear();
-    firstScene.bRolls.clear(); 
-    firstScene.voiceOvers.clear();
-    
-    secondScene.aRolls.clear();
-    secondScene.bRolls.clear();
-    secondScene.voiceOvers.clear();
-    
-    // Process aRolls
-    for (const auto& timeline : originScene->aRolls) {
-        if (timeline.timeOffsetInProject < originScene->timeOffsetInProject + splitTime) {
-            // Timeline belongs to first scene or spans split point
-            ExtendedTimeline firstTimeline = timeline;
-            
-            if (timeline.timeOffsetInProject + timeline.duration <= originScene->timeOffsetInProject + splitTime) {
-                // Timeline entirely in first scene
-                firstScene.aRolls.push_back(firstTimeline);
-            } else {
-                // Timeline spans split point - truncate for first scene
-                int newDuration = (originScene->timeOffsetInProject + splitTime) - timeline.timeOffsetInProject;
-                firstTimeline.duration = newDuration;
-                firstScene.aRolls.push_back(firstTimeline);
-                
-                // Create continuation for second scene
-                ExtendedTimeline secondTimeline = timeline;
-                secondTimeline.timeOffsetInProject = secondScene.timeOffsetInProject;
-                secondTimeline.duration = timeline.duration - newDuration;
-                secondScene.aRolls.push_back(secondTimeline);
-            }
-        } else {
-            // Timeline entirely in second scene
-            ExtendedTimeline secondTimeline = timeline;
-            secondTimeline.timeOffsetInProject = timeline.timeOffsetInProject - splitTime;
-            secondScene.aRolls.push_back(secondTimeline);
-        }
-    }
+    const int splitOffset = originScene->timeOffsetInProject + splitTime;
+    splitTrack(originARolls, splitOffset, splitTime, firstScene.aRolls, secondScene.aRolls);
+    splitTrack(originBRolls, splitOffset, splitTime, firstScene.bRolls, secondScene.bRolls);
+    splitTrack(originVoiceOvers, splitOffset, splitTime, firstScene.voiceOvers, secondScene.voiceOvers);
     
-    // Process bRolls (same logic as aRolls)
-    for (const auto& timeline : originScene->bRolls) {
-        if (timeline.timeOffsetInProject < originScene->timeOffsetInProject + splitTime) {
-            ExtendedTimeline firstTimeline = timeline;
-            
-            if (timeline.timeOffsetInProject + timeline.duration <= originScene->timeOffsetInProject + splitTime) {
-                firstScene.bRolls.push_back(firstTimeline);
-            } else {
-                int newDuration = (originScene->timeOffsetInProject + splitTime) - timeline.timeOffsetInProject;
-                firstTimeline.duration = newDuration;
-                firstScene.bRolls.push_back(firstTimeline);
-                
-                ExtendedTimeline secondTimeline = timeline;
-                secondTimeline.timeOffsetInProject = secondScene.timeOffsetInProject;
-                secondTimeline.duration = timeline.duration - newDuration;
-                secondScene.bRolls.push_back(secondTimeline);
-            }
-        } else {
-            ExtendedTimeline secondTimeline = timeline;
-            secondTimeline.timeOffsetInProject = timeline.timeOffsetInProject - splitTime;
-            secondScene.bRolls.push_back(secondTimeline);
+    for (ExtendedProjectScene* half : {&firstScene, &secondScene}) {
+        for (auto& timeline : half->aRolls) {
+            timeline.sceneUuid = half->uuid;
         }
-    }
-    
-    // Process voiceOvers (same logic as timelines)
-    for (const auto& voiceOver : originScene->voiceOvers) {
-        if (voiceOver.timeOffsetInProject < originScene->timeOffsetInProject + splitTime) {
-            VoiceOver firstVoiceOver = voiceOver;
-            
-            if (voiceOver.timeOffsetInProject + voiceOver.duration <= originScene->timeOffsetInProject + splitTime) {
-                firstScene.voiceOvers.push_back(firstVoiceOver);
-            } else {
-                int newDuration = (originScene->timeOffsetInProject + splitTime) - voiceOver.timeOffsetInProject;
-                firstVoiceOver.duration = newDuration;
-                firstScene.voiceOvers.push_back(firstVoiceOver);
-                
-                VoiceOver secondVoiceOver = voiceOver;
-                secondVoiceOver.timeOffsetInProject = secondScene.timeOffsetInProject;
-                secondVoiceOver.duration = voiceOver.duration - newDuration;
-                secondScene.voiceOvers.push_back(secondVoiceOver);
-            }
-        } else {
-            VoiceOver secondVoiceOver = voiceOver;
-            secondVoiceOver.timeOffsetInProject = voiceOver.timeOffsetInProject - splitTime;
-            secondScene.voiceOvers.push_back(secondVoiceOver);
+        for (auto& timeline : half->bRolls) {
+            timeline.sceneUuid = half->uuid;
         }
-    }
-    
-    // Step 6: Update subsequent scenes' timeOffsets (they shift by 0 since we're replacing 1 scene with 2)
-    // But we need to adjust scenes after the split position
-    for (auto& scene : dataStore->getProject().scenes) {
-        if (scene.timeOffsetInProject > originScene->timeOffsetInProject && scene.uuid != originScene->uuid) {
-            // No change needed - total duration remains the same
+        for (auto& voiceOver : half->voiceOvers) {
+            voiceOver.sceneUuid = half->uuid;
         }
     }
     
-    // Step 7: Replace original scene with two new scenes in data store
-    auto& scenes = dataStore->getProject().scenes;
+    // Step 5.5: Split layers (Java backend: LayerOperationChainManager.splitSceneLayer)
+    splitLayers(originLayers, splitTime, originScene->duration, firstScene.layers, secondScene.layers,
+                [this] { return newUuid(); });
+    
+    // Step 6: Replace original scene with two new scenes in data store. The
+    // scenes behind them keep their offsets: the total duration is the same.
+    auto& scenes = dataStore->editSceneList();
     auto it = std::find_if(scenes.begin(), scenes.end(), 
                           [&](const ExtendedProjectScene& s) { return s.uuid == originScene->uuid; });
     
@@ -1030,6 +1128,12 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
         if (transcriptWasSplit && firstScene.transcript.has_value()) {
             firstSceneValue["transcript"] = { {"text", firstScene.transcript->text}, {"modified", true} };
         }
+        if (!firstScene.layers.empty()) {
+            firstSceneValue["layers"] = layersToJson(firstScene.layers);
+        }
+        firstSceneValue["aRolls"] = timelinesToJson(firstScene.aRolls);
+        firstSceneValue["bRolls"] = timelinesToJson(firstScene.bRolls);
+        firstSceneValue["voiceOvers"] = voiceOversToJson(firstScene.voiceOvers);
         patches.push_back({
             {"op", "replace"},
             {"path", "/scenes/" + std::to_string(index)},
@@ -1046,58 +1150,48 @@ ApiResult ExtendedControllerAPI::splitScene(const ExtendedProjectSceneSplitReqBo
         if (transcriptWasSplit && secondScene.transcript.has_value()) {
             secondSceneValue["transcript"] = { {"text", secondScene.transcript->text}, {"modified", true} };
         }
+        if (!secondScene.layers.empty()) {
+            secondSceneValue["layers"] = layersToJson(secondScene.layers);
+        }
+        secondSceneValue["aRolls"] = timelinesToJson(secondScene.aRolls);
+        secondSceneValue["bRolls"] = timelinesToJson(secondScene.bRolls);
+        secondSceneValue["voiceOvers"] = voiceOversToJson(secondScene.voiceOvers);
         patches.push_back({
             {"op", "add"},
             {"path", "/scenes/" + std::to_string(index + 1)},
             {"value", secondSceneValue}
         });
         
-        // Apply changes to data store
-        *it = firstScene;  // Replace original with first scene
-        scenes.insert(it + 1, secondScene);  // Insert second scene after first
+        // Apply changes to data store. originScene is the slot being replaced,
+        // so keep what is still needed from it.
+        const std::string originUuid = originScene->uuid;
+        *it = std::move(firstScene);  // Replace original with first scene
+        scenes.insert(scenes.begin() + index + 1, std::move(secondScene));  // Insert second scene after first
         
-        // Step 7.5: Handle layer splitting using Chain of Responsibility pattern (Java backend logic)
-        // Java backend: projectLayerWrapService.getLayerOperationChainManager().splitSceneLayer()
-        // This handles all layer types:
-        // - StickerLayerHandler: split sticker layers with timing adjustments
-        // - TextLayerHandler: split text overlays based on timing
-        // - NarrationLayerHandler: split narration layers
-        // - AvatarLayerHandler: split avatar presence based on timing
-        // - TimelineLayerHandler: split timeline layers
-        
-        // Step 7.6: Update global timeline references
-        for (auto& timeline : dataStore->getProject().timelines) {
-            if (timeline.sceneUuid == originScene->uuid) {
-                // Timeline splitting logic would be applied here
-                // For now, update scene references for first occurrence
-                if (timeline.timeOffsetInProject < originScene->timeOffsetInProject + splitTime) {
-                    timeline.sceneUuid = firstScene.uuid;
-                } else {
-                    timeline.sceneUuid = secondScene.uuid;
-                    timeline.timeOffsetInProject -= splitTime; // Adjust offset
-                }
-            }
-        }
+        // Step 6.5: The project-level copies of the origin's tracks become
+        // those of the two halves, split the same way
+        dataStore->syncProjectTimelines(originUuid, {&scenes[index], &scenes[index + 1]});
     }
     
-    // Step 8: Recompute offsets to ensure consistency
+    // Step 7: Recompute offsets to ensure consistency
     dataStore->recomputeOffsets();
     
-    // Step 9: Create data array with both split scenes (following Java backend: List<ProjectAndSceneVo>)
+    // Step 8: Create data array with both split scenes (following Java backend: List<ProjectAndSceneVo>)
     nlohmann::json resultData = nlohmann::json::array();
-    resultData.push_back(convertProjectToProjectAndSceneVo(firstScene.uuid));
-    resultData.push_back(convertProjectToProjectAndSceneVo(secondScene.uuid));
+    resultData.push_back(convertProjectToProjectAndSceneVo(firstSceneUuid));
+    resultData.push_back(convertProjectToProjectAndSceneVo(secondSceneUuid));
     
     return ApiResult::success(patches, resultData);
 }
 
 ApiResult ExtendedControllerAPI::deleteScene(const ExtendedProjectSceneDeleteReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("deleteScene");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
     nlohmann::json patches = nlohmann::json::array();
-    auto& scenes = dataStore->getProject().scenes;
+    auto& scenes = dataStore->editSceneList();
     
     // Step 1: Validate scene exists and minimum scene count
     auto sceneIt = std::find_if(scenes.begin(), scenes.end(), 
@@ -1120,28 +1214,13 @@ ApiResult ExtendedControllerAPI::deleteScene(const ExtendedProjectSceneDeleteReq
     size_t deletedSceneIndex = std::distance(scenes.begin(), sceneIt);
     
     // Step 3: Update time offsets for all subsequent scenes and their timelines
+    dataStore->shiftScenes(deletedSceneIndex + 1, -deletedSceneDuration);
     for (size_t i = deletedSceneIndex + 1; i < scenes.size(); ++i) {
-        auto& scene = scenes[i];
-        
-        // Decrease scene time offset by deleted scene duration
-        scene.timeOffsetInProject -= deletedSceneDuration;
-        
-        // Update all timeline offsets within the affected scene
-        for (auto& timeline : scene.aRolls) {
-            timeline.timeOffsetInProject -= deletedSceneDuration;
-        }
-        for (auto& timeline : scene.bRolls) {
-            timeline.timeOffsetInProject -= deletedSceneDuration;
-        }
-        for (auto& voiceOver : scene.voiceOvers) {
-            voiceOver.timeOffsetInProject -= deletedSceneDuration;
-        }
-        
         // Generate patches for affected scenes (adjust indices for removal)
         patches.push_back({
             {"op", "replace"},
             {"path", "/scenes/" + std::to_string(i - 1) + "/timeOffsetInProject"}, // i-1 because scene will be removed
-            {"value", scene.timeOffsetInProject}
+            {"value", scenes[i].timeOffsetInProject}
         });
     }
     
@@ -1150,12 +1229,9 @@ ApiResult ExtendedControllerAPI::deleteScene(const ExtendedProjectSceneDeleteReq
     // This includes deleting all timelines, texts, avatars, layers, transitions using Chain of Responsibility pattern
     
     // Step 4.1: Delete all timelines associated with the scene
-    auto& projectTimelines = dataStore->getProject().timelines;
-    auto timelineIt = std::remove_if(projectTimelines.begin(), projectTimelines.end(),
-        [&sceneToDelete](const ExtendedTimeline& timeline) {
-            return timeline.sceneUuid == sceneToDelete.uuid;
-        });
-    projectTimelines.erase(timelineIt, projectTimelines.end());
+    dataStore->removeProjectTimelines([&sceneToDelete](const ExtendedTimeline& timeline) {
+        return timeline.sceneUuid == sceneToDelete.uuid;
+    });
     
     // Step 4.2: Handle layer-specific deletions (would need full layer handler implementation)
     // - StickerLayerHandler: delete sticker layers
@@ -1205,7 +1281,7 @@ ApiResult ExtendedControllerAPI::deleteScene(const ExtendedProjectSceneDeleteReq
     }
     
     // Step 9.5: Update global timeline references to remove deleted scene timelines
-    for (auto& timeline : dataStore->getProject().timelines) {
+    for (auto& timeline : dataStore->projectTimelines()) {
         if (timeline.timeOffsetInProject > deletedSceneOffset) {
             timeline.timeOffsetInProject -= deletedSceneDuration;
         }
@@ -1221,6 +1297,7 @@ ApiResult ExtendedControllerAPI::deleteScene(const ExtendedProjectSceneDeleteReq
 }
 
 ApiResult ExtendedControllerAPI::clearFootage(const ExtendedProjectSceneClearFootageReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("clearFootage");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1255,6 +1332,7 @@ ApiResult ExtendedControllerAPI::clearFootage(const ExtendedProjectSceneClearFoo
 
 // Additional API stubs
 ApiResult ExtendedControllerAPI::replaceFootage(const ProjectSceneReplaceFootageReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("replaceFootage");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1269,7 +1347,7 @@ ApiResult ExtendedControllerAPI::replaceFootage(const ProjectSceneReplaceFootage
     if (reqBody.oldTimelineUuid.empty()) {
         // Create new timeline for footage (following addFootage logic)
         ExtendedTimeline newTimeline;
-        newTimeline.uuid = genUuid();
+        newTimeline.uuid = newUuid();
         newTimeline.sceneUuid = reqBody.sceneUuid;
         newTimeline.assetUuid = reqBody.newAssetUuid;
         newTimeline.category = ProjectTimelineCategoryEnum::FOOTAGE;
@@ -1305,7 +1383,7 @@ ApiResult ExtendedControllerAPI::replaceFootage(const ProjectSceneReplaceFootage
         scene->bRolls.push_back(newTimeline);
         
         // Also add to project timelines for backward compatibility
-        dataStore->getProject().timelines.push_back(newTimeline);
+        dataStore->addProjectTimeline(newTimeline);
         
         // Handle blank scene conversion
         if (scene->sceneType == SceneTypeEnum::BLANK_SCENE) {
@@ -1397,6 +1475,7 @@ ApiResult ExtendedControllerAPI::replaceFootage(const ProjectSceneReplaceFootage
 }
 
 ApiResult ExtendedControllerAPI::adjustFootage(const ProjectSceneAdjustFootageReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("adjustFootage");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1462,6 +1541,7 @@ ApiResult ExtendedControllerAPI::adjustFootage(const ProjectSceneAdjustFootageRe
 }
 
 ApiResult ExtendedControllerAPI::addVoiceOver(const AddVoiceOverReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addVoiceOver");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1474,7 +1554,7 @@ ApiResult ExtendedControllerAPI::addVoiceOver(const AddVoiceOverReqBody& reqBody
     
     // Create new voice over
     VoiceOver voiceOver;
-    voiceOver.uuid = genUuid();
+    voiceOver.uuid = newUuid();
     voiceOver.sceneUuid = reqBody.sceneUuid;
     voiceOver.projectUuid = scene->projectUuid;
     voiceOver.assetUuid = reqBody.assetUuid;
@@ -1514,6 +1594,7 @@ ApiResult ExtendedControllerAPI::addVoiceOver(const AddVoiceOverReqBody& reqBody
 }
 
 ApiResult ExtendedControllerAPI::setPauseTime(const ProjectSceneSetPauseTimeReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setPauseTime");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1544,6 +1625,7 @@ ApiResult ExtendedControllerAPI::setPauseTime(const ProjectSceneSetPauseTimeReqB
 
 // Set scene transition **/v3/project/{projectUuid}/scene/set-transition**
 ApiResult ExtendedControllerAPI::setSceneTransition(const ProjectSceneTransitionReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setSceneTransition");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1552,7 +1634,7 @@ ApiResult ExtendedControllerAPI::setSceneTransition(const ProjectSceneTransition
     
     if (reqBody.forAllScenes) {
         // Apply transition to all scenes
-        const auto& projectData = dataStore->getProject();
+        const auto& projectData = dataStore->getCurrentProjectData();
         for (const auto& scene : projectData.scenes) {
             ExtendedProjectScene* scenePtr = dataStore->findScene(scene.uuid);
             if (!scenePtr) continue;
@@ -1624,6 +1706,7 @@ ApiResult ExtendedControllerAPI::setSceneTransition(const ProjectSceneTransition
 
 // Tier 1 high-priority API implementations
 ApiResult ExtendedControllerAPI::addFootage(const ProjectSceneFootageAddReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addFootage");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1639,54 +1722,35 @@ ApiResult ExtendedControllerAPI::addFootage(const ProjectSceneFootageAddReqBody&
         return ApiResult::error(ApiMessage::ACTION_DENIED);
     }
     
-    // Check if this footage overlaps with any existing footage (following Java backend logic)
-    // Get existing timelines in the scene
-    std::vector<ExtendedTimeline> footageTimelines;
-    std::vector<ExtendedTimeline> voiceOverLines;
-    
-    // Collect footage timelines (bRolls)
-    for (const auto& timeline : scene->bRolls) {
-        if (timeline.category == ProjectTimelineCategoryEnum::FOOTAGE ||
-            timeline.category == ProjectTimelineCategoryEnum::BROLL) {
-            footageTimelines.push_back(timeline);
-        }
-    }
-    
-    // Collect voice over timelines (aRolls and voiceOvers)
-    for (const auto& timeline : scene->aRolls) {
-        if (timeline.category == ProjectTimelineCategoryEnum::SYNTHETIC_VOICE_OVER ||
-            timeline.category == ProjectTimelineCategoryEnum::RECORD_VOICE_OVER ||
-            timeline.category == ProjectTimelineCategoryEnum::STORY_AUDIO ||
-            timeline.category == ProjectTimelineCategoryEnum::MAIN_STORY) {
-            voiceOverLines.push_back(timeline);
-        }
-    }
-    
-    for (const auto& voiceOver : scene->voiceOvers) {
-        ExtendedTimeline voTimeline;
-        voTimeline.timeOffsetInProject = voiceOver.timeOffsetInProject;
-        voTimeline.duration = voiceOver.duration;
-        voiceOverLines.push_back(voTimeline);
-    }
+    // Voice over timelines (aRolls and voiceOvers) only matter for whether any exist
+    bool hasVoiceOverLines = !scene->voiceOvers.empty() ||
+        std::any_of(scene->aRolls.begin(), scene->aRolls.end(), [](const ExtendedTimeline& timeline) {
+            return timeline.category == ProjectTimelineCategoryEnum::SYNTHETIC_VOICE_OVER ||
+                   timeline.category == ProjectTimelineCategoryEnum::RECORD_VOICE_OVER ||
+                   timeline.category == ProjectTimelineCategoryEnum::STORY_AUDIO ||
+                   timeline.category == ProjectTimelineCategoryEnum::MAIN_STORY;
+        });
     
     // Check for timeline overlaps (simplified overlap check)
     int newTimeOffset = scene->timeOffsetInProject + reqBody.timeOffsetInScene;
     int newDuration = reqBody.duration > 0 ? reqBody.duration : scene->duration;
     
-    for (const auto& existing : footageTimelines) {
-        int existingStart = existing.timeOffsetInProject;
-        int existingEnd = existingStart + existing.duration;
-        int newStart = newTimeOffset;
-        int newEnd = newStart + newDuration;
-        
-        if (!(newEnd <= existingStart || newStart >= existingEnd)) {
-            return ApiResult::error(ApiMessage::ACTION_DENIED);
-        }
+    // Check if this footage overlaps with any existing footage (following Java backend logic)
+    const int newEnd = newTimeOffset + newDuration;
+    bool overlapsFootage = std::any_of(scene->bRolls.begin(), scene->bRolls.end(),
+        [newTimeOffset, newEnd](const ExtendedTimeline& timeline) {
+            return (timeline.category == ProjectTimelineCategoryEnum::FOOTAGE ||
+                    timeline.category == ProjectTimelineCategoryEnum::BROLL) &&
+                   timeline.timeOffsetInProject < newEnd &&
+                   newTimeOffset < timeline.timeOffsetInProject + timeline.duration;
+        });
+    if (overlapsFootage) {
+        return ApiResult::error(ApiMessage::ACTION_DENIED);
     }
     
     // Create new timeline for footage (following Java backend structure)
     ExtendedTimeline newTimeline;
-    newTimeline.uuid = genUuid();
+    newTimeline.uuid = newUuid();
     newTimeline.sceneUuid = reqBody.sceneUuid;
     newTimeline.assetUuid = reqBody.assetUuid;
     // Category fallback: if later we support different categories from request, apply; for now constant.
@@ -1713,7 +1777,7 @@ ApiResult ExtendedControllerAPI::addFootage(const ProjectSceneFootageAddReqBody&
     }
     
     // Apply video creation template logic (simplified)
-    if (voiceOverLines.empty()) {
+    if (!hasVoiceOverLines) {
         newTimeline.endTime = endTime;
     } else {
         // If has voice over, limit to scene duration
@@ -1738,7 +1802,7 @@ ApiResult ExtendedControllerAPI::addFootage(const ProjectSceneFootageAddReqBody&
     scene->bRolls.push_back(newTimeline);
     
     // Also add to project timelines for backward compatibility
-    dataStore->getProject().timelines.push_back(newTimeline);
+    dataStore->addProjectTimeline(newTimeline);
     
     // Handle blank scene conversion (following Java backend logic)
     if (scene->sceneType == SceneTypeEnum::BLANK_SCENE) {
@@ -1782,6 +1846,7 @@ ApiResult ExtendedControllerAPI::addFootage(const ProjectSceneFootageAddReqBody&
 }
 
 ApiResult ExtendedControllerAPI::deleteFootage(const ProjectSceneFootageDeleteReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("deleteFootage");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1805,12 +1870,9 @@ ApiResult ExtendedControllerAPI::deleteFootage(const ProjectSceneFootageDeleteRe
     scene->bRolls.erase(it, scene->bRolls.end());
     
     // Also remove from project timelines
-    auto& projectTimelines = dataStore->getProject().timelines;
-    auto projectIt = std::remove_if(projectTimelines.begin(), projectTimelines.end(),
-        [&reqBody](const ExtendedTimeline& timeline) {
-            return timeline.uuid == reqBody.timelineUuid;
-        });
-    projectTimelines.erase(projectIt, projectTimelines.end());
+    dataStore->removeProjectTimelines([&reqBody](const ExtendedTimeline& timeline) {
+        return timeline.uuid == reqBody.timelineUuid;
+    });
     
     nlohmann::json patch = nlohmann::json::array();
     patch.push_back({
@@ -1825,6 +1887,7 @@ ApiResult ExtendedControllerAPI::deleteFootage(const ProjectSceneFootageDeleteRe
 }
 
 ApiResult ExtendedControllerAPI::deleteVoiceOver(const DeleteVoiceOverReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("deleteVoiceOver");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1860,6 +1923,7 @@ ApiResult ExtendedControllerAPI::deleteVoiceOver(const DeleteVoiceOverReqBody& r
 }
 
 ApiResult ExtendedControllerAPI::adjustVoiceOver(const AdjustVoiceOverReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("adjustVoiceOver");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1920,6 +1984,7 @@ ApiResult ExtendedControllerAPI::adjustVoiceOver(const AdjustVoiceOverReqBody& r
 }
 
 ApiResult ExtendedControllerAPI::editScript(const ProjectSceneEditScriptReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("editScript");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -1957,6 +2022,7 @@ ApiResult ExtendedControllerAPI::editScript(const ProjectSceneEditScriptReqBody&
 }
 
 ApiResult ExtendedControllerAPI::setSceneTranscript(const ProjectSceneSetTranscriptReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setSceneTranscript");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -2013,6 +2079,7 @@ ApiResult ExtendedControllerAPI::setSceneTranscript(const ProjectSceneSetTranscr
 }
 
 ApiResult ExtendedControllerAPI::changeHighlight(const EditSceneHighLightReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("changeHighlight");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -2044,6 +2111,7 @@ ApiResult ExtendedControllerAPI::changeHighlight(const EditSceneHighLightReqBody
 }
 
 ApiResult ExtendedControllerAPI::deleteTransition(const std::string& sceneUuid) {
+    PJSON_ALLOC_SCOPE("deleteTransition");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -2067,64 +2135,84 @@ ApiResult ExtendedControllerAPI::deleteTransition(const std::string& sceneUuid)
 }
 
 ApiResult ExtendedControllerAPI::setMainStoryOrder(const SetMainStoryOrderReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setMainStoryOrder");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
-    // Update the order of scenes in the project
-    auto& scenes = dataStore->getProject().scenes;
-    std::vector<ExtendedProjectScene> reorderedScenes;
-    reorderedScenes.reserve(scenes.size());
+    // Update the order of scenes in the project. order[k] is the current
+    // index of the scene that ends up at position k.
+    auto& scenes = dataStore->editSceneList();
+    std::unordered_map<std::string_view, size_t> sceneIndex;
+    sceneIndex.reserve(scenes.size());
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        sceneIndex.emplace(scenes[i].uuid, i);
+    }
+    
+    std::vector<size_t> order;
+    order.reserve(scenes.size());
+    std::vector<bool> placed(scenes.size(), false);
     
     // First, add scenes in the specified order
     for (const auto& sceneUuid : reqBody.timelineUuids) {
-        auto it = std::find_if(scenes.begin(), scenes.end(),
-            [&sceneUuid](const ExtendedProjectScene& scene) {
-                return scene.uuid == sceneUuid;
-            });
-        if (it != scenes.end()) {
-            reorderedScenes.push_back(*it);
+        auto it = sceneIndex.find(sceneUuid);
+        if (it != sceneIndex.end() && !placed[it->second]) {
+            placed[it->second] = true;
+            order.push_back(it->second);
         }
     }
     
     // Then add any remaining scenes that weren't in the order list
-    for (const auto& scene : scenes) {
-        if (std::find(reqBody.timelineUuids.begin(), reqBody.timelineUuids.end(), scene.uuid) 
-            == reqBody.timelineUuids.end()) {
-            reorderedScenes.push_back(scene);
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        if (!placed[i]) {
+            order.push_back(i);
         }
     }
     
-    // Update project with new order
-    scenes = std::move(reorderedScenes);
+    // Patch: the fewest scene moves, then the offsets that changed
+    nlohmann::json patch = nlohmann::json::array();
+    for (const auto& move : permutationMoves(order)) {
+        patch.push_back({
+            {"op", "move"},
+            {"from", "/scenes/" + std::to_string(move.from)},
+            {"path", "/scenes/" + std::to_string(move.to)}
+        });
+    }
     
-    // Recalculate time offsets for the reordered scenes
-    int currentOffset = 0;
-    for (auto& scene : scenes) {
-        scene.timeOffsetInProject = currentOffset;
-        currentOffset += scene.duration;
+    // Update project with new order and recalculate the time offsets of the
+    // scenes and their timelines
+    applyPermutation(scenes, order);
+    std::vector<int> previousOffsets(scenes.size());
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        previousOffsets[i] = scenes[i].timeOffsetInProject;
     }
+    dataStore->recomputeOffsets();
     
-    nlohmann::json patch = nlohmann::json::array();
-    patch.push_back({
-        {"op", "replace"},
-        {"path", "/scenes"},
-        {"value", reqBody.timelineUuids}
-    });
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        if (scenes[i].timeOffsetInProject != previousOffsets[i]) {
+            patch.push_back({
+                {"op", "replace"},
+                {"path", "/scenes/" + std::to_string(i) + "/timeOffsetInProject"},
+                {"value", scenes[i].timeOffsetInProject}
+            });
+        }
+    }
     
     return ApiResult::success(patch);
 }
 
 ApiResult ExtendedControllerAPI::changeFitType(const ChangeFitTypeReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("changeFitType");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
-    // Update project style fit type
-    if (!dataStore->getProject().style.has_value()) {
-        dataStore->getProject().style = nlohmann::json::object();
+    // Update project style fit type; a style that is not an object is replaced
+    auto& style = dataStore->getProject().style;
+    if (!style.has_value() || !style->is_object()) {
+        style = nlohmann::json::object();
     }
-    dataStore->getProject().style.value()["fitType"] = reqBody.fitType;
+    (*style)["fitType"] = reqBody.fitType;
     
     // Apply scale changes to all scenes based on fit type
     SceneScale scaleValue;
@@ -2170,6 +2258,7 @@ ApiResult ExtendedControllerAPI::changeFitType(const ChangeFitTypeReqBody& reqBo
 }
 
 ApiResult ExtendedControllerAPI::changeScaleToAll(const UpdateProjectScaleReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("changeScaleToAll");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -2235,10 +2324,12 @@ ApiResult ExtendedControllerAPI::changeScaleToAll(const UpdateProjectScaleReqBod
 }
 
 // Core business logic implementation - assembleSceneAndTimelines
-ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(const ExtendedProjectScene& scene, 
-                                                                      const std::vector<ExtendedTimeline>& timelines,
+// Takes the scene and timelines by value: callers that no longer need them
+// pass them with std::move and the timelines are moved into their tracks.
+ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(ExtendedProjectScene scene, 
+                                                                      std::vector<ExtendedTimeline> timelines,
                                                                       const std::unordered_map<std::string, ProjectSceneAsset>& assetMap) {
-    ExtendedProjectScene result = scene;
+    ExtendedProjectScene result = std::move(scene);
     
     // Clear existing timeline categories
     result.aRolls.clear();
@@ -2252,19 +2343,19 @@ ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(const Exte
     }
     
     // Categorize timelines based on their category
-    for (const auto& timeline : timelines) {
+    for (auto& timeline : timelines) {
         switch (timeline.category) {
             case ProjectTimelineCategoryEnum::MAIN_STORY:
             case ProjectTimelineCategoryEnum::INTRO:
             case ProjectTimelineCategoryEnum::OUTRO:
             case ProjectTimelineCategoryEnum::STORY_AUDIO:
             case ProjectTimelineCategoryEnum::AROLL:
-                result.aRolls.push_back(timeline);
+                result.aRolls.push_back(std::move(timeline));
                 break;
                 
             case ProjectTimelineCategoryEnum::FOOTAGE:
             case ProjectTimelineCategoryEnum::BROLL:
-                result.bRolls.push_back(timeline);
+                result.bRolls.push_back(std::move(timeline));
                 break;
                 
             case ProjectTimelineCategoryEnum::RECORD_VOICE_OVER:
@@ -2273,10 +2364,10 @@ ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(const Exte
             case ProjectTimelineCategoryEnum::VOICE_OVER: {
                 // Convert timeline to VoiceOver structure
                 VoiceOver voiceOver;
-                voiceOver.uuid = timeline.uuid;
+                voiceOver.uuid = std::move(timeline.uuid);
                 voiceOver.assetUuid = timeline.assetUuid;
-                voiceOver.sceneUuid = timeline.sceneUuid;
-                voiceOver.projectUuid = timeline.projectUuid;
+                voiceOver.sceneUuid = std::move(timeline.sceneUuid);
+                voiceOver.projectUuid = std::move(timeline.projectUuid);
                 voiceOver.category = timeline.category;
                 voiceOver.timeOffsetInProject = timeline.timeOffsetInProject;
                 voiceOver.duration = timeline.duration;
@@ -2290,19 +2381,20 @@ ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(const Exte
                     voiceOver.audioLink = assetIt->second.audioLink.value_or(assetIt->second.assetLink);
                 }
                 
-                result.voiceOvers.push_back(voiceOver);
+                result.voiceOvers.push_back(std::move(voiceOver));
                 break;
             }
         }
     }
     
     // Set transcript based on scene type
-    if (scene.sceneType == SceneTypeEnum::INTRO || scene.sceneType == SceneTypeEnum::OUTRO) {
+    if (result.sceneType == SceneTypeEnum::INTRO || result.sceneType == SceneTypeEnum::OUTRO) {
         result.transcript.reset(); // Clear transcript for intro/outro scenes
     }
     
     // Compute unified timelines for backward compatibility
     result.timelines.clear();
+    result.timelines.reserve(result.aRolls.size() + result.bRolls.size());
     result.timelines.insert(result.timelines.end(), result.aRolls.begin(), result.aRolls.end());
     result.timelines.insert(result.timelines.end(), result.bRolls.begin(), result.bRolls.end());
     
@@ -2311,8 +2403,9 @@ ExtendedProjectScene ExtendedControllerAPI::assembleSceneAndTimelines(const Exte
 
 // Tier 2 BGM Management API implementations
 ApiResult ExtendedControllerAPI::addBgm(const ProjectBgmAddReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addBgm");
     ProjectBgm newBgm;
-    newBgm.uuid = genUuid();
+    newBgm.uuid = newUuid();
     newBgm.assetLink = reqBody.assetUuid; // Using assetUuid as link for simplicity
     newBgm.volume = reqBody.volume;
     newBgm.loop = reqBody.loop;
@@ -2338,13 +2431,13 @@ ApiResult ExtendedControllerAPI::addBgm(const ProjectBgmAddReqBody& reqBody) {
 }
 
 ApiResult ExtendedControllerAPI::deleteBgm(const ProjectBgmDeleteReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("deleteBgm");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
-    auto& project = dataStore->getProject();
-    auto& bgms = project.bgms;
-    auto& assets = project.assets;
+    const auto& bgms = dataStore->getCurrentProjectData().bgms;
+    auto& assets = dataStore->projectAssets();
     
     // Step 1: Find the BGM to delete
     auto bgmIt = std::find_if(bgms.begin(), bgms.end(),
@@ -2367,7 +2460,7 @@ ApiResult ExtendedControllerAPI::deleteBgm(const ProjectBgmDeleteReqBody& reqBod
     
     // Step 3: Remove the BGM from the list
     size_t bgmIndex = std::distance(bgms.begin(), bgmIt);
-    bgms.erase(bgmIt);
+    dataStore->removeBgm(bgmIndex);
     
     // Step 4: Remove associated assets
     for (const auto& assetUuid : assetsToRemove) {
@@ -2398,6 +2491,7 @@ ApiResult ExtendedControllerAPI::deleteBgm(const ProjectBgmDeleteReqBody& reqBod
 }
 
 ApiResult ExtendedControllerAPI::editBgm(const ProjectBgmEditReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("editBgm");
     nlohmann::json patch = nlohmann::json::array();
     
     if (reqBody.volume) {
@@ -2439,6 +2533,7 @@ ApiResult ExtendedControllerAPI::editBgm(const ProjectBgmEditReqBody& reqBody) {
 }
 
 ApiResult ExtendedControllerAPI::adjustBgmAudio(const PsSceneTimelineVolumeReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("adjustBgmAudio");
     nlohmann::json patch = nlohmann::json::array();
     
     for (const auto& [timelineUuid, volume] : reqBody.timelineVolumes) {
@@ -2455,8 +2550,74 @@ ApiResult ExtendedControllerAPI::adjustBgmAudio(const PsSceneTimelineVolumeReqBo
     return ApiResult::success(patch, resultData);
 }
 
+ApiResult ExtendedControllerAPI::replaceAsset(const ProjectAssetReplaceReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("replaceAsset");
+    if (!dataStore) {
+        return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
+    }
+    if (reqBody.oldAssetUuid.empty() || reqBody.newAssetUuid.empty()) {
+        return ApiResult::error(ApiMessage::ILLEGAL_PARAMS);
+    }
+    // The replacement has to be a known asset
+    if (dataStore->getCurrentProjectData().assets.count(reqBody.newAssetUuid) == 0) {
+        return ApiResult::error(ApiMessage::ILLEGAL_PARAMS);
+    }
+
+    const std::vector<AssetRef> changed =
+        dataStore->replaceAsset(reqBody.oldAssetUuid, reqBody.newAssetUuid);
+    const auto& project = dataStore->getCurrentProjectData();
+
+    // The project-level timelines mirror the scene tracks and get no patch
+    // of their own.
+    nlohmann::json patch = nlohmann::json::array();
+    for (const AssetRef& ref : changed) {
+        std::string path;
+        switch (ref.kind) {
+        case AssetRefKind::A_ROLL:
+            path = "/scenes/[uuid=" + project.scenes[ref.sceneIndex].uuid + "]/aRolls/";
+            break;
+        case AssetRefKind::B_ROLL:
+            path = "/scenes/[uuid=" + project.scenes[ref.sceneIndex].uuid + "]/bRolls/";
+            break;
+        case AssetRefKind::VOICE_OVER:
+            path = "/scenes/[uuid=" + project.scenes[ref.sceneIndex].uuid + "]/voiceOvers/";
+            break;
+        case AssetRefKind::BGM:
+            path = "/bgms/";
+            break;
+        case AssetRefKind::PROJECT_TIMELINE:
+            continue;
+        }
+        patch.push_back({
+            {"op", "replace"},
+            {"path", path + std::to_string(ref.index) + "/assetUuid"},
+            {"value", reqBody.newAssetUuid}
+        });
+    }
+
+    return ApiResult::success(patch, convertProjectToProjectAndScenesVo());
+}
+
+ApiResult ExtendedControllerAPI::pruneAssets(const ProjectAssetPruneReqBody&) {
+    PJSON_ALLOC_SCOPE("pruneAssets");
+    if (!dataStore) {
+        return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
+    }
+
+    nlohmann::json patch = nlohmann::json::array();
+    for (const auto& assetId : dataStore->pruneAssets()) {
+        patch.push_back({
+            {"op", "remove"},
+            {"path", "/assets/" + assetId}
+        });
+    }
+
+    return ApiResult::success(patch, convertProjectToProjectAndScenesVo());
+}
+
 // Tier 2 Style and Effects API implementations
 ApiResult ExtendedControllerAPI::setSceneBgStyle(const PsSceneBgStyleReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("setSceneBgStyle");
     nlohmann::json patch = nlohmann::json::array();
     
     patch.push_back({
@@ -2477,18 +2638,10 @@ ApiResult ExtendedControllerAPI::setSceneBgStyle(const PsSceneBgStyleReqBody& re
 }
 
 ApiResult ExtendedControllerAPI::updateGraphicLayers(const ProjectGraphicLayerSettingsReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("updateGraphicLayers");
     nlohmann::json patch = nlohmann::json::array();
     
-    nlohmann::json layersArray = nlohmann::json::array();
-    for (const auto& layer : reqBody.layers) {
-        layersArray.push_back({
-            {"uuid", layer.uuid},
-            {"type", layer.type},
-            {"timeOffsetInScene", layer.timeOffsetInScene},
-            {"duration", layer.duration},
-            {"data", layer.data}
-        });
-    }
+    nlohmann::json layersArray = layersToJson(reqBody.layers);
     
     patch.push_back({
         {"op", "replace"},
@@ -2500,7 +2653,8 @@ ApiResult ExtendedControllerAPI::updateGraphicLayers(const ProjectGraphicLayerSe
 }
 
 ApiResult ExtendedControllerAPI::createBgImage(const CreateWallpaperReqBody& reqBody) {
-    std::string newImageUuid = genUuid();
+    PJSON_ALLOC_SCOPE("createBgImage");
+    std::string newImageUuid = newUuid();
     
     nlohmann::json patch = nlohmann::json::array();
     patch.push_back({
@@ -2520,7 +2674,8 @@ ApiResult ExtendedControllerAPI::createBgImage(const CreateWallpaperReqBody& req
 }
 
 ApiResult ExtendedControllerAPI::addBgImage(const PsBgImageBo& reqBody) {
-    std::string newImageUuid = genUuid();
+    PJSON_ALLOC_SCOPE("addBgImage");
+    std::string newImageUuid = newUuid();
     
     nlohmann::json patch = nlohmann::json::array();
     patch.push_back({
@@ -2540,6 +2695,7 @@ ApiResult ExtendedControllerAPI::addBgImage(const PsBgImageBo& reqBody) {
 
 // Tier 2 Avatar Management API implementations
 ApiResult ExtendedControllerAPI::addAvatar(const ChangeLookReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addAvatar");
     nlohmann::json patch = nlohmann::json::array();
     
     // Add avatar layer to all scenes
@@ -2547,7 +2703,7 @@ ApiResult ExtendedControllerAPI::addAvatar(const ChangeLookReqBody& reqBody) {
         {"op", "add"},
         {"path", "/scenes/*/layers/-"},
         {"value", {
-            {"uuid", genUuid()},
+            {"uuid", newUuid()},
             {"type", "avatar"},
             {"lookUuid", reqBody.lookUuid},
             {"timeOffsetInScene", 0},
@@ -2560,6 +2716,7 @@ ApiResult ExtendedControllerAPI::addAvatar(const ChangeLookReqBody& reqBody) {
 }
 
 ApiResult ExtendedControllerAPI::replaceAvatar(const ChangeLookReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("replaceAvatar");
     nlohmann::json patch = nlohmann::json::array();
     
     patch.push_back({
@@ -2572,6 +2729,7 @@ ApiResult ExtendedControllerAPI::replaceAvatar(const ChangeLookReqBody& reqBody)
 }
 
 ApiResult ExtendedControllerAPI::deleteAvatar() {
+    PJSON_ALLOC_SCOPE("deleteAvatar");
     nlohmann::json patch = nlohmann::json::array();
     
     patch.push_back({
@@ -2583,6 +2741,7 @@ ApiResult ExtendedControllerAPI::deleteAvatar() {
 }
 
 ApiResult ExtendedControllerAPI::clearDeletedAvatar() {
+    PJSON_ALLOC_SCOPE("clearDeletedAvatar");
     nlohmann::json patch = nlohmann::json::array();
     
     patch.push_back({
@@ -2594,6 +2753,7 @@ ApiResult ExtendedControllerAPI::clearDeletedAvatar() {
 }
 
 ApiResult ExtendedControllerAPI::changeDeletedAvatar() {
+    PJSON_ALLOC_SCOPE("changeDeletedAvatar");
     nlohmann::json patch = nlohmann::json::array();
     
     patch.push_back({
@@ -2607,6 +2767,7 @@ ApiResult ExtendedControllerAPI::changeDeletedAvatar() {
 
 // Complete business logic implementation: mergeScenes with full backend parity
 ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("mergeScenes");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
@@ -2652,28 +2813,22 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
         return ApiResult::error(ApiMessage::ACTION_DENIED);
     }
     
-    // Step 4: Get timelines for both scenes
-    std::vector<ExtendedTimeline> formerTimelines;
-    std::vector<ExtendedTimeline> latterTimelines;
-    
-    // Collect timelines belonging to each scene (aRolls, bRolls)
-    for (const auto& timeline : formerScene->aRolls) {
-        formerTimelines.push_back(timeline);
-    }
-    for (const auto& timeline : formerScene->bRolls) {
-        formerTimelines.push_back(timeline);
-    }
-    
-    for (const auto& timeline : latterScene->aRolls) {
-        latterTimelines.push_back(timeline);
-    }
-    for (const auto& timeline : latterScene->bRolls) {
-        latterTimelines.push_back(timeline);
-    }
+    // Step 4: Detach the timelines and transcript of the former scene. Both
+    // scenes are removed below, so their contents are moved, not copied.
+    std::vector<ExtendedTimeline> formerARolls = std::move(formerScene->aRolls);
+    std::vector<ExtendedTimeline> formerBRolls = std::move(formerScene->bRolls);
+    std::vector<VoiceOver> formerVoiceOvers = std::move(formerScene->voiceOvers);
+    std::optional<SceneTranscript> formerTranscript = std::move(formerScene->transcript);
+    std::vector<BaseLayer> formerLayers = std::move(formerScene->layers);
+    formerScene->aRolls.clear();
+    formerScene->bRolls.clear();
+    formerScene->voiceOvers.clear();
+    formerScene->transcript.reset();
+    formerScene->layers.clear();
     
     // Step 5: Create merged scene (following Java backend logic)
     ExtendedProjectScene mergedScene = *formerScene; // Copy former scene as base
-    mergedScene.uuid = genUuid(); // Generate new UUID
+    mergedScene.uuid = newUuid(); // Generate new UUID
     
     // Set merged scene name (enhanced normalization & dedupe)
     auto trim = [](const std::string& s) {
@@ -2723,11 +2878,11 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
     int sceneDurationChange = mergedScene.duration - originalDuration;
     
     // Step 8: Merge transcripts with complex logic (Java backend: TranscriptUtil.mergeTranscripts)
-    if (formerScene->transcript.has_value() && latterScene->transcript.has_value()) {
+    if (formerTranscript.has_value() && latterScene->transcript.has_value()) {
         SceneTranscript mergedTranscript;
         // Complex transcript merging logic:
         // 1. Merge transcript text with proper spacing
-        mergedTranscript.text = formerScene->transcript->text + " " + latterScene->transcript->text;
+        mergedTranscript.text = formerTranscript->text + " " + latterScene->transcript->text;
         
         // 2. In full implementation would need:
         // - Pace calculation and timing adjustments
@@ -2736,46 +2891,37 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
         // mergedTranscript = TranscriptUtil.mergeTranscripts(project, formerScene, formerSceneRealDuration, 
         //                                                    latterScene, latterSceneRealDuration, pace);
         
-        mergedScene.transcript = mergedTranscript;
-    } else if (formerScene->transcript.has_value()) {
-        mergedScene.transcript = formerScene->transcript;
+        mergedScene.transcript = std::move(mergedTranscript);
+    } else if (formerTranscript.has_value()) {
+        mergedScene.transcript = std::move(formerTranscript);
     } else if (latterScene->transcript.has_value()) {
-        mergedScene.transcript = latterScene->transcript;
+        mergedScene.transcript = std::move(latterScene->transcript);
     }
     
     // Step 9: Merge timelines from both scenes
-    // Clear existing timelines and merge from both scenes
-    mergedScene.aRolls.clear();
-    mergedScene.bRolls.clear();
-    mergedScene.voiceOvers.clear();
-    
-    // Add former scene timelines first
-    for (const auto& timeline : formerScene->aRolls) {
-        mergedScene.aRolls.push_back(timeline);
-    }
-    for (const auto& timeline : formerScene->bRolls) {
-        mergedScene.bRolls.push_back(timeline);
-    }
-    for (const auto& voiceOver : formerScene->voiceOvers) {
-        mergedScene.voiceOvers.push_back(voiceOver);
-    }
+    // Former scene timelines first
+    mergedScene.aRolls = std::move(formerARolls);
+    mergedScene.bRolls = std::move(formerBRolls);
+    mergedScene.voiceOvers = std::move(formerVoiceOvers);
+    mergedScene.aRolls.reserve(mergedScene.aRolls.size() + latterScene->aRolls.size());
+    mergedScene.bRolls.reserve(mergedScene.bRolls.size() + latterScene->bRolls.size());
+    mergedScene.voiceOvers.reserve(mergedScene.voiceOvers.size() + latterScene->voiceOvers.size());
     
     // Add latter scene timelines with adjusted offsets (Java backend: timelineService.handleMergeScenee)
-    for (auto timeline : latterScene->aRolls) {
-        // Adjust timeline offsets based on former scene duration
-        timeline.timeOffsetInProject += formerScene->duration;
+    for (auto& timeline : latterScene->aRolls) {
+        // Same place in the project, but now relative to the former scene's start
+        timeline.timeOffsetInScene += formerScene->duration;
         timeline.sceneUuid = mergedScene.uuid; // Update scene reference
-        mergedScene.aRolls.push_back(timeline);
+        mergedScene.aRolls.push_back(std::move(timeline));
     }
-    for (auto timeline : latterScene->bRolls) {
-        timeline.timeOffsetInProject += formerScene->duration;
+    for (auto& timeline : latterScene->bRolls) {
+        timeline.timeOffsetInScene += formerScene->duration;
         timeline.sceneUuid = mergedScene.uuid; // Update scene reference
-        mergedScene.bRolls.push_back(timeline);
+        mergedScene.bRolls.push_back(std::move(timeline));
     }
-    for (auto voiceOver : latterScene->voiceOvers) {
-        voiceOver.timeOffsetInProject += formerScene->duration;
+    for (auto& voiceOver : latterScene->voiceOvers) {
         voiceOver.sceneUuid = mergedScene.uuid; // Update scene reference
-        mergedScene.voiceOvers.push_back(voiceOver);
+        mergedScene.voiceOvers.push_back(std::move(voiceOver));
     }
     
     // Step 10: Handle style and animation merging (Java backend: projectStyleService.handleSceneStyleAfterMerge)
@@ -2784,25 +2930,21 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
     // - Adjusting animation timings and offsets
     // - Merging transition styles between scenes
     
-    // Step 10.5: Handle layer merging using Chain of Responsibility pattern
-    // Java backend: projectLayerWrapService.getLayerOperationChainManager().mergeSceneLayer()
-    // This handles all layer types: stickers, text, narration, and avatar
-    // In full implementation would need:
-    // - StickerLayerHandler: merge sticker layers with timing adjustments
-    // - TextLayerHandler: merge text overlays and adjust timings
-    // - NarrationLayerHandler: merge narration layers
-    // - AvatarLayerHandler: merge avatar presence and adjust timings
+    // Step 10.5: Merge layers (Java backend: LayerOperationChainManager.mergeSceneLayer)
+    mergeLayers(formerLayers, latterScene->layers, formerScene->duration, latterScene->duration,
+                mergedScene.duration);
+    mergedScene.layers = std::move(formerLayers);
     
         // Step 11: Insert merged scene and remove original scenes
     int insertIndex = -1;
     std::vector<int> removeIndices;
     
     // Find positions of original scenes
-    for (size_t i = 0; i < dataStore->getProject().scenes.size(); ++i) {
-        if (dataStore->getProject().scenes[i].uuid == formerScene->uuid) {
+    for (size_t i = 0; i < dataStore->getCurrentProjectData().scenes.size(); ++i) {
+        if (dataStore->getCurrentProjectData().scenes[i].uuid == formerScene->uuid) {
             insertIndex = i; // Insert at former scene position
             removeIndices.push_back(i);
-        } else if (dataStore->getProject().scenes[i].uuid == latterScene->uuid) {
+        } else if (dataStore->getCurrentProjectData().scenes[i].uuid == latterScene->uuid) {
             removeIndices.push_back(i);
         }
     }
@@ -2825,6 +2967,9 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
             {"sceneType", static_cast<int>(mergedScene.sceneType)}
         }}
     });
+    if (!mergedScene.layers.empty()) {
+        scenePatches.back()["value"]["layers"] = layersToJson(mergedScene.layers);
+    }
     
     // Remove original scenes (in reverse order)
     for (int idx : removeIndices) {
@@ -2838,8 +2983,11 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
     // Save original scene UUIDs before deleting the scenes
     std::string formerSceneUuid = formerScene->uuid;
     std::string latterSceneUuid = latterScene->uuid;
+    int formerSceneDuration = formerScene->duration;
+    const std::string mergedSceneUuid = mergedScene.uuid;
+    const int mergedSceneOffset = mergedScene.timeOffsetInProject;
     
-    dataStore->getProject().scenes.insert(dataStore->getProject().scenes.begin() + insertIndex, mergedScene);
+    dataStore->editSceneList().insert(dataStore->editSceneList().begin() + insertIndex, std::move(mergedScene));
     
     // Remove original scenes from data store (adjust indices after insertion)
     for (size_t i = 0; i < removeIndices.size(); ++i) {
@@ -2847,42 +2995,35 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
         if (i > 0 || removeIndices[i] > insertIndex) {
             adjustedIdx++; // Adjust for the inserted scene
         }
-        if (adjustedIdx < dataStore->getProject().scenes.size()) {
-            dataStore->getProject().scenes.erase(dataStore->getProject().scenes.begin() + adjustedIdx);
+        if (adjustedIdx < dataStore->editSceneList().size()) {
+            dataStore->editSceneList().erase(dataStore->editSceneList().begin() + adjustedIdx);
         }
     }
     
     // Step 12.5: Update timeline sceneUuid references (Java backend logic)
-    for (auto& timeline : dataStore->getProject().timelines) {
+    for (auto& timeline : dataStore->projectTimelines()) {
+        if (timeline.sceneUuid == latterSceneUuid) {
+            timeline.timeOffsetInScene += formerSceneDuration;
+        }
         if (timeline.sceneUuid == formerSceneUuid || timeline.sceneUuid == latterSceneUuid) {
-            timeline.sceneUuid = mergedScene.uuid;
+            timeline.sceneUuid = mergedSceneUuid;
         }
     }
     
     // Step 12.6: Handle time offset updates for subsequent scenes (Java backend logic)
     if (sceneDurationChange != 0) {
         // Update time offsets for all scenes after the merged scene
-        for (auto& scene : dataStore->getProject().scenes) {
-            if (scene.timeOffsetInProject > mergedScene.timeOffsetInProject && scene.uuid != mergedScene.uuid) {
-                scene.timeOffsetInProject += sceneDurationChange;
-                
-                // Update all timeline offsets within the affected scene
-                for (auto& timeline : scene.aRolls) {
-                    timeline.timeOffsetInProject += sceneDurationChange;
-                }
-                for (auto& timeline : scene.bRolls) {
-                    timeline.timeOffsetInProject += sceneDurationChange;
-                }
-                for (auto& voiceOver : scene.voiceOvers) {
-                    voiceOver.timeOffsetInProject += sceneDurationChange;
-                }
-            }
+        auto& mergedScenes = dataStore->editSceneList();
+        auto mergedIt = std::find_if(mergedScenes.begin(), mergedScenes.end(),
+            [&mergedSceneUuid](const ExtendedProjectScene& scene) { return scene.uuid == mergedSceneUuid; });
+        if (mergedIt != mergedScenes.end()) {
+            dataStore->shiftScenes(std::distance(mergedScenes.begin(), mergedIt) + 1, sceneDurationChange);
         }
         
         // Also update global timeline references
-        for (auto& timeline : dataStore->getProject().timelines) {
-            if (timeline.timeOffsetInProject > mergedScene.timeOffsetInProject && 
-                timeline.sceneUuid != mergedScene.uuid) {
+        for (auto& timeline : dataStore->projectTimelines()) {
+            if (timeline.timeOffsetInProject > mergedSceneOffset && 
+                timeline.sceneUuid != mergedSceneUuid) {
                 timeline.timeOffsetInProject += sceneDurationChange;
             }
         }
@@ -2901,30 +3042,27 @@ ApiResult ExtendedControllerAPI::mergeScenes(const ExtendedProjectSceneMergeReqB
     dataStore->recomputeOffsets();
     
     // Step 14: Create ProjectAndSceneVo equivalent data for API compatibility (following Java backend)
-    nlohmann::json resultData = convertProjectToProjectAndSceneVo(mergedScene.uuid);
+    nlohmann::json resultData = convertProjectToProjectAndSceneVo(mergedSceneUuid);
     
     return ApiResult::success(patches, resultData);
 }
 
 ApiResult ExtendedControllerAPI::addSceneAudio(const AddSceneAudioReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("addSceneAudio");
     if (!dataStore) {
         return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
     }
     
     nlohmann::json patches = nlohmann::json::array();
-    auto& scenes = dataStore->getProject().scenes;
     
     // Step 1: Find and validate the target scene
-    auto sceneIt = std::find_if(scenes.begin(), scenes.end(), 
-        [&reqBody](const ExtendedProjectScene& scene) {
-            return scene.uuid == reqBody.sceneUuid;
-        });
-    
-    if (sceneIt == scenes.end()) {
+    size_t sceneIndex = 0;
+    ExtendedProjectScene* scene = dataStore->findScene(reqBody.sceneUuid, sceneIndex);
+    if (!scene) {
         return ApiResult::error(ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND);
     }
     
-    ExtendedProjectScene& targetScene = *sceneIt;
+    ExtendedProjectScene& targetScene = *scene;
     
     // Step 2: Validate scene type (only blank scenes can have audio added)
     if (targetScene.sceneType != SceneTypeEnum::BLANK_SCENE) {
@@ -2952,7 +3090,7 @@ ApiResult ExtendedControllerAPI::addSceneAudio(const AddSceneAudioReqBody& reqBo
     
     // Step 4: Create new timeline for the audio
     ExtendedTimeline newAudioTimeline;
-    newAudioTimeline.uuid = genUuid();
+    newAudioTimeline.uuid = newUuid();
     newAudioTimeline.sceneUuid = reqBody.sceneUuid;
     newAudioTimeline.assetUuid = reqBody.entityUuid;
     newAudioTimeline.category = ProjectTimelineCategoryEnum::STORY_AUDIO;
@@ -2981,26 +3119,10 @@ ApiResult ExtendedControllerAPI::addSceneAudio(const AddSceneAudioReqBody& reqBo
     
     // Step 7: Update subsequent scenes' time offsets
     if (durationChange != 0) {
-        for (auto& scene : scenes) {
-            if (scene.timeOffsetInProject > targetScene.timeOffsetInProject) {
-                scene.timeOffsetInProject += durationChange;
-                
-                // Update timelines within affected scenes
-                for (auto& timeline : scene.aRolls) {
-                    timeline.timeOffsetInProject += durationChange;
-                }
-                for (auto& timeline : scene.bRolls) {
-                    timeline.timeOffsetInProject += durationChange;
-                }
-                for (auto& voiceOver : scene.voiceOvers) {
-                    voiceOver.timeOffsetInProject += durationChange;
-                }
-            }
-        }
+        dataStore->shiftScenes(sceneIndex + 1, durationChange);
     }
     
     // Step 8: Generate patches
-    size_t sceneIndex = std::distance(scenes.begin(), sceneIt);
     patches.push_back({
         {"op", "replace"},
         {"path", "/scenes/" + std::to_string(sceneIndex) + "/duration"},
@@ -3035,6 +3157,181 @@ ApiResult ExtendedControllerAPI::addSceneAudio(const AddSceneAudioReqBody& reqBo
     return ApiResult::success(patches, resultData);
 }
 
+namespace {
+
+// One overload per BatchOperation alternative
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneAddReqBody& body) { return api.addScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneRenameReqBody& body) { return api.renameScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneMoveReqBody& body) { return api.moveScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneSetTimeReqBody& body) { return api.setSceneTime(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneCutReqBody& body) { return api.cutScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneSplitReqBody& body) { return api.splitScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneMergeReqBody& body) { return api.mergeScenes(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneDeleteReqBody& body) { return api.deleteScene(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const AddSceneAudioReqBody& body) { return api.addSceneAudio(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ExtendedProjectSceneClearFootageReqBody& body) { return api.clearFootage(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneReplaceFootageReqBody& body) { return api.replaceFootage(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneAdjustFootageReqBody& body) { return api.adjustFootage(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneFootageAddReqBody& body) { return api.addFootage(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneFootageDeleteReqBody& body) { return api.deleteFootage(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const AddVoiceOverReqBody& body) { return api.addVoiceOver(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const DeleteVoiceOverReqBody& body) { return api.deleteVoiceOver(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const AdjustVoiceOverReqBody& body) { return api.adjustVoiceOver(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneSetPauseTimeReqBody& body) { return api.setPauseTime(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneTransitionReqBody& body) { return api.setSceneTransition(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneEditScriptReqBody& body) { return api.editScript(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const ProjectSceneSetTranscriptReqBody& body) { return api.setSceneTranscript(body); }
+ApiResult runBatchOperation(ExtendedControllerAPI& api, const SetMainStoryOrderReqBody& body) { return api.setMainStoryOrder(body); }
+
+// Whether an operation reads project offsets (to place, check or patch
+// something) and so needs the recompute earlier operations left pending.
+// Only these neither read nor emit an offset.
+template <typename Body>
+bool readsProjectOffsets(const Body&) { return true; }
+bool readsProjectOffsets(const ExtendedProjectSceneRenameReqBody&) { return false; }
+bool readsProjectOffsets(const ExtendedProjectSceneClearFootageReqBody&) { return false; }
+bool readsProjectOffsets(const ProjectSceneFootageDeleteReqBody&) { return false; }
+bool readsProjectOffsets(const DeleteVoiceOverReqBody&) { return false; }
+bool readsProjectOffsets(const ProjectSceneSetPauseTimeReqBody&) { return false; }
+bool readsProjectOffsets(const ProjectSceneTransitionReqBody&) { return false; }
+bool readsProjectOffsets(const ProjectSceneEditScriptReqBody&) { return false; }
+bool readsProjectOffsets(const ProjectSceneSetTranscriptReqBody&) { return false; }
+
+// Records in `sent` (by scene uuid) the scene offset a patch operation gives
+// the client. Offset paths index the scenes as the handler left them; a whole
+// scene carries its own uuid.
+void recordSentOffset(const nlohmann::json& op,
+                      const std::vector<ExtendedProjectScene>& scenes,
+                      std::unordered_map<std::string, int>& sent) {
+    static const std::string scenesPrefix = "/scenes/";
+    static const std::string offsetSuffix = "/timeOffsetInProject";
+    if (!op.is_object() || !op.contains("value") || !op.contains("path") || !op["path"].is_string()) {
+        return;
+    }
+    const std::string& path = op["path"].get_ref<const std::string&>();
+    if (path.compare(0, scenesPrefix.size(), scenesPrefix) != 0) {
+        return;
+    }
+    size_t end = scenesPrefix.size();
+    size_t index = 0;
+    while (end < path.size() && std::isdigit(static_cast<unsigned char>(path[end]))) {
+        index = index * 10 + (path[end++] - '0');
+    }
+    if (end == scenesPrefix.size()) {
+        return;
+    }
+    const nlohmann::json& value = op["value"];
+    if (end == path.size() && value.is_object() && value.contains("timeOffsetInProject")) {
+        const char* key = value.contains("uuid") ? "uuid" : "sceneUuid";
+        if (value.contains(key)) {
+            sent[value[key].get<std::string>()] = value["timeOffsetInProject"].get<int>();
+        }
+    } else if (path.compare(end, std::string::npos, offsetSuffix) == 0 &&
+               index < scenes.size() && value.is_number_integer()) {
+        sent[scenes[index].uuid] = value.get<int>();
+    }
+}
+
+// Runs `undo` when it goes out of scope unless dismissed, so every early
+// return - and an exception, in builds that have them - rolls back.
+template <typename F>
+class RollbackGuard {
+public:
+    explicit RollbackGuard(F undo) : undo(std::move(undo)) {}
+    RollbackGuard(const RollbackGuard&) = delete;
+    RollbackGuard& operator=(const RollbackGuard&) = delete;
+    ~RollbackGuard() {
+        if (armed) {
+            undo();
+        }
+    }
+    void dismiss() { armed = false; }
+
+private:
+    F undo;
+    bool armed{true};
+};
+
+} // namespace
+
+ApiResult ExtendedControllerAPI::batch(const ProjectBatchReqBody& reqBody) {
+    PJSON_ALLOC_SCOPE("batch");
+    if (!dataStore) {
+        return ApiResult::error(ApiMessage::DATASTORE_NOT_INITIALIZED);
+    }
+    
+    // Step 1: Keep a copy to roll back to; one copy per batch instead of a
+    // result VO per operation
+    ExtendedProjectAndScenesVo snapshot = dataStore->getCurrentProjectData();
+    const bool outerInBatch = inBatch;
+    auto rollback = [this, &snapshot, outerInBatch]() {
+        inBatch = outerInBatch;
+        dataStore->restoreProject(std::move(snapshot));
+        dataStore->endDeferredRecompute();
+    };
+    
+    // Step 2: Validate and apply each operation; the patches are concatenated.
+    // `sent` is the offset the client holds for each scene once it applied
+    // them, starting from the offsets before the batch.
+    nlohmann::json patches = nlohmann::json::array();
+    std::unordered_map<std::string, int> sent;
+    sent.reserve(snapshot.scenes.size());
+    for (const auto& scene : snapshot.scenes) {
+        sent.emplace(scene.uuid, scene.timeOffsetInProject);
+    }
+    inBatch = true;
+    dataStore->beginDeferredRecompute();
+    RollbackGuard<decltype(rollback)> guard(rollback);
+    for (size_t i = 0; i < reqBody.operations.size(); ++i) {
+        // An earlier operation may have moved scenes without recomputing
+        // their offsets yet
+        if (std::visit([](const auto& body) { return readsProjectOffsets(body); },
+                       reqBody.operations[i])) {
+            dataStore->flushDeferredRecompute();
+        }
+        ApiResult result = std::visit(
+            [this](const auto& body) { return runBatchOperation(*this, body); },
+            reqBody.operations[i]);
+        if (result.isError()) {
+            return ApiResult(result.apiMessage, nlohmann::json::array(),
+                             {{"failedIndex", static_cast<int>(i)}});
+        }
+        const auto& scenes = dataStore->getCurrentProjectData().scenes;
+        if (result.patch.is_array()) {
+            for (auto& op : result.patch) {
+                recordSentOffset(op, scenes, sent);
+                patches.push_back(std::move(op));
+            }
+        } else if (!result.patch.is_null()) {
+            recordSentOffset(result.patch, scenes, sent);
+            patches.push_back(std::move(result.patch));
+        }
+    }
+    guard.dismiss();
+    
+    // Step 3: The pending recompute and one VO for the whole batch
+    inBatch = outerInBatch;
+    dataStore->endDeferredRecompute();
+    
+    // Step 4: Handlers that patch the offsets their recomputeOffsets() call
+    // changed saw nothing change while it was deferred, and a flush moves
+    // scenes silently, so report every scene the client holds elsewhere
+    // (or has not seen yet)
+    const auto& scenes = dataStore->getCurrentProjectData().scenes;
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        auto it = sent.find(scenes[i].uuid);
+        if (it == sent.end() || it->second != scenes[i].timeOffsetInProject) {
+            patches.push_back({
+                {"op", "replace"},
+                {"path", "/scenes/" + std::to_string(i) + "/timeOffsetInProject"},
+                {"value", scenes[i].timeOffsetInProject}
+            });
+        }
+    }
+    
+    return ApiResult::success(patches, convertProjectToProjectAndScenesVo());
+}
+
 } // namespace pjson
 
 // VO conversion method implementations
@@ -3050,6 +3347,9 @@ nlohmann::json ExtendedControllerAPI::convertSceneToProjectSceneVo(const Extende
     sceneVo["timeOffsetInProject"] = scene.timeOffsetInProject;
     sceneVo["duration"] = scene.duration;
     sceneVo["audioFlag"] = scene.audioFlag;
+    if (!scene.layers.empty()) {
+        sceneVo["layers"] = layersToJson(scene.layers);
+    }
     
     // Convert transcript
     if (scene.transcript.has_value()) {
@@ -3082,61 +3382,10 @@ nlohmann::json ExtendedControllerAPI::convertSceneToProjectSceneVo(const Extende
         sceneVo["transcript"] = transcript;
     }
     
-    // Convert timelines (aRolls, bRolls)
-    nlohmann::json aRolls = nlohmann::json::array();
-    for (const auto& timeline : scene.aRolls) {
-        nlohmann::json timelineJson;
-        timelineJson["uuid"] = timeline.uuid;
-        timelineJson["assetUuid"] = timeline.assetUuid;
-        timelineJson["category"] = static_cast<int>(timeline.category);
-        timelineJson["timeOffsetInScene"] = timeline.timeOffsetInScene;
-        timelineJson["timeOffsetInProject"] = timeline.timeOffsetInProject;
-        timelineJson["duration"] = timeline.duration;
-        timelineJson["startTime"] = timeline.startTime;
-        timelineJson["endTime"] = timeline.endTime;
-        timelineJson["volume"] = timeline.volume;
-        timelineJson["mute"] = timeline.mute;
-        timelineJson["speed"] = timeline.speed;
-        aRolls.push_back(timelineJson);
-    }
-    sceneVo["aRolls"] = aRolls;
-    
-    nlohmann::json bRolls = nlohmann::json::array();
-    for (const auto& timeline : scene.bRolls) {
-        nlohmann::json timelineJson;
-        timelineJson["uuid"] = timeline.uuid;
-        timelineJson["assetUuid"] = timeline.assetUuid;
-        timelineJson["category"] = static_cast<int>(timeline.category);
-        timelineJson["timeOffsetInScene"] = timeline.timeOffsetInScene;
-        timelineJson["timeOffsetInProject"] = timeline.timeOffsetInProject;
-        timelineJson["duration"] = timeline.duration;
-        timelineJson["startTime"] = timeline.startTime;
-        timelineJson["endTime"] = timeline.endTime;
-        timelineJson["volume"] = timeline.volume;
-        timelineJson["mute"] = timeline.mute;
-        timelineJson["speed"] = timeline.speed;
-        bRolls.push_back(timelineJson);
-    }
-    sceneVo["bRolls"] = bRolls;
-    
-    // Convert voice overs
-    nlohmann::json voiceOvers = nlohmann::json::array();
-    for (const auto& vo : scene.voiceOvers) {
-        nlohmann::json voJson;
-        voJson["uuid"] = vo.uuid;
-        voJson["assetUuid"] = vo.assetUuid;
-        voJson["category"] = static_cast<int>(vo.category);
-        voJson["timeOffsetInProject"] = vo.timeOffsetInProject;
-        voJson["duration"] = vo.duration;
-        voJson["startTime"] = vo.startTime;
-        voJson["endTime"] = vo.endTime;
-        voJson["volume"] = vo.volume;
-        voJson["audioLink"] = vo.audioLink;
-        voJson["voiceUuid"] = vo.voiceUuid;
-        voJson["audioOnly"] = vo.audioOnly;
-        voiceOvers.push_back(voJson);
-    }
-    sceneVo["voiceOvers"] = voiceOvers;
+    // Convert timelines (aRolls, bRolls) and voice overs
+    sceneVo["aRolls"] = timelinesToJson(scene.aRolls);
+    sceneVo["bRolls"] = timelinesToJson(scene.bRolls);
+    sceneVo["voiceOvers"] = voiceOversToJson(scene.voiceOvers);
     
     // Add pause time
     if (scene.pauseTime.has_value()) {
@@ -3148,52 +3397,74 @@ nlohmann::json ExtendedControllerAPI::convertSceneToProjectSceneVo(const Extende
     return sceneVo;
 }
 
+namespace {
+
+nlohmann::json convertAsset(const ProjectSceneAsset& asset) {
+    nlohmann::json assetJson;
+    assetJson["assetId"] = asset.assetId;
+    assetJson["uuid"] = asset.uuid;
+    assetJson["assetLink"] = asset.assetLink;
+    assetJson["assetType"] = asset.assetType;
+    assetJson["duration"] = asset.duration;
+    assetJson["newMedia"] = asset.newMedia;
+    
+    if (asset.audioLink.has_value()) {
+        assetJson["audioLink"] = asset.audioLink.value();
+    }
+    if (asset.coverLink.has_value()) {
+        assetJson["coverLink"] = asset.coverLink.value();
+    }
+    if (asset.mediaId.has_value()) {
+        assetJson["mediaId"] = asset.mediaId.value();
+    }
+    if (asset.voiceId.has_value()) {
+        assetJson["voiceId"] = asset.voiceId.value();
+    }
+    if (asset.width.has_value()) {
+        assetJson["width"] = asset.width.value();
+    }
+    if (asset.height.has_value()) {
+        assetJson["height"] = asset.height.value();
+    }
+    if (asset.format.has_value()) {
+        assetJson["format"] = asset.format.value();
+    }
+    return assetJson;
+}
+
+} // namespace
+
 nlohmann::json ExtendedControllerAPI::convertAssetsMap(const std::unordered_map<std::string, ProjectSceneAsset>& assets) const {
     nlohmann::json assetsJson;
     
     for (const auto& [assetId, asset] : assets) {
-        nlohmann::json assetJson;
-        assetJson["assetId"] = asset.assetId;
-        assetJson["uuid"] = asset.uuid;
-        assetJson["assetLink"] = asset.assetLink;
-        assetJson["assetType"] = asset.assetType;
-        assetJson["duration"] = asset.duration;
-        assetJson["newMedia"] = asset.newMedia;
-        
-        if (asset.audioLink.has_value()) {
-            assetJson["audioLink"] = asset.audioLink.value();
-        }
-        if (asset.coverLink.has_value()) {
-            assetJson["coverLink"] = asset.coverLink.value();
-        }
-        if (asset.mediaId.has_value()) {
-            assetJson["mediaId"] = asset.mediaId.value();
-        }
-        if (asset.voiceId.has_value()) {
-            assetJson["voiceId"] = asset.voiceId.value();
-        }
-        if (asset.width.has_value()) {
-            assetJson["width"] = asset.width.value();
-        }
-        if (asset.height.has_value()) {
-            assetJson["height"] = asset.height.value();
-        }
-        if (asset.format.has_value()) {
-            assetJson["format"] = asset.format.value();
+        assetsJson[assetId] = convertAsset(asset);
+    }
+    
+    return assetsJson;
+}
+
+nlohmann::json ExtendedControllerAPI::convertAssetsMap(const std::unordered_map<std::string, ProjectSceneAsset>& assets,
+                                                       const std::vector<std::string>& assetIds) const {
+    nlohmann::json assetsJson;
+    
+    for (const auto& assetId : assetIds) {
+        auto it = assets.find(assetId);
+        if (it != assets.end()) {
+            assetsJson[assetId] = convertAsset(it->second);
         }
-        
-        assetsJson[assetId] = assetJson;
     }
     
     return assetsJson;
 }
 
 nlohmann::json ExtendedControllerAPI::convertProjectToProjectAndSceneVo(const std::string& sceneUuid) const {
-    if (!dataStore) {
+    PJSON_ALLOC_SCOPE("convertProjectToProjectAndSceneVo");
+    if (!dataStore || inBatch) {
         return nlohmann::json::object();
     }
     
-    const auto& project = dataStore->getProject();
+    const auto& project = dataStore->getCurrentProjectData();
     
     // Find the specific scene
     const ExtendedProjectScene* targetScene = nullptr;
@@ -3218,17 +3489,20 @@ nlohmann::json ExtendedControllerAPI::convertProjectToProjectAndSceneVo(const st
     result["scene"] = convertSceneToProjectSceneVo(*targetScene);
     
     // Convert assets
-    result["assets"] = convertAssetsMap(project.assets);
+    result["assets"] = parityOptions.scopeSceneVoAssets
+        ? convertAssetsMap(project.assets, dataStore->assetRefs().sceneAssets(sceneUuid))
+        : convertAssetsMap(project.assets);
     
     return result;
 }
 
 nlohmann::json ExtendedControllerAPI::convertProjectToProjectAndScenesVo() const {
-    if (!dataStore) {
+    PJSON_ALLOC_SCOPE("convertProjectToProjectAndScenesVo");
+    if (!dataStore || inBatch) {
         return nlohmann::json::object();
     }
     
-    const auto& project = dataStore->getProject();
+    const auto& project = dataStore->getCurrentProjectData();
     nlohmann::json result;
     
     // Project basic info
@@ -3279,4 +3553,72 @@ nlohmann::json ExtendedControllerAPI::convertProjectToProjectAndScenesVo() const
     return result;
 }
 
+nlohmann::json ExtendedControllerAPI::convertProjectToProjectAndScenesVoSince(int sinceVersion) const {
+    PJSON_ALLOC_SCOPE("convertProjectToProjectAndScenesVoSince");
+    if (!dataStore || inBatch) {
+        return nlohmann::json::object();
+    }
+    
+    const auto& project = dataStore->getCurrentProjectData();
+    if (project.sharedVersion > sinceVersion) {
+        return convertProjectToProjectAndScenesVo();
+    }
+    
+    nlohmann::json result;
+    result["projectUuid"] = project.projectUuid;
+    result["sinceVersion"] = sinceVersion;
+    
+    // Changed scenes only; the client keeps the rest
+    nlohmann::json scenes = nlohmann::json::array();
+    for (const auto& scene : project.scenes) {
+        if (scene.version > sinceVersion) {
+            scenes.push_back(convertSceneToProjectSceneVo(scene));
+        }
+    }
+    result["scenes"] = std::move(scenes);
+    
+    // The new order when scenes were added, removed or moved
+    if (project.sceneListVersion > sinceVersion) {
+        nlohmann::json sceneUuids = nlohmann::json::array();
+        for (const auto& scene : project.scenes) {
+            sceneUuids.push_back(scene.uuid);
+        }
+        result["sceneUuids"] = std::move(sceneUuids);
+    }
+    
+    return result;
+}
+
+void ExtendedControllerAPI::recordChange(const nlohmann::json& patch) {
+    if (dataStore) {
+        dataStore->recordChange(patch);
+    }
+}
+
+nlohmann::json ExtendedControllerAPI::changesSince(uint64_t cursor, size_t maxRecords) const {
+    if (!dataStore) {
+        return nlohmann::json::object();
+    }
+    
+    ChangeFeed::ReadResult read = dataStore->changeFeed().read(cursor, maxRecords);
+    nlohmann::json result;
+    result["cursor"] = read.cursor;
+    if (read.snapshotRequired) {
+        result["version"] = dataStore->getCurrentProjectData().version;
+        result["snapshot"] = convertProjectToProjectAndScenesVo();
+        return result;
+    }
+    
+    nlohmann::json changes = nlohmann::json::array();
+    for (const auto& record : read.records) {
+        changes.push_back({
+            {"sequence", record.sequence},
+            {"version", record.version},
+            {"patch", *record.patch}
+        });
+    }
+    result["changes"] = std::move(changes);
+    return result;
+}
+
 } // namespace pjson
@@ -1,14 +1,29 @@
 #include "../include/pjson_editor/ExtendedAPI.h"
 #include <algorithm>
+#include <cctype>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace pjson {
 
 void ExtendedDataStore::init(std::shared_ptr<ExtendedProjectAndScenesVo> initialProject) {
     project = initialProject;
+    hotBlock.clear();
+    hotBlockChanges.markAll();
+    timeIndex.clear();
+    timeIndexChanges.markAll();
+    sceneOffsetsMoved = true;
+    assetIndex.clear();
+    assetIndexChanges.markAll();
+    changes.clear();
 }
 
 ExtendedProjectAndScenesVo& ExtendedDataStore::getProject() { 
+    hotBlockChanges.markAll();
+    timeIndexChanges.markAll();
+    assetIndexChanges.markAll();
     return *project; 
 }
 
@@ -17,43 +32,304 @@ const ExtendedProjectAndScenesVo& ExtendedDataStore::getProject() const {
 }
 
 ExtendedProjectScene* ExtendedDataStore::findScene(const std::string& sceneUuid) {
-    for (auto& scene : project->scenes) {
-        if (scene.uuid == sceneUuid) {
-            return &scene;
+    size_t index;
+    return findScene(sceneUuid, index);
+}
+
+ExtendedProjectScene* ExtendedDataStore::findScene(const std::string& sceneUuid, size_t& index) {
+    auto& scenes = project->scenes;
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        if (scenes[i].uuid == sceneUuid) {
+            index = i;
+            markSceneChanged(i);
+            return &scenes[i];
         }
     }
     return nullptr;
 }
 
-void ExtendedDataStore::recomputeOffsets() {
-    int totalOffset = 0;
-    for (auto& scene : project->scenes) {
-        scene.timeOffsetInProject = totalOffset;
-        
-        // Update timelines within each scene
-        for (auto& timeline : scene.aRolls) {
-            timeline.timeOffsetInProject = totalOffset + timeline.timeOffsetInScene;
+std::vector<ExtendedProjectScene>& ExtendedDataStore::editSceneList() {
+    hotBlockChanges.markSceneList();
+    timeIndexChanges.markSceneList();
+    assetIndexChanges.markSceneList();
+    return project->scenes;
+}
+
+void ExtendedDataStore::addProjectTimeline(const ExtendedTimeline& timeline) {
+    project->timelines.push_back(timeline);
+    if (!assetIndexChanges.all) {
+        assetIndex.addProjectUse(timeline.assetUuid);
+    }
+}
+
+void ExtendedDataStore::syncProjectTimelines(const std::string& sceneUuid,
+                                             std::initializer_list<const ExtendedProjectScene*> scenes) {
+    auto& timelines = project->timelines;
+    auto ofScene = [&sceneUuid](const ExtendedTimeline& timeline) { return timeline.sceneUuid == sceneUuid; };
+    const size_t first = static_cast<size_t>(
+        std::find_if(timelines.begin(), timelines.end(), ofScene) - timelines.begin());
+    removeProjectTimelines(ofScene);
+    size_t at = std::min(first, timelines.size());
+    for (const ExtendedProjectScene* scene : scenes) {
+        for (const auto* track : {&scene->aRolls, &scene->bRolls}) {
+            timelines.insert(timelines.begin() + at, track->begin(), track->end());
+            at += track->size();
+            if (!assetIndexChanges.all) {
+                for (const auto& timeline : *track) {
+                    assetIndex.addProjectUse(timeline.assetUuid);
+                }
+            }
+        }
+    }
+}
+
+void ExtendedDataStore::removeBgm(size_t index) {
+    auto& bgms = project->bgms;
+    if (index >= bgms.size()) {
+        return;
+    }
+    if (!assetIndexChanges.all) {
+        assetIndex.removeProjectUse(bgms[index].assetUuid);
+    }
+    bgms.erase(bgms.begin() + index);
+}
+
+void ExtendedDataStore::markSceneChanged(size_t index) {
+    const auto& scenes = project->scenes;
+    hotBlockChanges.markScene(index, scenes[index].uuid, scenes.size());
+    timeIndexChanges.markScene(index, scenes[index].uuid, scenes.size());
+    assetIndexChanges.markScene(index, scenes[index].uuid, scenes.size());
+}
+
+void ExtendedDataStore::syncHotBlock() {
+    auto& scenes = project->scenes;
+    if (!hotBlockChanges.all && !hotBlockChanges.sceneList && hotBlock.sceneCount() == scenes.size()) {
+        for (size_t index : hotBlockChanges.sceneIndices) {
+            hotBlock.refreshScene(scenes, index);
+        }
+        hotBlockChanges.clear();
+        // A scene list that was reordered or resized without going through
+        // getProject() still gets a full rebuild.
+        if (hotBlock.matches(scenes)) {
+            return;
         }
-        for (auto& timeline : scene.bRolls) {
-            timeline.timeOffsetInProject = totalOffset + timeline.timeOffsetInScene;
+    }
+    hotBlock.build(scenes);
+    hotBlockChanges.clear();
+}
+
+const TimelineHotBlock& ExtendedDataStore::timelineBlock() {
+    syncHotBlock();
+    return hotBlock;
+}
+
+const TimelineIndex& ExtendedDataStore::timelineIndex() {
+    if (sceneOffsetsMoved || !timeIndexChanges.empty()) {
+        timeIndex.update(project->scenes, timeIndexChanges);
+        timeIndexChanges.clear();
+        sceneOffsetsMoved = false;
+    }
+    return timeIndex;
+}
+
+const AssetRefIndex& ExtendedDataStore::assetRefs() {
+    if (assetIndexChanges.all) {
+        assetIndex.build(*project);
+    } else if (!assetIndexChanges.empty()) {
+        assetIndex.update(*project, assetIndexChanges);
+    }
+    assetIndexChanges.clear();
+    return assetIndex;
+}
+
+std::vector<AssetRef> ExtendedDataStore::replaceAsset(const std::string& from, const std::string& to) {
+    if (from == to) {
+        return {};
+    }
+    std::vector<AssetRef> changed = assetRefs().refs(*project, from);
+    for (const AssetRef& ref : changed) {
+        switch (ref.kind) {
+        case AssetRefKind::A_ROLL:
+            project->scenes[ref.sceneIndex].aRolls[ref.index].assetUuid = to;
+            break;
+        case AssetRefKind::B_ROLL:
+            project->scenes[ref.sceneIndex].bRolls[ref.index].assetUuid = to;
+            break;
+        case AssetRefKind::VOICE_OVER:
+            project->scenes[ref.sceneIndex].voiceOvers[ref.index].assetUuid = to;
+            break;
+        case AssetRefKind::BGM:
+            project->bgms[ref.index].assetUuid = to;
+            break;
+        case AssetRefKind::PROJECT_TIMELINE:
+            project->timelines[ref.index].assetUuid = to;
+            break;
         }
-        for (auto& voiceOver : scene.voiceOvers) {
-            voiceOver.timeOffsetInProject = totalOffset + voiceOver.timeOffsetInProject;
+    }
+    // Timing is untouched, so the hot block and the timeline index stay valid.
+    assetIndex.retarget(from, to);
+    return changed;
+}
+
+std::vector<std::string> ExtendedDataStore::pruneAssets() {
+    const AssetRefIndex& index = assetRefs();
+    std::vector<std::string> removed;
+    auto& assets = project->assets;
+    for (auto it = assets.begin(); it != assets.end();) {
+        if (index.referenced(it->first)) {
+            ++it;
+        } else {
+            removed.push_back(it->first);
+            it = assets.erase(it);
         }
-        
-        totalOffset += scene.duration;
     }
+    std::sort(removed.begin(), removed.end());
+    return removed;
+}
+
+void ExtendedDataStore::shiftScenes(size_t fromIndex, int delta) {
+    shiftSceneRange(fromIndex, project->scenes.size(), delta);
+}
+
+void ExtendedDataStore::shiftSceneRange(size_t beginIndex, size_t endIndex, int delta) {
+    auto& scenes = project->scenes;
+    endIndex = std::min(endIndex, scenes.size());
+    if (delta == 0 || beginIndex >= endIndex) {
+        return;
+    }
+    // Re-read edited scenes while their offsets are still consistent.
+    syncHotBlock();
+    for (size_t i = beginIndex; i < endIndex; ++i) {
+        scenes[i].timeOffsetInProject += delta;
+    }
+    sceneOffsetsMoved = true;
+    hotBlock.shiftScenes(beginIndex, endIndex, delta);
+}
+
+void ExtendedDataStore::beginDeferredRecompute() {
+    recomputeDeferred = true;
+}
+
+void ExtendedDataStore::endDeferredRecompute() {
+    recomputeDeferred = false;
+    if (recomputePending) {
+        recomputePending = false;
+        recomputeOffsets();
+    }
+}
+
+void ExtendedDataStore::flushDeferredRecompute() {
+    if (recomputePending) {
+        recomputePending = false;
+        recomputeDeferred = false;
+        recomputeOffsets();
+        recomputeDeferred = true;
+    }
+}
+
+void ExtendedDataStore::restoreProject(ExtendedProjectAndScenesVo snapshot) {
+    *project = std::move(snapshot);
+    hotBlock.clear();
+    hotBlockChanges.markAll();
+    timeIndexChanges.markAll();
+    assetIndexChanges.markAll();
+    recomputePending = false;
+}
+
+void ExtendedDataStore::recordChange(const nlohmann::json& patch) {
+    if (!patch.is_array() || patch.empty()) {
+        return;
+    }
+    auto& scenes = project->scenes;
+    const int version = ++project->version;
+    changes.append(version, patch);
+
+    // Paths are /scenes/<index>/..., /scenes/[uuid=<uuid>]/... or outside
+    // the scenes. Indices refer to the list as it was at that op, so once a
+    // scene is added, removed or moved every scene is stamped.
+    static const std::string scenesPrefix = "/scenes/";
+    std::vector<size_t> touchedIndices;
+    std::vector<std::string> touchedUuids;
+    bool listChanged = false;
+    for (const auto& op : patch) {
+        const std::string path = op.value("path", "");
+        if (path.compare(0, scenesPrefix.size(), scenesPrefix) != 0) {
+            if (path == "/scenes") {
+                listChanged = true;
+            } else {
+                project->sharedVersion = version;
+            }
+            continue;
+        }
+        const size_t segmentEnd = path.find('/', scenesPrefix.size());
+        const std::string segment = path.substr(scenesPrefix.size(), segmentEnd - scenesPrefix.size());
+        const std::string kind = op.value("op", "");
+        if (segmentEnd == std::string::npos && kind != "replace") {
+            listChanged = true;
+        }
+        if (segment.compare(0, 6, "[uuid=") == 0 && segment.back() == ']') {
+            touchedUuids.push_back(segment.substr(6, segment.size() - 7));
+        } else if (!segment.empty() && segment.size() <= 9 &&
+                   std::all_of(segment.begin(), segment.end(),
+                               [](unsigned char c) { return std::isdigit(c); })) {
+            touchedIndices.push_back(std::stoul(segment));
+        } else {
+            listChanged = true;
+        }
+    }
+
+    if (listChanged) {
+        project->sceneListVersion = version;
+        for (auto& scene : scenes) {
+            scene.version = version;
+        }
+        return;
+    }
+    for (size_t index : touchedIndices) {
+        if (index < scenes.size()) {
+            scenes[index].version = version;
+        }
+    }
+    for (const auto& uuid : touchedUuids) {
+        for (auto& scene : scenes) {
+            if (scene.uuid == uuid) {
+                scene.version = version;
+                break;
+            }
+        }
+    }
+}
+
+void ExtendedDataStore::recomputeOffsets() {
+    if (recomputeDeferred) {
+        recomputePending = true;
+        return;
+    }
+    auto& scenes = project->scenes;
+
+    // Re-read the scenes edited since the last update: this captures their
+    // timelines' offsets relative to the scene before the scene offsets move.
+    syncHotBlock();
+    sceneOffsetsMoved = true;
+
+    std::vector<int32_t> sceneOffsets(scenes.size());
+    std::unordered_map<std::string, int> sceneOffsetByUuid;
+    sceneOffsetByUuid.reserve(scenes.size());
+    int totalOffset = 0;
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        scenes[i].timeOffsetInProject = totalOffset;
+        sceneOffsets[i] = totalOffset;
+        sceneOffsetByUuid[scenes[i].uuid] = totalOffset;
+        totalOffset += scenes[i].duration;
+    }
+    hotBlock.rebaseOnScenes(sceneOffsets);
     
     // Also update project-level timelines 
-    totalOffset = 0;
-    for (const auto& scene : project->scenes) {
-        // Update all timelines that belong to this scene
-        for (auto& timeline : project->timelines) {
-            if (timeline.sceneUuid == scene.uuid) {
-                timeline.timeOffsetInProject = totalOffset + timeline.timeOffsetInScene;
-            }
+    for (auto& timeline : project->timelines) {
+        auto it = sceneOffsetByUuid.find(timeline.sceneUuid);
+        if (it != sceneOffsetByUuid.end()) {
+            timeline.timeOffsetInProject = it->second + timeline.timeOffsetInScene;
         }
-        totalOffset += scene.duration;
     }
     
     // Update BGM durations to match total project duration
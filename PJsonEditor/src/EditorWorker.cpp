@@ -0,0 +1,88 @@
+#include "pjson_editor/EditorWorker.h"
+#include "pjson_editor/BinaryBridge.h"
+#include "pjson_editor/pjson_editor.hpp"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace pjson {
+
+EditorWorker::EditorWorker(nlohmann::json sceneList, std::function<void()> notify,
+                           size_t maxPending)
+    : maxPending(std::max<size_t>(maxPending, 1)),
+      requests(this->maxPending),
+      responses(this->maxPending),
+      notify(std::move(notify)),
+      thread([this, list = std::move(sceneList)]() mutable { run(std::move(list)); }) {}
+
+EditorWorker::~EditorWorker() {
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+bool EditorWorker::submit(Call &call) {
+    if (inFlight.load(std::memory_order_acquire) >= maxPending) {
+        return false;
+    }
+    inFlight.fetch_add(1, std::memory_order_acq_rel);
+    requests.push(std::move(call));
+    // Pairs with the fence in run(): either the worker's look at the ring
+    // after raising `parked` sees this call, or `parked` is seen here. Only
+    // then is the lock taken, so a busy worker costs submit() nothing.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed)) {
+        { std::lock_guard<std::mutex> lock(parkMutex); }
+        wake.notify_one();
+    }
+    return true;
+}
+
+bool EditorWorker::poll(std::vector<uint8_t> &response) {
+    if (!responses.pop(response)) {
+        // Re-arm the notification, then look again: a response pushed before
+        // the exchange is seen here, one pushed after it notifies.
+        notified.exchange(false, std::memory_order_acq_rel);
+        if (!responses.pop(response)) {
+            return false;
+        }
+    }
+    inFlight.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void EditorWorker::run(nlohmann::json sceneList) {
+    PJsonEditor editor(sceneList);
+    sceneList = nlohmann::json();
+    BinaryBridge bridge(editor);
+
+    Call call;
+    for (;;) {
+        if (!requests.pop(call)) {
+            parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::unique_lock<std::mutex> lock(parkMutex);
+            wake.wait(lock, [this] { return stopping || !requests.empty(); });
+            parked.store(false, std::memory_order_relaxed);
+            if (requests.empty()) {
+                return;
+            }
+            continue;
+        }
+        const size_t size = call.bytes.size();
+        if (size != 0) {
+            std::memcpy(bridge.requestBuffer(size), call.bytes.data(), size);
+        }
+        const size_t responseSize = call.json ? bridge.callJson(size) : bridge.call(size);
+        responses.push(std::vector<uint8_t>(bridge.responseData(),
+                                            bridge.responseData() + responseSize));
+        if (!notified.exchange(true, std::memory_order_acq_rel) && notify) {
+            notify();
+        }
+    }
+}
+
+} // namespace pjson
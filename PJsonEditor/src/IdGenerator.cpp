@@ -0,0 +1,116 @@
+#include "pjson_editor/IdGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace pjson {
+
+namespace {
+
+uint64_t splitmix64(uint64_t &x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void seedState(IdGenerator::State &state, uint64_t seed) {
+    // xoshiro must not start from all zeros; splitmix64 never yields four.
+    for (auto &word : state.rng) {
+        word = splitmix64(seed);
+    }
+}
+
+// Writes the 16 bytes hi:lo as 8-4-4-4-12 hex.
+void format(uint64_t hi, uint64_t lo, UuidText &out) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    size_t pos = 0;
+    auto emit = [&](uint64_t word) {
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+                out[pos++] = '-';
+            }
+            out[pos++] = HEX[(word >> shift) & 0xF];
+        }
+    };
+    emit(hi);
+    emit(lo);
+}
+
+} // namespace
+
+IdGenerator::IdGenerator() {
+    std::random_device device;
+    const uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device() ^
+                          static_cast<uint64_t>(
+                              std::chrono::steady_clock::now().time_since_epoch().count());
+    seedState(current, seed);
+}
+
+IdGenerator::IdGenerator(uint64_t seed, Version version) : uuidVersion(version) {
+    seedState(current, seed);
+}
+
+// xoshiro256**
+uint64_t IdGenerator::nextRandom() {
+    auto &s = current.rng;
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+void IdGenerator::next(UuidText &out) {
+    uint64_t hi = nextRandom();
+    uint64_t lo = nextRandom();
+    if (uuidVersion == Version::V7) {
+        if (autoClock) {
+            advanceTime(systemTimeMs());
+        }
+        // 48-bit unix_ts_ms, then version and 12 random bits.
+        hi = (static_cast<uint64_t>(current.timeMs) << 16) | (hi & 0x0FFFULL) | 0x7000ULL;
+    } else {
+        hi = (hi & ~0xF000ULL) | 0x4000ULL;
+    }
+    lo = (lo & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL; // variant 10
+    format(hi, lo, out);
+}
+
+std::string IdGenerator::nextString() {
+    UuidText text;
+    next(text);
+    return std::string(text.data(), text.size());
+}
+
+void IdGenerator::nextBatch(UuidText *out, size_t count) {
+    if (uuidVersion == Version::V7 && autoClock) {
+        advanceTime(systemTimeMs());
+    }
+    const bool savedAutoClock = autoClock;
+    autoClock = false;
+    for (size_t i = 0; i < count; ++i) {
+        next(out[i]);
+    }
+    autoClock = savedAutoClock;
+}
+
+void IdGenerator::advanceTime(int64_t nowMs) {
+    current.timeMs = std::max(current.timeMs, nowMs);
+}
+
+int64_t IdGenerator::systemTimeMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace pjson
@@ -0,0 +1,132 @@
+#include "pjson_editor/JsonReader.h"
+
+namespace pjson {
+
+bool readValue(const nlohmann::json &value, std::string &out) {
+    if (!value.is_string()) {
+        return false;
+    }
+    out = value.get_ref<const std::string &>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, int &out) {
+    if (!value.is_number()) {
+        return false;
+    }
+    out = value.get<int>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, int64_t &out) {
+    if (!value.is_number()) {
+        return false;
+    }
+    out = value.get<int64_t>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, uint64_t &out) {
+    if (!value.is_number()) {
+        return false;
+    }
+    out = value.get<uint64_t>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, double &out) {
+    if (!value.is_number()) {
+        return false;
+    }
+    out = value.get<double>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, bool &out) {
+    if (!value.is_boolean()) {
+        return false;
+    }
+    out = value.get<bool>();
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, nlohmann::json &out) {
+    out = value;
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, std::optional<nlohmann::json> &out) {
+    out = value;
+    return true;
+}
+
+bool readValue(const nlohmann::json &value, JsonBlob &out) {
+    out = value;
+    return true;
+}
+
+JsonReader::JsonReader(const nlohmann::json &data) : value(data) {}
+
+JsonReader::JsonReader(const nlohmann::json &value, JsonReader *parent, std::string_view key,
+                       size_t index)
+    : value(value), parent(parent), root(parent->root), key(key), index(index) {}
+
+JsonReader JsonReader::child(const char *key) {
+    static const nlohmann::json empty = nlohmann::json::object();
+    const nlohmann::json *field = container(key, nlohmann::json::value_t::object);
+    return JsonReader(field ? *field : empty, this, key);
+}
+
+const nlohmann::json *JsonReader::find(const char *key) const {
+    if (!value.is_object()) {
+        return nullptr;
+    }
+    auto it = value.find(key);
+    return it == value.end() ? nullptr : &*it;
+}
+
+const nlohmann::json *JsonReader::container(const char *key, nlohmann::json::value_t type) {
+    const nlohmann::json *field = find(key);
+    if (!field || field->is_null()) {
+        return nullptr;
+    }
+    if (field->type() != type) {
+        failType(key, *field);
+        return nullptr;
+    }
+    return field;
+}
+
+std::string JsonReader::path() const {
+    std::string out = parent ? parent->path() : std::string();
+    if (!key.empty()) {
+        if (!out.empty()) {
+            out += '.';
+        }
+        out += key;
+    }
+    if (index != NO_INDEX) {
+        out += '[' + std::to_string(index) + ']';
+    }
+    return out;
+}
+
+void JsonReader::fail(const std::string &message) {
+    if (root->failed) {
+        return;
+    }
+    root->failed = true;
+    const std::string where = path();
+    root->firstError = where.empty() ? message : where + ": " + message;
+}
+
+void JsonReader::failField(const char *key, const std::string &message) {
+    if (root->failed) {
+        return;
+    }
+    const std::string where = path();
+    root->failed = true;
+    root->firstError = (where.empty() ? std::string() : where + ".") + key + ": " + message;
+}
+
+} // namespace pjson
@@ -0,0 +1,141 @@
+#include "pjson_editor/LayerPartitioner.h"
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace pjson {
+
+namespace {
+
+// Puts `layer` at [begin, end) of a scene of length sceneLength, clipped to
+// it. False when nothing of a timed layer is left; markers always stay.
+bool place(BaseLayer &layer, int begin, int end, int sceneLength) {
+    const bool marker = begin == end;
+    begin = std::clamp(begin, 0, sceneLength);
+    end = std::clamp(end, 0, sceneLength);
+    if (!marker && begin >= end) {
+        return false;
+    }
+    layer.timeOffsetInScene = begin;
+    layer.duration = end - begin;
+    return true;
+}
+
+std::unordered_set<std::string> wholeSceneTypes(const std::vector<BaseLayer> &layers) {
+    std::unordered_set<std::string> types;
+    for (const auto &layer : layers) {
+        if (coversWholeScene(layer)) {
+            types.insert(layer.type);
+        }
+    }
+    return types;
+}
+
+} // namespace
+
+void splitLayers(std::vector<BaseLayer> &layers, int splitTime, int sceneDuration,
+                 std::vector<BaseLayer> &first, std::vector<BaseLayer> &second,
+                 const std::function<std::string()> &newUuid) {
+    const int secondLength = sceneDuration - splitTime;
+    for (auto &layer : layers) {
+        if (coversWholeScene(layer)) {
+            BaseLayer continuation = layer;
+            continuation.uuid = newUuid();
+            first.push_back(std::move(layer));
+            second.push_back(std::move(continuation));
+            continue;
+        }
+        const int begin = layer.timeOffsetInScene;
+        const int end = begin + layer.duration;
+        if (layer.duration == 0 ? begin < splitTime : end <= splitTime) {
+            if (place(layer, begin, end, splitTime)) {
+                first.push_back(std::move(layer));
+            }
+        } else if (begin >= splitTime) {
+            if (place(layer, begin - splitTime, end - splitTime, secondLength)) {
+                second.push_back(std::move(layer));
+            }
+        } else {
+            // Spans the split: truncated here, continued in the second half
+            BaseLayer continuation = layer;
+            continuation.uuid = newUuid();
+            if (place(continuation, 0, end - splitTime, secondLength)) {
+                second.push_back(std::move(continuation));
+            }
+            if (place(layer, begin, splitTime, splitTime)) {
+                first.push_back(std::move(layer));
+            }
+        }
+    }
+    layers.clear();
+}
+
+void mergeLayers(std::vector<BaseLayer> &former, std::vector<BaseLayer> &latter,
+                 int formerDuration, int latterDuration, int mergedDuration) {
+    const std::unordered_set<std::string> formerWhole = wholeSceneTypes(former);
+    const std::unordered_set<std::string> latterWhole = wholeSceneTypes(latter);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < former.size(); ++i) {
+        BaseLayer &layer = former[i];
+        bool keep = true;
+        if (coversWholeScene(layer)) {
+            if (!latterWhole.count(layer.type)) {
+                keep = place(layer, 0, formerDuration, mergedDuration);
+            }
+        } else {
+            keep = place(layer, layer.timeOffsetInScene,
+                         layer.timeOffsetInScene + layer.duration, mergedDuration);
+        }
+        if (keep) {
+            if (kept != i) {
+                former[kept] = std::move(layer);
+            }
+            ++kept;
+        }
+    }
+    former.resize(kept);
+
+    former.reserve(former.size() + latter.size());
+    for (auto &layer : latter) {
+        bool keep;
+        if (coversWholeScene(layer)) {
+            keep = !formerWhole.count(layer.type) &&
+                   place(layer, formerDuration, formerDuration + latterDuration, mergedDuration);
+        } else {
+            const int begin = formerDuration + layer.timeOffsetInScene;
+            keep = place(layer, begin, begin + layer.duration, mergedDuration);
+        }
+        if (keep) {
+            former.push_back(std::move(layer));
+        }
+    }
+    latter.clear();
+}
+
+void cutLayers(std::vector<BaseLayer> &layers, const SceneCutList &cuts, int sceneDuration) {
+    const int cutLength = sceneDuration - cuts.removed();
+    size_t kept = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        BaseLayer &layer = layers[i];
+        bool keep = true;
+        if (!coversWholeScene(layer)) {
+            const int begin = std::clamp(layer.timeOffsetInScene, 0, sceneDuration);
+            const int end = std::clamp(layer.timeOffsetInScene + layer.duration, 0, sceneDuration);
+            const int mappedBegin = cuts.mapTime(begin);
+            const int mappedEnd = cuts.mapTime(end);
+            // A timed layer mapped to nothing lay inside a cut
+            keep = (layer.duration == 0 || mappedBegin < mappedEnd) &&
+                   place(layer, mappedBegin, mappedEnd, cutLength);
+        }
+        if (keep) {
+            if (kept != i) {
+                layers[kept] = std::move(layer);
+            }
+            ++kept;
+        }
+    }
+    layers.resize(kept);
+}
+
+} // namespace pjson
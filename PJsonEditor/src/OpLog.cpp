@@ -0,0 +1,273 @@
+#include "pjson_editor/OpLog.h"
+#include "pjson_editor/JsonReader.h"
+#include <algorithm>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace pjson {
+
+namespace {
+
+constexpr char MAGIC[4] = {'P', 'J', 'O', 'L'};
+constexpr char KIND_CHECKPOINT = 'C';
+constexpr char KIND_OP = 'O';
+// Larger lengths can only come from a torn or foreign frame.
+constexpr uint32_t MAX_FRAME_SIZE = 1u << 30;
+
+uint32_t fnv1a(const uint8_t *data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void putU32(std::ostream &out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>(value & 0xff),
+                           static_cast<char>((value >> 8) & 0xff),
+                           static_cast<char>((value >> 16) & 0xff),
+                           static_cast<char>((value >> 24) & 0xff)};
+    out.write(bytes, 4);
+}
+
+bool getU32(std::istream &in, uint32_t &value) {
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char *>(bytes), 4)) {
+        return false;
+    }
+    value = static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+            static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+    return true;
+}
+
+// [rng0, rng1, rng2, rng3, timeMs]
+nlohmann::json encodeIds(const IdGenerator::State &ids) {
+    return {ids.rng[0], ids.rng[1], ids.rng[2], ids.rng[3], ids.timeMs};
+}
+
+bool decodeIds(const nlohmann::json &j, IdGenerator::State &ids) {
+    if (!j.is_array() || j.size() != 5) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        if (!j[i].is_number_unsigned()) {
+            return false;
+        }
+        ids.rng[i] = j[i].get<uint64_t>();
+    }
+    if (!j[4].is_number_integer()) {
+        return false;
+    }
+    ids.timeMs = j[4].get<int64_t>();
+    return true;
+}
+
+} // namespace
+
+OpLog::OpLog(std::ostream &stream, OpLogOptions options)
+    : opts(options), out(&stream) {
+    writeHeader(stream);
+}
+
+OpLog::OpLog(const std::string &filePath, OpLogOptions options)
+    : opts(options), path(filePath),
+      file(filePath, std::ios::out | std::ios::trunc | std::ios::binary) {
+    if (file.is_open()) {
+        out = &file;
+        writeHeader(file);
+    }
+}
+
+OpLog::~OpLog() {
+    flush();
+}
+
+void OpLog::writeHeader(std::ostream &stream) {
+    stream.write(MAGIC, sizeof(MAGIC));
+    putU32(stream, FORMAT_VERSION);
+}
+
+void OpLog::writeFrame(std::ostream &stream, char kind, const nlohmann::json &payload) {
+    scratch.clear();
+    nlohmann::json::to_cbor(payload, scratch);
+    stream.put(kind);
+    putU32(stream, static_cast<uint32_t>(scratch.size()));
+    putU32(stream, fnv1a(scratch.data(), scratch.size()));
+    stream.write(reinterpret_cast<const char *>(scratch.data()),
+                 static_cast<std::streamsize>(scratch.size()));
+}
+
+void OpLog::appendOp(const Request &req, int version, const IdGenerator::State &ids) {
+    if (!out) {
+        return;
+    }
+    nlohmann::json payload;
+    payload["v"] = version;
+    payload["i"] = encodeIds(ids);
+    payload["m"] = req.method;
+    payload["u"] = req.url;
+    payload["b"] = req.body;
+    if (!req.headers.empty()) {
+        payload["h"] = req.headers;
+    }
+    writeFrame(*out, KIND_OP, payload);
+    if (opts.flushEachOp) {
+        out->flush();
+    }
+    ++pendingOps;
+}
+
+void OpLog::appendCheckpoint(int version, const IdGenerator::State &ids,
+                             const nlohmann::json &project) {
+    if (!out) {
+        return;
+    }
+    nlohmann::json payload;
+    payload["v"] = version;
+    payload["i"] = encodeIds(ids);
+    payload["p"] = project;
+    if (path.empty() || !compactInto(payload)) {
+        writeFrame(*out, KIND_CHECKPOINT, payload);
+        out->flush();
+    }
+    pendingOps = 0;
+}
+
+// Writes header + checkpoint to a sibling file and renames it over the log,
+// so a crash at any point leaves either the old or the new log intact.
+bool OpLog::compactInto(const nlohmann::json &checkpoint) {
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream tmp(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!tmp.is_open()) {
+            return false;
+        }
+        writeHeader(tmp);
+        writeFrame(tmp, KIND_CHECKPOINT, checkpoint);
+        tmp.flush();
+        if (!tmp.good()) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    file.close();
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        file.open(path, std::ios::out | std::ios::app | std::ios::binary);
+        out = file.is_open() ? &file : nullptr;
+        return false;
+    }
+    file.open(path, std::ios::out | std::ios::app | std::ios::binary);
+    out = file.is_open() ? &file : nullptr;
+    return true;
+}
+
+void OpLog::flush() {
+    if (out) {
+        out->flush();
+    }
+}
+
+bool loadOpLog(std::istream &in, RecoveredLog &log, std::string *error) {
+    auto fail = [error](const std::string &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    log = RecoveredLog();
+    char magic[sizeof(MAGIC)];
+    uint32_t formatVersion = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        !getU32(in, formatVersion)) {
+        return fail("not an op log");
+    }
+    if (formatVersion != OpLog::FORMAT_VERSION) {
+        return fail("unsupported op log version");
+    }
+
+    bool sawCheckpoint = false;
+    std::vector<uint8_t> payload;
+    size_t frameNo = 0;
+    while (true) {
+        const int kind = in.get();
+        if (kind == std::char_traits<char>::eof()) {
+            break;
+        }
+        ++frameNo;
+        uint32_t size = 0;
+        uint32_t hash = 0;
+        if (!getU32(in, size) || !getU32(in, hash) || size > MAX_FRAME_SIZE) {
+            log.truncated = true;
+            break;
+        }
+        payload.resize(size);
+        if (!in.read(reinterpret_cast<char *>(payload.data()), size) ||
+            fnv1a(payload.data(), payload.size()) != hash) {
+            log.truncated = true;
+            break;
+        }
+        nlohmann::json record = nlohmann::json::from_cbor(payload, true, false);
+        if (record.is_discarded() || !record.is_object()) {
+            return fail("frame " + std::to_string(frameNo) + ": invalid payload");
+        }
+        JsonReader fields(record);
+        if (kind == KIND_CHECKPOINT) {
+            if (!fields.read("v", log.version).ok()) {
+                return fail("frame " + std::to_string(frameNo) + ": " + fields.error());
+            }
+            if (!decodeIds(record["i"], log.ids)) {
+                return fail("frame " + std::to_string(frameNo) + ": invalid id state");
+            }
+            log.project = std::move(record["p"]);
+            log.ops.clear();
+            sawCheckpoint = true;
+        } else if (kind == KIND_OP) {
+            if (!sawCheckpoint) {
+                return fail("frame " + std::to_string(frameNo) + ": op before checkpoint");
+            }
+            LoggedOp op;
+            fields.read("v", op.version);
+            if (!decodeIds(record["i"], op.ids)) {
+                return fail("frame " + std::to_string(frameNo) + ": invalid id state");
+            }
+            fields.read("m", op.request.method).read("u", op.request.url);
+            op.request.body = std::move(record["b"]);
+            if (record.contains("h") && record["h"].is_object()) {
+                for (const auto &[key, value] : record["h"].items()) {
+                    if (value.is_string()) {
+                        op.request.headers[key] = value.get<std::string>();
+                    }
+                }
+            }
+            if (!fields.ok()) {
+                return fail("frame " + std::to_string(frameNo) + ": " + fields.error());
+            }
+            log.ops.push_back(std::move(op));
+        } else {
+            return fail("frame " + std::to_string(frameNo) + ": unknown kind");
+        }
+    }
+    if (!sawCheckpoint) {
+        return fail("missing checkpoint");
+    }
+    return true;
+}
+
+bool loadOpLog(const std::string &path, RecoveredLog &log, std::string *error) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        if (error) {
+            *error = "cannot open " + path;
+        }
+        return false;
+    }
+    return loadOpLog(in, log, error);
+}
+
+} // namespace pjson
@@ -0,0 +1,546 @@
+#include "pjson_editor/ProjectCheckpoint.h"
+#include "pjson_editor/JsonReader.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pjson {
+
+namespace {
+
+template <typename T>
+void put(json &j, const char *key, const T &value) {
+    j[key] = value;
+}
+
+template <typename T>
+void put(json &j, const char *key, const std::optional<T> &value) {
+    if (value) {
+        j[key] = *value;
+    }
+}
+
+void put(json &j, const char *key, const JsonBlob &value) {
+    if (value) {
+        j[key] = *value;
+    }
+}
+
+// The enum serializers in ExtendedModels.h do not cover every value, so
+// checkpoints store the underlying number, which readValue() reads back.
+template <typename E>
+void putEnum(json &j, const char *key, E value) {
+    j[key] = static_cast<int>(value);
+}
+
+json encode(const ExtendedTimeline &t) {
+    json j;
+    put(j, "uuid", t.uuid);
+    put(j, "sceneUuid", t.sceneUuid);
+    put(j, "projectUuid", t.projectUuid);
+    put(j, "assetUuid", t.assetUuid);
+    putEnum(j, "category", t.category);
+    put(j, "timeOffsetInScene", t.timeOffsetInScene);
+    put(j, "timeOffsetInProject", t.timeOffsetInProject);
+    put(j, "duration", t.duration);
+    put(j, "startTime", t.startTime);
+    put(j, "endTime", t.endTime);
+    put(j, "volume", t.volume);
+    put(j, "mute", t.mute);
+    put(j, "speed", t.speed);
+    put(j, "blendMode", t.blendMode);
+    put(j, "cropData", t.cropData);
+    put(j, "kenburnsData", t.kenburnsData);
+    put(j, "id", t.id);
+    put(j, "assetId", t.assetId);
+    return j;
+}
+
+void decode(JsonReader &in, ExtendedTimeline &t) {
+    in.read("uuid", t.uuid);
+    in.read("sceneUuid", t.sceneUuid);
+    in.read("projectUuid", t.projectUuid);
+    in.read("assetUuid", t.assetUuid);
+    in.read("category", t.category);
+    in.read("timeOffsetInScene", t.timeOffsetInScene);
+    in.read("timeOffsetInProject", t.timeOffsetInProject);
+    in.read("duration", t.duration);
+    in.read("startTime", t.startTime);
+    in.read("endTime", t.endTime);
+    in.read("volume", t.volume);
+    in.read("mute", t.mute);
+    in.read("speed", t.speed);
+    in.read("blendMode", t.blendMode);
+    in.read("cropData", t.cropData);
+    in.read("kenburnsData", t.kenburnsData);
+    in.read("id", t.id);
+    in.read("assetId", t.assetId);
+}
+
+json encode(const VoiceOver &v) {
+    json j;
+    put(j, "uuid", v.uuid);
+    put(j, "assetUuid", v.assetUuid);
+    put(j, "sceneUuid", v.sceneUuid);
+    put(j, "projectUuid", v.projectUuid);
+    putEnum(j, "category", v.category);
+    put(j, "timeOffsetInProject", v.timeOffsetInProject);
+    put(j, "duration", v.duration);
+    put(j, "startTime", v.startTime);
+    put(j, "endTime", v.endTime);
+    put(j, "volume", v.volume);
+    put(j, "audioLink", v.audioLink);
+    put(j, "voiceUuid", v.voiceUuid);
+    put(j, "audioOnly", v.audioOnly);
+    put(j, "shape", v.shape);
+    put(j, "scale", v.scale);
+    put(j, "position", v.position);
+    put(j, "usePosition", v.usePosition);
+    return j;
+}
+
+void decode(JsonReader &in, VoiceOver &v) {
+    in.read("uuid", v.uuid);
+    in.read("assetUuid", v.assetUuid);
+    in.read("sceneUuid", v.sceneUuid);
+    in.read("projectUuid", v.projectUuid);
+    in.read("category", v.category);
+    in.read("timeOffsetInProject", v.timeOffsetInProject);
+    in.read("duration", v.duration);
+    in.read("startTime", v.startTime);
+    in.read("endTime", v.endTime);
+    in.read("volume", v.volume);
+    in.read("audioLink", v.audioLink);
+    in.read("voiceUuid", v.voiceUuid);
+    in.read("audioOnly", v.audioOnly);
+    in.read("shape", v.shape);
+    in.read("scale", v.scale);
+    in.read("position", v.position);
+    in.read("usePosition", v.usePosition);
+}
+
+json encode(const TranscriptItem &item) {
+    json j;
+    put(j, "startMs", item.startMs);
+    put(j, "endMs", item.endMs);
+    put(j, "text", item.text);
+    put(j, "speaker", item.speaker);
+    put(j, "keywords", item.keywords);
+    return j;
+}
+
+void decode(JsonReader &in, TranscriptItem &item) {
+    in.read("startMs", item.startMs);
+    in.read("endMs", item.endMs);
+    in.read("text", item.text);
+    in.read("speaker", item.speaker);
+    in.read("keywords", item.keywords);
+}
+
+json encode(const BaseLayer &layer) {
+    json j;
+    put(j, "uuid", layer.uuid);
+    put(j, "type", layer.type);
+    put(j, "timeOffsetInScene", layer.timeOffsetInScene);
+    put(j, "duration", layer.duration);
+    put(j, "data", layer.data);
+    return j;
+}
+
+void decode(JsonReader &in, BaseLayer &layer) {
+    in.read("uuid", layer.uuid);
+    in.read("type", layer.type);
+    in.read("timeOffsetInScene", layer.timeOffsetInScene);
+    in.read("duration", layer.duration);
+    in.read("data", layer.data);
+}
+
+json encode(const SceneTransition &transition) {
+    json j;
+    put(j, "type", transition.type);
+    put(j, "duration", transition.duration);
+    put(j, "easing", transition.easing);
+    put(j, "properties", transition.properties);
+    return j;
+}
+
+void decode(JsonReader &in, SceneTransition &transition) {
+    in.read("type", transition.type);
+    in.read("duration", transition.duration);
+    in.read("easing", transition.easing);
+    in.read("properties", transition.properties);
+}
+
+json encode(const ProjectBgm &bgm) {
+    json j;
+    put(j, "uuid", bgm.uuid);
+    put(j, "assetUuid", bgm.assetUuid);
+    put(j, "assetLink", bgm.assetLink);
+    put(j, "adjustedBgmLink", bgm.adjustedBgmLink);
+    put(j, "startTime", bgm.startTime);
+    put(j, "duration", bgm.duration);
+    put(j, "volume", bgm.volume);
+    put(j, "loop", bgm.loop);
+    return j;
+}
+
+void decode(JsonReader &in, ProjectBgm &bgm) {
+    in.read("uuid", bgm.uuid);
+    in.read("assetUuid", bgm.assetUuid);
+    in.read("assetLink", bgm.assetLink);
+    in.read("adjustedBgmLink", bgm.adjustedBgmLink);
+    in.read("startTime", bgm.startTime);
+    in.read("duration", bgm.duration);
+    in.read("volume", bgm.volume);
+    in.read("loop", bgm.loop);
+}
+
+json encode(const ProjectSceneAsset &asset) {
+    json j;
+    put(j, "assetId", asset.assetId);
+    put(j, "uuid", asset.uuid);
+    put(j, "assetLink", asset.assetLink);
+    put(j, "audioLink", asset.audioLink);
+    put(j, "assetType", asset.assetType);
+    put(j, "coverLink", asset.coverLink);
+    put(j, "duration", asset.duration);
+    put(j, "mediaId", asset.mediaId);
+    put(j, "newMedia", asset.newMedia);
+    put(j, "voiceId", asset.voiceId);
+    put(j, "aiTags", asset.aiTags);
+    put(j, "width", asset.width);
+    put(j, "height", asset.height);
+    put(j, "format", asset.format);
+    return j;
+}
+
+void decode(JsonReader &in, ProjectSceneAsset &asset) {
+    in.read("assetId", asset.assetId);
+    in.read("uuid", asset.uuid);
+    in.read("assetLink", asset.assetLink);
+    in.read("audioLink", asset.audioLink);
+    in.read("assetType", asset.assetType);
+    in.read("coverLink", asset.coverLink);
+    in.read("duration", asset.duration);
+    in.read("mediaId", asset.mediaId);
+    in.read("newMedia", asset.newMedia);
+    in.read("voiceId", asset.voiceId);
+    in.read("aiTags", asset.aiTags);
+    in.read("width", asset.width);
+    in.read("height", asset.height);
+    in.read("format", asset.format);
+}
+
+json encode(const SyntheticVoiceMetadata &voice) {
+    json j;
+    put(j, "voiceId", voice.voiceId);
+    put(j, "voiceName", voice.voiceName);
+    put(j, "language", voice.language);
+    put(j, "gender", voice.gender);
+    put(j, "additionalParams", voice.additionalParams);
+    return j;
+}
+
+void decode(JsonReader &in, SyntheticVoiceMetadata &voice) {
+    in.read("voiceId", voice.voiceId);
+    in.read("voiceName", voice.voiceName);
+    in.read("language", voice.language);
+    in.read("gender", voice.gender);
+    in.read("additionalParams", voice.additionalParams);
+}
+
+// Composite types, defined after the container helpers that they use.
+json encode(const SceneTranscript &transcript);
+void decode(JsonReader &in, SceneTranscript &transcript);
+json encode(const ExtendedProjectScene &scene);
+void decode(JsonReader &in, ExtendedProjectScene &scene);
+
+template <typename T>
+void putList(json &j, const char *key, const std::vector<T> &items) {
+    json list = json::array();
+    for (const auto &item : items) {
+        list.push_back(encode(item));
+    }
+    j[key] = std::move(list);
+}
+
+template <typename T>
+void getList(JsonReader &in, const char *key, std::vector<T> &out) {
+    out.clear();
+    in.forEach(key, [&out](JsonReader &itemIn) {
+        T item;
+        decode(itemIn, item);
+        out.push_back(std::move(item));
+    });
+}
+
+template <typename T>
+void putMap(json &j, const char *key, const std::unordered_map<std::string, T> &items) {
+    json map = json::object();
+    for (const auto &[id, item] : items) {
+        map[id] = encode(item);
+    }
+    j[key] = std::move(map);
+}
+
+template <typename T>
+void getMap(JsonReader &in, const char *key, std::unordered_map<std::string, T> &out) {
+    out.clear();
+    in.forEachMember(key, [&out](const std::string &id, JsonReader &itemIn) {
+        decode(itemIn, out[id]);
+    });
+}
+
+json encode(const SceneTranscript &transcript) {
+    json j;
+    put(j, "text", transcript.text);
+    putList(j, "items", transcript.items);
+    put(j, "originalKeywords", transcript.originalKeywords);
+    put(j, "modified", transcript.modified);
+    put(j, "duration", transcript.duration);
+    const auto &status = transcript.modificationStatus;
+    j["modificationStatus"] = {{"changed", status.changed},
+                               {"voiceRedo", status.voiceRedo},
+                               {"recommendFootageRedo", status.recommendFootageRedo}};
+    return j;
+}
+
+void decode(JsonReader &in, SceneTranscript &transcript) {
+    in.read("text", transcript.text);
+    getList(in, "items", transcript.items);
+    in.read("originalKeywords", transcript.originalKeywords);
+    in.read("modified", transcript.modified);
+    in.read("duration", transcript.duration);
+    JsonReader statusIn = in.child("modificationStatus");
+    auto &status = transcript.modificationStatus;
+    statusIn.read("changed", status.changed);
+    statusIn.read("voiceRedo", status.voiceRedo);
+    statusIn.read("recommendFootageRedo", status.recommendFootageRedo);
+}
+
+json encode(const TextOnScreen &text) {
+    json j;
+    if (text.subtitleText) {
+        const auto &subtitle = *text.subtitleText;
+        json s;
+        put(s, "fullText", subtitle.fullText);
+        put(s, "offsetTexts", subtitle.offsetTexts);
+        putEnum(s, "highlightType", subtitle.highlightType);
+        putEnum(s, "highlightStyleType", subtitle.highlightStyleType);
+        j["subtitleText"] = std::move(s);
+    }
+    put(j, "additionalTextLayers", text.additionalTextLayers);
+    return j;
+}
+
+void decode(JsonReader &in, TextOnScreen &text) {
+    if (in.has("subtitleText")) {
+        JsonReader subtitleIn = in.child("subtitleText");
+        SubtitleText subtitle;
+        subtitleIn.read("fullText", subtitle.fullText);
+        subtitleIn.read("offsetTexts", subtitle.offsetTexts);
+        subtitleIn.read("highlightType", subtitle.highlightType);
+        subtitleIn.read("highlightStyleType", subtitle.highlightStyleType);
+        text.subtitleText = std::move(subtitle);
+    }
+    in.read("additionalTextLayers", text.additionalTextLayers);
+}
+
+json encode(const SceneVolumeConf &audio) {
+    json j;
+    put(j, "bgmVolume", audio.bgmVolume);
+    put(j, "voiceVolume", audio.voiceVolume);
+    put(j, "footageVolume", audio.footageVolume);
+    put(j, "timelineVolumes", audio.timelineVolumes);
+    return j;
+}
+
+void decode(JsonReader &in, SceneVolumeConf &audio) {
+    in.read("bgmVolume", audio.bgmVolume);
+    in.read("voiceVolume", audio.voiceVolume);
+    in.read("footageVolume", audio.footageVolume);
+    in.read("timelineVolumes", audio.timelineVolumes);
+}
+
+json encode(const SceneEffect &effect) {
+    json j;
+    put(j, "animationType", effect.animationType);
+    put(j, "parameters", effect.parameters);
+    return j;
+}
+
+void decode(JsonReader &in, SceneEffect &effect) {
+    in.read("animationType", effect.animationType);
+    in.read("parameters", effect.parameters);
+}
+
+json encode(const SceneScale &scale) {
+    json j;
+    put(j, "scaleX", scale.scaleX);
+    put(j, "scaleY", scale.scaleY);
+    put(j, "offsetX", scale.offsetX);
+    put(j, "offsetY", scale.offsetY);
+    put(j, "cropRect", scale.cropRect);
+    return j;
+}
+
+void decode(JsonReader &in, SceneScale &scale) {
+    in.read("scaleX", scale.scaleX);
+    in.read("scaleY", scale.scaleY);
+    in.read("offsetX", scale.offsetX);
+    in.read("offsetY", scale.offsetY);
+    in.read("cropRect", scale.cropRect);
+}
+
+template <typename T>
+void putStruct(json &j, const char *key, const std::optional<T> &value) {
+    if (value) {
+        j[key] = encode(*value);
+    }
+}
+
+template <typename T>
+void getStruct(JsonReader &in, const char *key, std::optional<T> &out) {
+    if (!in.has(key)) {
+        out.reset();
+        return;
+    }
+    JsonReader valueIn = in.child(key);
+    T value;
+    decode(valueIn, value);
+    out = std::move(value);
+}
+
+json encode(const ExtendedProjectScene &scene) {
+    json j;
+    put(j, "uuid", scene.uuid);
+    put(j, "projectUuid", scene.projectUuid);
+    put(j, "name", scene.name);
+    putEnum(j, "sceneType", scene.sceneType);
+    put(j, "duration", scene.duration);
+    put(j, "timeOffsetInProject", scene.timeOffsetInProject);
+    put(j, "pauseTime", scene.pauseTime);
+    put(j, "audioFlag", scene.audioFlag);
+    putStruct(j, "transcript", scene.transcript);
+    putList(j, "aRolls", scene.aRolls);
+    putList(j, "bRolls", scene.bRolls);
+    putList(j, "voiceOvers", scene.voiceOvers);
+    putList(j, "layers", scene.layers);
+    putList(j, "transitions", scene.transitions);
+    putStruct(j, "textOnScreen", scene.textOnScreen);
+    putStruct(j, "audio", scene.audio);
+    putStruct(j, "effect", scene.effect);
+    putStruct(j, "scale", scene.scale);
+    put(j, "deprecatedEffect", scene.deprecatedEffect);
+    put(j, "deprecatedScale", scene.deprecatedScale);
+    put(j, "deprecatedAudio", scene.deprecatedAudio);
+    put(j, "brollShorterPolicyKey", scene.brollShorterPolicyKey);
+    put(j, "bgmVolume", scene.bgmVolume);
+    put(j, "version", scene.version);
+    putList(j, "timelines", scene.timelines);
+    return j;
+}
+
+void decode(JsonReader &in, ExtendedProjectScene &scene) {
+    in.read("uuid", scene.uuid);
+    in.read("projectUuid", scene.projectUuid);
+    in.read("name", scene.name);
+    in.read("sceneType", scene.sceneType);
+    in.read("duration", scene.duration);
+    in.read("timeOffsetInProject", scene.timeOffsetInProject);
+    in.read("pauseTime", scene.pauseTime);
+    in.read("audioFlag", scene.audioFlag);
+    getStruct(in, "transcript", scene.transcript);
+    getList(in, "aRolls", scene.aRolls);
+    getList(in, "bRolls", scene.bRolls);
+    getList(in, "voiceOvers", scene.voiceOvers);
+    getList(in, "layers", scene.layers);
+    getList(in, "transitions", scene.transitions);
+    getStruct(in, "textOnScreen", scene.textOnScreen);
+    getStruct(in, "audio", scene.audio);
+    getStruct(in, "effect", scene.effect);
+    getStruct(in, "scale", scene.scale);
+    in.read("deprecatedEffect", scene.deprecatedEffect);
+    in.read("deprecatedScale", scene.deprecatedScale);
+    in.read("deprecatedAudio", scene.deprecatedAudio);
+    in.read("brollShorterPolicyKey", scene.brollShorterPolicyKey);
+    in.read("bgmVolume", scene.bgmVolume);
+    in.read("version", scene.version);
+    getList(in, "timelines", scene.timelines);
+}
+
+json encode(const ExtendedProject &project) {
+    json j;
+    put(j, "uuid", project.uuid);
+    put(j, "name", project.name);
+    put(j, "ownerUuid", project.ownerUuid);
+    putEnum(j, "status", project.status);
+    put(j, "padColor", project.padColor);
+    put(j, "videoFormat", project.videoFormat);
+    put(j, "brollShorterPolicyKey", project.brollShorterPolicyKey);
+    put(j, "syntheticAll", project.syntheticAll);
+    put(j, "version", project.version);
+    return j;
+}
+
+void decode(JsonReader &in, ExtendedProject &project) {
+    in.read("uuid", project.uuid);
+    in.read("name", project.name);
+    in.read("ownerUuid", project.ownerUuid);
+    in.read("status", project.status);
+    in.read("padColor", project.padColor);
+    in.read("videoFormat", project.videoFormat);
+    in.read("brollShorterPolicyKey", project.brollShorterPolicyKey);
+    in.read("syntheticAll", project.syntheticAll);
+    in.read("version", project.version);
+}
+
+} // namespace
+
+nlohmann::json encodeProjectCheckpoint(const ExtendedProjectAndScenesVo &vo) {
+    json j;
+    j["project"] = encode(vo.project);
+    put(j, "projectUuid", vo.projectUuid);
+    put(j, "ownerUuid", vo.ownerUuid);
+    putEnum(j, "status", vo.status);
+    putList(j, "scenes", vo.scenes);
+    putList(j, "timelines", vo.timelines);
+    putMap(j, "assets", vo.assets);
+    putList(j, "bgms", vo.bgms);
+    putMap(j, "syntheticVoices", vo.syntheticVoices);
+    put(j, "style", vo.style);
+    put(j, "text", vo.text);
+    put(j, "version", vo.version);
+    put(j, "sceneListVersion", vo.sceneListVersion);
+    put(j, "sharedVersion", vo.sharedVersion);
+    return j;
+}
+
+Expected<ExtendedProjectAndScenesVo> decodeProjectCheckpoint(const nlohmann::json &j) {
+    if (!j.is_object()) {
+        return makeUnexpected(std::string("expected an object, got ") + j.type_name());
+    }
+    JsonReader in(j);
+    ExtendedProjectAndScenesVo vo;
+    JsonReader projectIn = in.child("project");
+    decode(projectIn, vo.project);
+    in.read("projectUuid", vo.projectUuid);
+    in.read("ownerUuid", vo.ownerUuid);
+    in.read("status", vo.status);
+    getList(in, "scenes", vo.scenes);
+    getList(in, "timelines", vo.timelines);
+    getMap(in, "assets", vo.assets);
+    getList(in, "bgms", vo.bgms);
+    getMap(in, "syntheticVoices", vo.syntheticVoices);
+    in.read("style", vo.style);
+    in.read("text", vo.text);
+    in.read("version", vo.version);
+    in.read("sceneListVersion", vo.sceneListVersion);
+    in.read("sharedVersion", vo.sharedVersion);
+    if (!in.ok()) {
+        return makeUnexpected(in.error());
+    }
+    return vo;
+}
+
+} // namespace pjson
@@ -0,0 +1,160 @@
+#include "pjson_editor/SceneCutUtils.h"
+#include "pjson_editor/LayerPartitioner.h"
+#include <algorithm>
+#include <utility>
+
+namespace pjson {
+
+SceneCutList::SceneCutList(const std::vector<TimePeriod> &cutList, int sceneDuration) {
+    ranges.reserve(cutList.size());
+    for (const auto &period : cutList) {
+        TimePeriod clipped{std::max(period.start, 0), std::min(period.end, sceneDuration)};
+        if (clipped.start < clipped.end) {
+            ranges.push_back(clipped);
+        }
+    }
+    std::sort(ranges.begin(), ranges.end(),
+              [](const TimePeriod &a, const TimePeriod &b) { return a.start < b.start; });
+
+    // Merge overlapping and touching ranges in place
+    size_t merged = 0;
+    for (size_t k = 0; k < ranges.size(); ++k) {
+        if (merged > 0 && ranges[k].start <= ranges[merged - 1].end) {
+            ranges[merged - 1].end = std::max(ranges[merged - 1].end, ranges[k].end);
+        } else {
+            ranges[merged++] = ranges[k];
+        }
+    }
+    ranges.resize(merged);
+
+    removedBefore.reserve(ranges.size() + 1);
+    removedBefore.push_back(0);
+    for (const auto &range : ranges) {
+        removedBefore.push_back(removedBefore.back() + range.getDuration());
+    }
+}
+
+size_t SceneCutList::firstEndingAfter(int t) const {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), t,
+                               [](int time, const TimePeriod &range) { return time < range.end; });
+    return static_cast<size_t>(it - ranges.begin());
+}
+
+int SceneCutList::mapTime(int t) const {
+    const size_t k = firstEndingAfter(t);
+    int removedTime = removedBefore[k];
+    if (k < ranges.size() && t > ranges[k].start) {
+        removedTime += t - ranges[k].start;
+    }
+    return t - removedTime;
+}
+
+namespace {
+
+// A/b-rolls carry their in-scene offset; voice-overs only have the project
+// offset.
+int inSceneStart(const ExtendedTimeline &timeline, int) { return timeline.timeOffsetInScene; }
+int inSceneStart(const VoiceOver &voiceOver, int sceneOffset) {
+    return voiceOver.timeOffsetInProject - sceneOffset;
+}
+
+void placeInScene(ExtendedTimeline &timeline, int inScene, int sceneOffset) {
+    timeline.timeOffsetInScene = inScene;
+    timeline.timeOffsetInProject = sceneOffset + inScene;
+}
+void placeInScene(VoiceOver &voiceOver, int inScene, int sceneOffset) {
+    voiceOver.timeOffsetInProject = sceneOffset + inScene;
+}
+
+// Rebuilds one track with every item reduced to its kept parts. Items are
+// moved into the result; only the second and later parts of an item that a
+// cut splits are copies.
+template <typename T>
+void cutTrack(std::vector<T> &items, const SceneCutList &cuts, int sceneOffset,
+              const std::function<std::string()> &newUuid) {
+    std::vector<T> result;
+    result.reserve(items.size());
+    std::vector<TimePeriod> kept;
+    for (auto &item : items) {
+        const int start = inSceneStart(item, sceneOffset);
+        const int end = start + item.duration;
+        const int assetStart = item.startTime;
+        const int assetEnd = item.endTime;
+        const double speed = playbackSpeed(item);
+        kept.clear();
+        cuts.forEachKept(start, end,
+                         [&kept](int keptStart, int keptEnd) { kept.push_back({keptStart, keptEnd}); });
+        for (size_t j = 0; j < kept.size(); ++j) {
+            T part = j + 1 == kept.size() ? std::move(item) : item;
+            if (j > 0) {
+                part.uuid = newUuid();
+            }
+            part.duration = kept[j].getDuration();
+            // The part that runs to the item's end keeps its media end
+            part.startTime = std::min(assetStart + mediaSpan(speed, kept[j].start - start), assetEnd);
+            part.endTime = kept[j].end == end
+                               ? assetEnd
+                               : std::min(assetStart + mediaSpan(speed, kept[j].end - start), assetEnd);
+            placeInScene(part, cuts.mapTime(kept[j].start), sceneOffset);
+            result.push_back(std::move(part));
+        }
+    }
+    items = std::move(result);
+}
+
+void cutTranscript(SceneTranscript &transcript, const SceneCutList &cuts) {
+    const size_t before = transcript.items.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < before; ++i) {
+        auto &item = transcript.items[i];
+        const int startMs = cuts.mapTime(item.startMs);
+        const int endMs = cuts.mapTime(item.endMs);
+        if (endMs <= startMs) {
+            continue;
+        }
+        item.startMs = startMs;
+        item.endMs = endMs;
+        if (kept != i) {
+            transcript.items[kept] = std::move(item);
+        }
+        ++kept;
+    }
+    transcript.items.resize(kept);
+    if (transcript.duration > 0) {
+        transcript.duration = cuts.mapTime(transcript.duration);
+    }
+    if (kept == before) {
+        return;
+    }
+
+    // Words were removed: the text follows the remaining items
+    std::string text;
+    for (const auto &item : transcript.items) {
+        if (!text.empty() && !item.text.empty()) {
+            text += ' ';
+        }
+        text += item.text;
+    }
+    transcript.text = std::move(text);
+    transcript.modified = true;
+    transcript.modificationStatus.changed = true;
+}
+
+} // namespace
+
+void applySceneCut(ExtendedProjectScene &scene, const SceneCutList &cuts,
+                   const std::function<std::string()> &newUuid) {
+    if (cuts.empty()) {
+        return;
+    }
+    cutTrack(scene.aRolls, cuts, scene.timeOffsetInProject, newUuid);
+    cutTrack(scene.bRolls, cuts, scene.timeOffsetInProject, newUuid);
+    cutTrack(scene.voiceOvers, cuts, scene.timeOffsetInProject, newUuid);
+    if (scene.transcript.has_value()) {
+        cutTranscript(*scene.transcript, cuts);
+    }
+    cutLayers(scene.layers, cuts, scene.duration);
+    scene.duration -= cuts.removed();
+}
+
+} // namespace pjson
@@ -0,0 +1,111 @@
+#include "pjson_editor/ScenePermutation.h"
+#include <algorithm>
+
+namespace pjson {
+
+namespace {
+
+// Positions k of `order` on one longest strictly increasing run of order[k].
+std::vector<bool> longestIncreasingRun(const std::vector<size_t> &order) {
+    const size_t n = order.size();
+    std::vector<size_t> tails;           // tails[len-1]: position ending the best run of length len
+    std::vector<size_t> previous(n, n);  // previous position on the run ending at k
+    for (size_t k = 0; k < n; ++k) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), order[k],
+                                   [&order](size_t pos, size_t value) { return order[pos] < value; });
+        if (it != tails.begin()) {
+            previous[k] = *(it - 1);
+        }
+        if (it == tails.end()) {
+            tails.push_back(k);
+        } else {
+            *it = k;
+        }
+    }
+    std::vector<bool> onRun(n, false);
+    for (size_t k = tails.empty() ? n : tails.back(); k < n; k = previous[k]) {
+        onRun[k] = true;
+    }
+    return onRun;
+}
+
+// Counts present slots; index of a slot = number of present slots before it.
+class SlotCounter {
+public:
+    explicit SlotCounter(size_t size) : tree(size + 1, 0) {}
+
+    void add(size_t slot, int delta) {
+        for (size_t i = slot + 1; i < tree.size(); i += i & (~i + 1)) {
+            tree[i] += delta;
+        }
+    }
+
+    size_t before(size_t slot) const {
+        int count = 0;
+        for (size_t i = slot; i > 0; i -= i & (~i + 1)) {
+            count += tree[i];
+        }
+        return static_cast<size_t>(count);
+    }
+
+private:
+    std::vector<int> tree;
+};
+
+} // namespace
+
+std::vector<PermutationMove> permutationMoves(const std::vector<size_t> &order) {
+    const size_t n = order.size();
+    const std::vector<bool> stays = longestIncreasingRun(order);
+
+    // Each moved item lands right behind its new predecessor, so the moved
+    // items form chains hanging off the staying item (or the list head) that
+    // precedes them in the new order. Lay out one slot per current item with
+    // room for its chain behind it; the head chain comes first.
+    const size_t head = n;
+    std::vector<size_t> anchor(n, head);
+    std::vector<size_t> chainLength(n + 1, 0);
+    size_t currentAnchor = head;
+    for (size_t k = 0; k < n; ++k) {
+        if (stays[k]) {
+            currentAnchor = order[k];
+        } else {
+            anchor[k] = currentAnchor;
+            ++chainLength[currentAnchor];
+        }
+    }
+
+    std::vector<size_t> chainStart(n + 1, 0);
+    std::vector<size_t> itemSlot(n, 0);
+    size_t slots = chainLength[head];
+    for (size_t i = 0; i < n; ++i) {
+        itemSlot[i] = slots++;
+        chainStart[i] = slots;
+        slots += chainLength[i];
+    }
+
+    SlotCounter present(slots);
+    for (size_t i = 0; i < n; ++i) {
+        present.add(itemSlot[i], 1);
+    }
+
+    std::vector<PermutationMove> moves;
+    moves.reserve(n - std::count(stays.begin(), stays.end(), true));
+    std::vector<size_t> chainUsed(n + 1, 0);
+    for (size_t k = 0; k < n; ++k) {
+        if (stays[k]) {
+            continue;
+        }
+        const size_t item = order[k];
+        PermutationMove move;
+        move.from = present.before(itemSlot[item]);
+        present.add(itemSlot[item], -1);
+        const size_t target = chainStart[anchor[k]] + chainUsed[anchor[k]]++;
+        move.to = present.before(target);
+        present.add(target, 1);
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+} // namespace pjson
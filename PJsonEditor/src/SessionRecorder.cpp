@@ -0,0 +1,128 @@
+#include "pjson_editor/SessionRecorder.h"
+#include "pjson_editor/JsonReader.h"
+#include <istream>
+#include <ostream>
+
+namespace pjson {
+
+SessionRecorder::SessionRecorder(std::ostream &stream, const nlohmann::json &sceneListResp)
+    : out(&stream) {
+    writeInit(sceneListResp);
+}
+
+SessionRecorder::SessionRecorder(const std::string &path, const nlohmann::json &sceneListResp)
+    : file(path, std::ios::out | std::ios::trunc) {
+    if (file.is_open()) {
+        out = &file;
+        writeInit(sceneListResp);
+    }
+}
+
+void SessionRecorder::writeInit(const nlohmann::json &sceneListResp) {
+    nlohmann::json record;
+    record["type"] = "init";
+    record["version"] = FORMAT_VERSION;
+    record["sceneList"] = sceneListResp;
+    *out << record.dump() << '\n';
+    out->flush();
+}
+
+void SessionRecorder::record(const Request &req, const Response &resp, int64_t elapsedUs) {
+    if (!out) {
+        return;
+    }
+    nlohmann::json record;
+    record["type"] = "request";
+    record["seq"] = count;
+    record["method"] = req.method;
+    record["url"] = req.url;
+    record["body"] = req.body;
+    if (!req.headers.empty()) {
+        record["headers"] = req.headers;
+    }
+    record["status"] = resp.status_code;
+    record["elapsedUs"] = elapsedUs;
+    *out << record.dump() << '\n';
+    // Flush per record so a crashing session still leaves a usable prefix.
+    out->flush();
+    ++count;
+}
+
+bool loadSession(std::istream &in, RecordedSession &session, std::string *error) {
+    auto fail = [error](const std::string &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    session = RecordedSession();
+    bool sawInit = false;
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (line.empty()) {
+            continue;
+        }
+        nlohmann::json record = nlohmann::json::parse(line, nullptr, false);
+        if (record.is_discarded() || !record.is_object()) {
+            return fail("line " + std::to_string(lineNo) + ": not a JSON object");
+        }
+        JsonReader fields(record);
+        std::string type;
+        fields.read("type", type);
+        if (type == "init") {
+            if (sawInit) {
+                return fail("line " + std::to_string(lineNo) + ": duplicate init record");
+            }
+            int version = 0;
+            if (!fields.read("version", version).ok() || version != SessionRecorder::FORMAT_VERSION) {
+                return fail("unsupported session version");
+            }
+            session.sceneList = nlohmann::json::object();
+            fields.read("sceneList", session.sceneList);
+            sawInit = true;
+        } else if (type == "request") {
+            if (!sawInit) {
+                return fail("line " + std::to_string(lineNo) + ": request before init record");
+            }
+            RecordedCall call;
+            fields.read("method", call.request.method).read("url", call.request.url);
+            if (record.contains("body")) {
+                call.request.body = record["body"];
+            }
+            if (record.contains("headers") && record["headers"].is_object()) {
+                for (const auto &[key, value] : record["headers"].items()) {
+                    if (value.is_string()) {
+                        call.request.headers[key] = value.get<std::string>();
+                    }
+                }
+            }
+            fields.read("status", call.statusCode).read("elapsedUs", call.elapsedUs);
+            if (!fields.ok()) {
+                return fail("line " + std::to_string(lineNo) + ": " + fields.error());
+            }
+            session.calls.push_back(std::move(call));
+        } else {
+            return fail("line " + std::to_string(lineNo) + ": unknown record type '" + type + "'");
+        }
+    }
+    if (!sawInit) {
+        return fail("missing init record");
+    }
+    return true;
+}
+
+bool loadSession(const std::string &path, RecordedSession &session, std::string *error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        if (error) {
+            *error = "cannot open " + path;
+        }
+        return false;
+    }
+    return loadSession(in, session, error);
+}
+
+} // namespace pjson
@@ -0,0 +1,179 @@
+#include "pjson_editor/TimelineHotBlock.h"
+#include "pjson_editor/TimelineKernels.h"
+#include <algorithm>
+
+namespace pjson {
+
+namespace {
+
+// A/b-rolls carry their in-scene offset; voice-overs only have the project
+// offset, so theirs is taken relative to the scene as it is now.
+int32_t inSceneOffset(const ExtendedTimeline &timeline, int32_t) {
+    return timeline.timeOffsetInScene;
+}
+
+int32_t inSceneOffset(const VoiceOver &voiceOver, int32_t sceneOffset) {
+    return voiceOver.timeOffsetInProject - sceneOffset;
+}
+
+size_t timelineCount(const ExtendedProjectScene &scene) {
+    return scene.aRolls.size() + scene.bRolls.size() + scene.voiceOvers.size();
+}
+
+// Makes room for `grow` more (or -grow fewer) entries in front of `at`.
+template <typename T>
+void resizeSegment(std::vector<T> &column, size_t at, std::ptrdiff_t grow) {
+    if (grow > 0) {
+        column.insert(column.begin() + at, static_cast<size_t>(grow), T{});
+    } else if (grow < 0) {
+        column.erase(column.begin() + (at + grow), column.begin() + at);
+    }
+}
+
+// Fills entries [i, i + items.size()) from `items`; returns the next entry.
+template <typename T>
+size_t storeTrack(TimelineHotBlock &block, std::vector<int *> &slots, std::vector<T> &items,
+                  TimelineTrack track, int32_t sceneIdx, int32_t sceneOffset, size_t i) {
+    for (auto &item : items) {
+        block.offsets[i] = item.timeOffsetInProject;
+        block.offsetsInScene[i] = inSceneOffset(item, sceneOffset);
+        block.durations[i] = item.duration;
+        block.startTimes[i] = item.startTime;
+        block.endTimes[i] = item.endTime;
+        block.sceneIndex[i] = sceneIdx;
+        block.tracks[i] = track;
+        slots[i] = &item.timeOffsetInProject;
+        ++i;
+    }
+    return i;
+}
+
+size_t storeScene(TimelineHotBlock &block, std::vector<int *> &slots, ExtendedProjectScene &scene,
+                  int32_t sceneIdx, size_t i) {
+    const int32_t sceneOffset = scene.timeOffsetInProject;
+    i = storeTrack(block, slots, scene.aRolls, TimelineTrack::A_ROLL, sceneIdx, sceneOffset, i);
+    i = storeTrack(block, slots, scene.bRolls, TimelineTrack::B_ROLL, sceneIdx, sceneOffset, i);
+    return storeTrack(block, slots, scene.voiceOvers, TimelineTrack::VOICE_OVER, sceneIdx, sceneOffset, i);
+}
+
+} // namespace
+
+void TimelineHotBlock::clear() {
+    offsets.clear();
+    offsetsInScene.clear();
+    durations.clear();
+    startTimes.clear();
+    endTimes.clear();
+    sceneIndex.clear();
+    tracks.clear();
+    offsetSlots.clear();
+    sceneStart.clear();
+    layout.clear();
+    scenesData = nullptr;
+}
+
+TimelineHotBlock::SceneLayout TimelineHotBlock::layoutOf(const ExtendedProjectScene &scene) {
+    return {scene.aRolls.data(), scene.aRolls.size(),
+            scene.bRolls.data(), scene.bRolls.size(),
+            scene.voiceOvers.data(), scene.voiceOvers.size()};
+}
+
+void TimelineHotBlock::build(std::vector<ExtendedProjectScene> &scenes) {
+    clear();
+    size_t total = 0;
+    for (const auto &scene : scenes) {
+        total += timelineCount(scene);
+    }
+    offsets.resize(total);
+    offsetsInScene.resize(total);
+    durations.resize(total);
+    startTimes.resize(total);
+    endTimes.resize(total);
+    sceneIndex.resize(total);
+    tracks.resize(total);
+    offsetSlots.resize(total);
+    sceneStart.reserve(scenes.size() + 1);
+    layout.reserve(scenes.size());
+
+    size_t next = 0;
+    for (size_t s = 0; s < scenes.size(); ++s) {
+        sceneStart.push_back(next);
+        next = storeScene(*this, offsetSlots, scenes[s], static_cast<int32_t>(s), next);
+        layout.push_back(layoutOf(scenes[s]));
+    }
+    sceneStart.push_back(next);
+    scenesData = scenes.data();
+}
+
+void TimelineHotBlock::refreshScene(std::vector<ExtendedProjectScene> &scenes, size_t scene) {
+    if (scene >= sceneCount() || scene >= scenes.size()) {
+        return;
+    }
+    const size_t end = sceneStart[scene + 1];
+    const std::ptrdiff_t grow = static_cast<std::ptrdiff_t>(timelineCount(scenes[scene])) -
+                                static_cast<std::ptrdiff_t>(end - sceneStart[scene]);
+    if (grow != 0) {
+        resizeSegment(offsets, end, grow);
+        resizeSegment(offsetsInScene, end, grow);
+        resizeSegment(durations, end, grow);
+        resizeSegment(startTimes, end, grow);
+        resizeSegment(endTimes, end, grow);
+        resizeSegment(sceneIndex, end, grow);
+        resizeSegment(tracks, end, grow);
+        resizeSegment(offsetSlots, end, grow);
+        for (size_t s = scene + 1; s < sceneStart.size(); ++s) {
+            sceneStart[s] += grow;
+        }
+    }
+    storeScene(*this, offsetSlots, scenes[scene], static_cast<int32_t>(scene), sceneStart[scene]);
+    layout[scene] = layoutOf(scenes[scene]);
+}
+
+bool TimelineHotBlock::matches(const std::vector<ExtendedProjectScene> &scenes) const {
+    if (scenesData != scenes.data() || layout.size() != scenes.size()) {
+        return false;
+    }
+    for (size_t s = 0; s < scenes.size(); ++s) {
+        const auto &scene = scenes[s];
+        const auto &l = layout[s];
+        if (l.aRolls != scene.aRolls.data() || l.aRollCount != scene.aRolls.size() ||
+            l.bRolls != scene.bRolls.data() || l.bRollCount != scene.bRolls.size() ||
+            l.voiceOvers != scene.voiceOvers.data() || l.voiceOverCount != scene.voiceOvers.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TimelineHotBlock::shiftScenes(size_t beginScene, size_t endScene, int32_t delta) {
+    endScene = std::min(endScene, sceneCount());
+    if (delta == 0 || beginScene >= endScene) {
+        return;
+    }
+    const size_t begin = sceneStart[beginScene];
+    const size_t end = sceneStart[endScene];
+    timelineKernels().addDelta(offsets.data() + begin, end - begin, delta);
+    writeBackOffsets(begin, end);
+}
+
+void TimelineHotBlock::rebaseOnScenes(const std::vector<int32_t> &sceneOffsets) {
+    const size_t n = offsets.size();
+    int32_t *out = offsets.data();
+    const int32_t *inScene = offsetsInScene.data();
+    const int32_t *scene = sceneIndex.data();
+    for (size_t i = 0; i < n; ++i) {
+        const int32_t offset = sceneOffsets[scene[i]] + inScene[i];
+        if (out[i] != offset) {
+            out[i] = offset;
+            *offsetSlots[i] = offset;
+        }
+    }
+}
+
+void TimelineHotBlock::writeBackOffsets(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        *offsetSlots[i] = offsets[i];
+    }
+}
+
+} // namespace pjson
@@ -0,0 +1,188 @@
+#include "pjson_editor/TimelineIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace pjson {
+
+namespace {
+
+// As in TimelineHotBlock: voice-overs only carry their project offset.
+int32_t inSceneOffset(const ExtendedTimeline &timeline, const ExtendedProjectScene &) {
+    return timeline.timeOffsetInScene;
+}
+
+int32_t inSceneOffset(const VoiceOver &voiceOver, const ExtendedProjectScene &scene) {
+    return voiceOver.timeOffsetInProject - scene.timeOffsetInProject;
+}
+
+template <typename Interval>
+int32_t buildMaxEnd(const std::vector<Interval> &intervals, std::vector<int32_t> &maxEnd,
+                    size_t lo, size_t hi) {
+    if (lo >= hi) {
+        return INT32_MIN;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    maxEnd[mid] = std::max({intervals[mid].end, buildMaxEnd(intervals, maxEnd, lo, mid),
+                            buildMaxEnd(intervals, maxEnd, mid + 1, hi)});
+    return maxEnd[mid];
+}
+
+// Calls f(interval) for every interval of `tree` overlapping [begin, end),
+// in order of begin.
+template <typename Tree, typename F>
+void visitOverlaps(const Tree &tree, size_t lo, size_t hi, int32_t begin, int32_t end, F &f) {
+    if (lo >= hi) {
+        return;
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    if (tree.maxEnd[mid] <= begin) {
+        return;
+    }
+    visitOverlaps(tree, lo, mid, begin, end, f);
+    const auto &interval = tree.intervals[mid];
+    if (interval.begin >= end) {
+        return;
+    }
+    if (interval.end > begin) {
+        f(interval);
+    }
+    visitOverlaps(tree, mid + 1, hi, begin, end, f);
+}
+
+} // namespace
+
+void TimelineIndex::SceneTree::build(const ExtendedProjectScene &scene) {
+    uuid = scene.uuid;
+    intervals.clear();
+    auto add = [this, &scene](const auto &items, TimelineTrack track) {
+        for (size_t i = 0; i < items.size(); ++i) {
+            const int32_t begin = inSceneOffset(items[i], scene);
+            if (items[i].duration > 0) {
+                intervals.push_back({begin, begin + items[i].duration, track,
+                                     static_cast<uint32_t>(i)});
+            }
+        }
+    };
+    add(scene.aRolls, TimelineTrack::A_ROLL);
+    add(scene.bRolls, TimelineTrack::B_ROLL);
+    add(scene.voiceOvers, TimelineTrack::VOICE_OVER);
+    std::stable_sort(intervals.begin(), intervals.end(),
+                     [](const Interval &a, const Interval &b) { return a.begin < b.begin; });
+    maxEnd.assign(intervals.size(), 0);
+    buildMaxEnd(intervals, maxEnd, 0, intervals.size());
+}
+
+void TimelineIndex::update(const std::vector<ExtendedProjectScene> &scenes,
+                           const SceneChangeSet &changes) {
+    sceneStarts.resize(scenes.size());
+    sceneEnds.resize(scenes.size());
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        sceneStarts[i] = scenes[i].timeOffsetInProject;
+        sceneEnds[i] = scenes[i].timeOffsetInProject + std::max(scenes[i].duration, 0);
+    }
+
+    lastRebuilt = 0;
+    if (!changes.all && !changes.sceneList && trees.size() == scenes.size()) {
+        std::vector<size_t> changed = changes.sceneIndices;
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        for (size_t i : changed) {
+            if (i < scenes.size()) {
+                trees[i].build(scenes[i]);
+                ++lastRebuilt;
+            }
+        }
+        return;
+    }
+
+    std::unordered_map<std::string, size_t> previous;
+    if (!changes.all) {
+        previous.reserve(trees.size());
+        for (size_t i = 0; i < trees.size(); ++i) {
+            previous.emplace(trees[i].uuid, i);
+        }
+        for (const auto &uuid : changes.sceneUuids) {
+            previous.erase(uuid);
+        }
+    }
+    std::vector<SceneTree> updated(scenes.size());
+    for (size_t i = 0; i < scenes.size(); ++i) {
+        auto it = previous.find(scenes[i].uuid);
+        if (it != previous.end()) {
+            updated[i] = std::move(trees[it->second]);
+            previous.erase(it);  // a duplicated uuid gets its own tree
+        } else {
+            updated[i].build(scenes[i]);
+            ++lastRebuilt;
+        }
+    }
+    trees = std::move(updated);
+}
+
+void TimelineIndex::clear() {
+    sceneStarts.clear();
+    sceneEnds.clear();
+    trees.clear();
+    lastRebuilt = 0;
+}
+
+size_t TimelineIndex::sceneAt(int32_t timeMs) const {
+    auto it = std::upper_bound(sceneStarts.begin(), sceneStarts.end(), timeMs);
+    if (it == sceneStarts.begin()) {
+        return SIZE_MAX;
+    }
+    const size_t scene = static_cast<size_t>(it - sceneStarts.begin()) - 1;
+    return timeMs < sceneEnds[scene] ? scene : SIZE_MAX;
+}
+
+TimelineQueryResult TimelineIndex::activeAt(int32_t timeMs) const {
+    if (timeMs == INT32_MAX) {
+        return {};
+    }
+    return rangeQuery(timeMs, timeMs + 1);
+}
+
+TimelineQueryResult TimelineIndex::rangeQuery(int32_t beginMs, int32_t endMs) const {
+    TimelineQueryResult result;
+    if (endMs <= beginMs) {
+        return result;
+    }
+    // Scenes are contiguous and in order, so both bounds are sorted.
+    const size_t first = static_cast<size_t>(
+        std::upper_bound(sceneEnds.begin(), sceneEnds.end(), beginMs) - sceneEnds.begin());
+    const size_t last = static_cast<size_t>(
+        std::lower_bound(sceneStarts.begin(), sceneStarts.end(), endMs) - sceneStarts.begin());
+    if (first >= last) {
+        return result;
+    }
+    result.sceneBegin = first;
+    result.sceneEnd = last;
+    for (size_t scene = first; scene < last; ++scene) {
+        collect(scene, beginMs, endMs, result);
+    }
+    return result;
+}
+
+void TimelineIndex::collect(size_t scene, int32_t beginMs, int32_t endMs,
+                            TimelineQueryResult &result) const {
+    const int32_t sceneStart = sceneStarts[scene];
+    const int32_t sceneLength = sceneEnds[scene] - sceneStart;
+    // The query in scene time, cut to the scene.
+    const int32_t begin = std::max(beginMs - sceneStart, 0);
+    const int32_t end = std::min(endMs - sceneStart, sceneLength);
+    if (begin >= end) {
+        return;
+    }
+    auto emit = [&result, scene, sceneStart, sceneLength](const Interval &interval) {
+        result.timelines.push_back({interval.track, scene, interval.index,
+                                    sceneStart + std::max(interval.begin, 0),
+                                    sceneStart + std::min(interval.end, sceneLength)});
+    };
+    const SceneTree &tree = trees[scene];
+    visitOverlaps(tree, 0, tree.intervals.size(), begin, end, emit);
+}
+
+} // namespace pjson
@@ -0,0 +1,279 @@
+#include "pjson_editor/TimelineKernels.h"
+
+#if !defined(PJSON_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PJSON_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if !defined(PJSON_NO_SIMD) && defined(__wasm_simd128__)
+#define PJSON_KERNELS_WASM 1
+#include <wasm_simd128.h>
+#endif
+
+namespace pjson {
+
+namespace {
+
+// Offsets are added with wrap-around in every variant, so overflow behaves
+// the same with and without SIMD.
+inline int32_t wrapAdd(int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+}
+
+// ---- scalar -----------------------------------------------------------------
+
+void addDeltaScalar(int32_t *values, size_t n, int32_t delta) {
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = wrapAdd(values[i], delta);
+    }
+}
+
+ptrdiff_t findOverlapScalar(const int32_t *starts, const int32_t *ends, size_t n,
+                            int32_t start, int32_t end) {
+    for (size_t i = 0; i < n; ++i) {
+        if (starts[i] < end && start < ends[i]) {
+            return static_cast<ptrdiff_t>(i);
+        }
+    }
+    return -1;
+}
+
+size_t clampEndTimesScalar(const int32_t *startTimes, int32_t *endTimes, int32_t *durations,
+                           size_t n, int32_t maxDuration) {
+    size_t clamped = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t limit = wrapAdd(startTimes[i], maxDuration);
+        if (endTimes[i] > limit) {
+            endTimes[i] = limit;
+            durations[i] = maxDuration;
+            ++clamped;
+        }
+    }
+    return clamped;
+}
+
+const TimelineKernels kScalar = {KernelIsa::SCALAR, "scalar", addDeltaScalar,
+                                 findOverlapScalar, clampEndTimesScalar};
+
+#ifdef PJSON_KERNELS_X86
+
+// ---- SSE4.1 -----------------------------------------------------------------
+
+__attribute__((target("sse4.1"))) void addDeltaSse41(int32_t *values, size_t n, int32_t delta) {
+    const __m128i d = _mm_set1_epi32(delta);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i *p = reinterpret_cast<__m128i *>(values + i);
+        _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), d));
+    }
+    addDeltaScalar(values + i, n - i, delta);
+}
+
+__attribute__((target("sse4.1"))) ptrdiff_t findOverlapSse41(const int32_t *starts,
+                                                              const int32_t *ends, size_t n,
+                                                              int32_t start, int32_t end) {
+    const __m128i s = _mm_set1_epi32(start);
+    const __m128i e = _mm_set1_epi32(end);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i st = _mm_loadu_si128(reinterpret_cast<const __m128i *>(starts + i));
+        __m128i en = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ends + i));
+        __m128i hit = _mm_and_si128(_mm_cmpgt_epi32(e, st), _mm_cmpgt_epi32(en, s));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hit));
+        if (mask) {
+            return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+        }
+    }
+    ptrdiff_t tail = findOverlapScalar(starts + i, ends + i, n - i, start, end);
+    return tail < 0 ? -1 : static_cast<ptrdiff_t>(i) + tail;
+}
+
+__attribute__((target("sse4.1"))) size_t clampEndTimesSse41(const int32_t *startTimes,
+                                                             int32_t *endTimes, int32_t *durations,
+                                                             size_t n, int32_t maxDuration) {
+    const __m128i maxDur = _mm_set1_epi32(maxDuration);
+    size_t clamped = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i *endPtr = reinterpret_cast<__m128i *>(endTimes + i);
+        __m128i *durPtr = reinterpret_cast<__m128i *>(durations + i);
+        __m128i limit = _mm_add_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(startTimes + i)), maxDur);
+        __m128i en = _mm_loadu_si128(endPtr);
+        __m128i over = _mm_cmpgt_epi32(en, limit);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(over));
+        if (mask) {
+            _mm_storeu_si128(endPtr, _mm_min_epi32(en, limit));
+            _mm_storeu_si128(durPtr, _mm_blendv_epi8(_mm_loadu_si128(durPtr), maxDur, over));
+            clamped += static_cast<size_t>(__builtin_popcount(mask));
+        }
+    }
+    return clamped + clampEndTimesScalar(startTimes + i, endTimes + i, durations + i, n - i,
+                                         maxDuration);
+}
+
+const TimelineKernels kSse41 = {KernelIsa::SSE41, "sse4.1", addDeltaSse41, findOverlapSse41,
+                                clampEndTimesSse41};
+
+// ---- AVX2 -------------------------------------------------------------------
+
+__attribute__((target("avx2"))) void addDeltaAvx2(int32_t *values, size_t n, int32_t delta) {
+    const __m256i d = _mm256_set1_epi32(delta);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i *p = reinterpret_cast<__m256i *>(values + i);
+        _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), d));
+    }
+    addDeltaScalar(values + i, n - i, delta);
+}
+
+__attribute__((target("avx2"))) ptrdiff_t findOverlapAvx2(const int32_t *starts,
+                                                           const int32_t *ends, size_t n,
+                                                           int32_t start, int32_t end) {
+    const __m256i s = _mm256_set1_epi32(start);
+    const __m256i e = _mm256_set1_epi32(end);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i st = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(starts + i));
+        __m256i en = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ends + i));
+        __m256i hit = _mm256_and_si256(_mm256_cmpgt_epi32(e, st), _mm256_cmpgt_epi32(en, s));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(hit));
+        if (mask) {
+            return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+        }
+    }
+    ptrdiff_t tail = findOverlapScalar(starts + i, ends + i, n - i, start, end);
+    return tail < 0 ? -1 : static_cast<ptrdiff_t>(i) + tail;
+}
+
+__attribute__((target("avx2"))) size_t clampEndTimesAvx2(const int32_t *startTimes,
+                                                          int32_t *endTimes, int32_t *durations,
+                                                          size_t n, int32_t maxDuration) {
+    const __m256i maxDur = _mm256_set1_epi32(maxDuration);
+    size_t clamped = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i *endPtr = reinterpret_cast<__m256i *>(endTimes + i);
+        __m256i *durPtr = reinterpret_cast<__m256i *>(durations + i);
+        __m256i limit = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(startTimes + i)), maxDur);
+        __m256i en = _mm256_loadu_si256(endPtr);
+        __m256i over = _mm256_cmpgt_epi32(en, limit);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(over));
+        if (mask) {
+            _mm256_storeu_si256(endPtr, _mm256_min_epi32(en, limit));
+            _mm256_storeu_si256(durPtr,
+                                _mm256_blendv_epi8(_mm256_loadu_si256(durPtr), maxDur, over));
+            clamped += static_cast<size_t>(__builtin_popcount(mask));
+        }
+    }
+    return clamped + clampEndTimesScalar(startTimes + i, endTimes + i, durations + i, n - i,
+                                         maxDuration);
+}
+
+const TimelineKernels kAvx2 = {KernelIsa::AVX2, "avx2", addDeltaAvx2, findOverlapAvx2,
+                               clampEndTimesAvx2};
+
+#endif // PJSON_KERNELS_X86
+
+#ifdef PJSON_KERNELS_WASM
+
+// ---- WebAssembly SIMD128 ----------------------------------------------------
+
+void addDeltaWasm(int32_t *values, size_t n, int32_t delta) {
+    const v128_t d = wasm_i32x4_splat(delta);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(values + i, wasm_i32x4_add(wasm_v128_load(values + i), d));
+    }
+    addDeltaScalar(values + i, n - i, delta);
+}
+
+ptrdiff_t findOverlapWasm(const int32_t *starts, const int32_t *ends, size_t n, int32_t start,
+                          int32_t end) {
+    const v128_t s = wasm_i32x4_splat(start);
+    const v128_t e = wasm_i32x4_splat(end);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t hit = wasm_v128_and(wasm_i32x4_lt(wasm_v128_load(starts + i), e),
+                                   wasm_i32x4_gt(wasm_v128_load(ends + i), s));
+        uint32_t mask = wasm_i32x4_bitmask(hit);
+        if (mask) {
+            return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+        }
+    }
+    ptrdiff_t tail = findOverlapScalar(starts + i, ends + i, n - i, start, end);
+    return tail < 0 ? -1 : static_cast<ptrdiff_t>(i) + tail;
+}
+
+size_t clampEndTimesWasm(const int32_t *startTimes, int32_t *endTimes, int32_t *durations,
+                         size_t n, int32_t maxDuration) {
+    const v128_t maxDur = wasm_i32x4_splat(maxDuration);
+    size_t clamped = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t limit = wasm_i32x4_add(wasm_v128_load(startTimes + i), maxDur);
+        v128_t en = wasm_v128_load(endTimes + i);
+        v128_t over = wasm_i32x4_gt(en, limit);
+        uint32_t mask = wasm_i32x4_bitmask(over);
+        if (mask) {
+            wasm_v128_store(endTimes + i, wasm_i32x4_min(en, limit));
+            wasm_v128_store(durations + i,
+                            wasm_v128_bitselect(maxDur, wasm_v128_load(durations + i), over));
+            clamped += static_cast<size_t>(__builtin_popcount(mask));
+        }
+    }
+    return clamped + clampEndTimesScalar(startTimes + i, endTimes + i, durations + i, n - i,
+                                         maxDuration);
+}
+
+const TimelineKernels kWasm = {KernelIsa::WASM_SIMD128, "wasm-simd128", addDeltaWasm,
+                               findOverlapWasm, clampEndTimesWasm};
+
+#endif // PJSON_KERNELS_WASM
+
+const TimelineKernels &selectKernels() {
+#ifdef PJSON_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return kAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return kSse41;
+    }
+#endif
+#ifdef PJSON_KERNELS_WASM
+    return kWasm;
+#endif
+    return kScalar;
+}
+
+} // namespace
+
+const TimelineKernels &timelineKernels() {
+    static const TimelineKernels &selected = selectKernels();
+    return selected;
+}
+
+const TimelineKernels *timelineKernelsFor(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::SCALAR:
+        return &kScalar;
+#ifdef PJSON_KERNELS_X86
+    case KernelIsa::SSE41:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1") ? &kSse41 : nullptr;
+    case KernelIsa::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? &kAvx2 : nullptr;
+#endif
+#ifdef PJSON_KERNELS_WASM
+    case KernelIsa::WASM_SIMD128:
+        return &kWasm;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace pjson
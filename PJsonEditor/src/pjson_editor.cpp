@@ -1,12 +1,19 @@
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <chrono>
 #include <functional>
-#include <iostream>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <pjson_editor/AllocStats.h>
 #include <pjson_editor/ApiMessage.h>
 #include <pjson_editor/ExtendedAPI.h>
 #include <pjson_editor/ExtendedModels.h>
+#include <pjson_editor/JsonReader.h>
+#include <pjson_editor/OpLog.h>
+#include <pjson_editor/ProjectCheckpoint.h>
+#include <pjson_editor/SessionRecorder.h>
 #include <pjson_editor/pjson_editor.hpp>
-#include <regex>
 #include <vector>
 
 namespace pjson {
@@ -15,9 +22,10 @@ namespace pjson {
 using RouteHandler =
     std::function<Response(ExtendedControllerAPI *, const Request &)>;
 
-// Route structure
+// Route structure. `path` is matched segment by segment; a `*` segment
+// matches any one non-empty segment.
 struct Route {
-  std::regex pattern;
+  const char *path;
   std::string method;
   RouteHandler handler;
 };
@@ -25,6 +33,9 @@ struct Route {
 // Forward declarations
 Response createSuccessResponse(ApiResult &&result);
 Response createErrorResponse(int statusCode, const std::string &message);
+Response createNotModifiedResponse(int version);
+std::string versionTag(int version);
+std::optional<int> knownVersion(const Request &req);
 
 // Template function to create handlers for different request body types
 template <typename ReqBodyType>
@@ -32,42 +43,113 @@ RouteHandler
 createHandler(ApiResult (ExtendedControllerAPI::*method)(const ReqBodyType &)) {
   return [method](ExtendedControllerAPI *controller,
                   const Request &req) -> Response {
-    try {
-      ReqBodyType reqBody(req.body);
-      ApiResult result = (controller->*method)(reqBody);
-      return createSuccessResponse(std::move(result));
-    } catch (const std::exception &e) {
+    Expected<ReqBodyType> reqBody = decodeBody<ReqBodyType>(req.body);
+    if (!reqBody) {
       return createErrorResponse(400, "Invalid request body: " +
-                                          std::string(e.what()));
+                                          reqBody.error());
     }
+    ApiResult result = (controller->*method)(*reqBody);
+    if (result.isSuccess()) {
+      controller->recordChange(result.patch);
+    }
+    Response resp = createSuccessResponse(std::move(result));
+    resp.headers["ETag"] =
+        versionTag(controller->getCurrentProjectData().version);
+    return resp;
   };
 }
 
+// GET the whole project. With If-None-Match: 304 when nothing changed,
+// otherwise only what changed since that version.
+Response readProject(ExtendedControllerAPI *controller, const Request &req) {
+  const int version = controller->getCurrentProjectData().version;
+  std::optional<int> known = knownVersion(req);
+  if (known && *known == version) {
+    return createNotModifiedResponse(version);
+  }
+  nlohmann::json data =
+      known && *known < version
+          ? controller->convertProjectToProjectAndScenesVoSince(*known)
+          : controller->convertProjectToProjectAndScenesVo();
+  Response resp = createSuccessResponse(
+      ApiResult::success(nlohmann::json::array(), std::move(data)));
+  resp.headers["ETag"] = versionTag(version);
+  return resp;
+}
+
+// GET one scene; its tag is the last version that changed the scene or
+// anything shared with other scenes.
+Response readScene(ExtendedControllerAPI *controller, const Request &req) {
+  const std::string sceneUuid = req.url.substr(req.url.rfind('/') + 1);
+  const auto &project = controller->getCurrentProjectData();
+  auto sceneIt = std::find_if(
+      project.scenes.begin(), project.scenes.end(),
+      [&sceneUuid](const ExtendedProjectScene &s) { return s.uuid == sceneUuid; });
+  if (sceneIt == project.scenes.end()) {
+    return createSuccessResponse(
+        ApiResult::error(ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND));
+  }
+  const int version = std::max(sceneIt->version, project.sharedVersion);
+  std::optional<int> known = knownVersion(req);
+  if (known && *known == version) {
+    return createNotModifiedResponse(version);
+  }
+  Response resp = createSuccessResponse(ApiResult::success(
+      nlohmann::json::array(),
+      controller->convertProjectToProjectAndSceneVo(sceneUuid)));
+  resp.headers["ETag"] = versionTag(version);
+  return resp;
+}
+
+// GET the change feed after body.cursor, at most body.limit records.
+Response readChanges(ExtendedControllerAPI *controller, const Request &req) {
+  uint64_t cursor = 0;
+  uint64_t limit = SIZE_MAX;
+  JsonReader in(req.body);
+  in.read("cursor", cursor).read("limit", limit);
+  if (!in.ok()) {
+    return createErrorResponse(400, "Invalid request body: " + in.error());
+  }
+  return createSuccessResponse(ApiResult::success(
+      nlohmann::json::array(),
+      controller->changesSince(cursor, static_cast<size_t>(limit))));
+}
+
 // Static route table with member function pointers
 static std::vector<Route> routes = {
     // POST routes using member function pointers
-    {std::regex(R"(/v3/project/[^/]+/scene/add)"), "POST",
+    {"/v3/project/*/scene/add", "POST",
      createHandler(&ExtendedControllerAPI::addScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/rename)"), "PUT",
+    {"/v3/project/*/scene/rename", "PUT",
      createHandler(&ExtendedControllerAPI::renameScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/move)"), "POST",
+    {"/v3/project/*/scene/move", "POST",
      createHandler(&ExtendedControllerAPI::moveScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/time/set)"), "POST",
+    {"/v3/project/*/scene/time/set", "POST",
      createHandler(&ExtendedControllerAPI::setSceneTime)},
-    {std::regex(R"(/v3/project/[^/]+/scene/cut)"), "POST",
+    {"/v3/project/*/scene/cut", "POST",
      createHandler(&ExtendedControllerAPI::cutScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/split)"), "PUT",
+    {"/v3/project/*/scene/split", "PUT",
      createHandler(&ExtendedControllerAPI::splitScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/merge)"), "PUT",
+    {"/v3/project/*/scene/merge", "PUT",
      createHandler(&ExtendedControllerAPI::mergeScenes)},
-    {std::regex(R"(/v3/project/[^/]+/scene/delete)"), "DELETE",
+    {"/v3/project/*/scene/delete", "DELETE",
      createHandler(&ExtendedControllerAPI::deleteScene)},
-    {std::regex(R"(/v3/project/[^/]+/scene/[^/]+/audio/add)"), "POST",
+    {"/v3/project/*/scene/*/audio/add", "POST",
      createHandler(&ExtendedControllerAPI::addSceneAudio)},
-    {std::regex(R"(/v3/project/[^/]+/scene/[^/]+/transition/set)"), "POST",
+    {"/v3/project/*/scene/*/transition/set", "POST",
      createHandler(&ExtendedControllerAPI::setSceneTransition)},
-    {std::regex(R"(/v3/project/[^/]+/scene/[^/]+/script/edit)"), "POST",
+    {"/v3/project/*/scene/*/script/edit", "POST",
      createHandler(&ExtendedControllerAPI::editScript)},
+    {"/v3/project/*/asset/replace", "PUT",
+     createHandler(&ExtendedControllerAPI::replaceAsset)},
+    {"/v3/project/*/asset/prune", "DELETE",
+     createHandler(&ExtendedControllerAPI::pruneAssets)},
+    {"/v3/project/*/batch", "POST",
+     createHandler(&ExtendedControllerAPI::batch)},
+    // Read routes
+    {"/v3/project/*/scenes", "GET", readProject},
+    {"/v3/project/*/scene/*", "GET", readScene},
+    {"/v3/project/*/changes", "GET", readChanges},
 };
 
 PJsonEditor::PJsonEditor(const nlohmann::json &scene_list_resp) {
@@ -80,16 +162,36 @@ PJsonEditor::PJsonEditor(const nlohmann::json &scene_list_resp) {
   std::shared_ptr<ExtendedDataStore> sharedDataStore(
       dataStore.get(), [](ExtendedDataStore *) {});
   controller->setDataStore(sharedDataStore);
+  // Time for v7 ids advances once per call (see call()), so a logged id
+  // state replays to the same ids.
+  controller->getIdGenerator().setAutoClock(false);
+}
+
+PJsonEditor::~PJsonEditor() = default;
+
+// True when `url` has exactly the segments of `pattern`.
+bool matchPath(const char *pattern, const std::string &url) {
+  auto it = url.begin();
+  for (const char *p = pattern; *p != '\0'; ++p) {
+    if (*p == '*') {
+      auto segmentEnd = std::find(it, url.end(), '/');
+      if (segmentEnd == it) {
+        return false;
+      }
+      it = segmentEnd;
+    } else if (it == url.end() || *it++ != *p) {
+      return false;
+    }
+  }
+  return it == url.end();
 }
 
 // Route request using the route table
 Response routeRequest(ExtendedControllerAPI *controller, const Request &req) {
-  std::cout << req.method << " " << req.url << std::endl;
-
   // Find matching route
   for (const auto &route : routes) {
-    if (route.method == req.method &&
-        std::regex_match(req.url, route.pattern)) {
+    if (route.method == req.method && matchPath(route.path, req.url)) {
+      PJSON_ALLOC_SCOPE(route.method + " " + route.path);
       return route.handler(controller, req);
     }
   }
@@ -100,7 +202,97 @@ Response routeRequest(ExtendedControllerAPI *controller, const Request &req) {
 }
 
 Response PJsonEditor::call(Request req) {
-  return routeRequest(controller.get(), req);
+  IdGenerator &ids = controller->getIdGenerator();
+  if (ids.version() == IdGenerator::Version::V7) {
+    ids.advanceTime(IdGenerator::systemTimeMs());
+  }
+  if (!recorder && !opLog) {
+    return routeRequest(controller.get(), req);
+  }
+  const int versionBefore = dataStore->getCurrentProjectData().version;
+  const IdGenerator::State idsBefore = ids.state();
+  auto start = std::chrono::steady_clock::now();
+  Response resp = routeRequest(controller.get(), req);
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  if (recorder) {
+    recorder->record(req, resp, elapsed.count());
+  }
+  const int version = dataStore->getCurrentProjectData().version;
+  if (opLog && version != versionBefore) {
+    opLog->appendOp(req, version, idsBefore);
+    if (opLog->checkpointDue()) {
+      writeCheckpoint();
+    }
+  }
+  return resp;
+}
+
+nlohmann::json PJsonEditor::allocStats() const {
+  return AllocStats::snapshot();
+}
+
+void PJsonEditor::resetAllocStats() { AllocStats::reset(); }
+
+IdGenerator &PJsonEditor::idGenerator() {
+  return controller->getIdGenerator();
+}
+
+nlohmann::json PJsonEditor::changesSince(uint64_t cursor,
+                                         size_t maxRecords) const {
+  return controller->changesSince(cursor, maxRecords);
+}
+
+void PJsonEditor::setSessionRecorder(
+    std::shared_ptr<SessionRecorder> sessionRecorder) {
+  recorder = std::move(sessionRecorder);
+}
+
+void PJsonEditor::setOpLog(std::shared_ptr<OpLog> log) {
+  opLog = std::move(log);
+  if (opLog) {
+    writeCheckpoint();
+  }
+}
+
+void PJsonEditor::writeCheckpoint() {
+  const auto &project = dataStore->getCurrentProjectData();
+  opLog->appendCheckpoint(project.version, controller->getIdGenerator().state(),
+                          encodeProjectCheckpoint(project));
+}
+
+bool PJsonEditor::recover(const RecoveredLog &log, std::string *error) {
+  auto fail = [error](const std::string &message) {
+    if (error) {
+      *error = message;
+    }
+    return false;
+  };
+  Expected<ExtendedProjectAndScenesVo> project =
+      decodeProjectCheckpoint(log.project);
+  if (!project) {
+    return fail("invalid checkpoint: " + project.error());
+  }
+  dataStore->init(
+      std::make_shared<ExtendedProjectAndScenesVo>(std::move(*project)));
+  IdGenerator &ids = controller->getIdGenerator();
+  ids.setState(log.ids);
+  // Replayed ops are not logged again: they go around call(). Their
+  // responses are dropped, so handlers skip building result data.
+  controller->setResultDataSuppressed(true);
+  for (size_t i = 0; i < log.ops.size(); ++i) {
+    const LoggedOp &op = log.ops[i];
+    ids.setState(op.ids);
+    routeRequest(controller.get(), op.request);
+    if (dataStore->getCurrentProjectData().version != op.version) {
+      controller->setResultDataSuppressed(false);
+      return fail("op " + std::to_string(i) + " (" + op.request.method + " " +
+                  op.request.url + ") did not reach version " +
+                  std::to_string(op.version));
+    }
+  }
+  controller->setResultDataSuppressed(false);
+  return true;
 }
 
 // Helper function to create success response
@@ -119,10 +311,47 @@ Response createSuccessResponse(ApiResult &&result) {
     resp.status_code = 400;
     resp.body["code"] = -1;
     resp.body["msg"] = ApiMessageHelper::getMessage(result.apiMessage);
+    if (!result.data.empty()) {
+      resp.body["data"] = std::move(result.data);
+    }
   }
   return resp;
 }
 
+Response createNotModifiedResponse(int version) {
+  Response resp;
+  resp.status_code = 304;
+  resp.headers["ETag"] = versionTag(version);
+  resp.body = nlohmann::json::object();
+  return resp;
+}
+
+std::string versionTag(int version) {
+  return "\"" + std::to_string(version) + "\"";
+}
+
+// The version from an If-None-Match header: 12, "12" or W/"12".
+std::optional<int> knownVersion(const Request &req) {
+  auto it = req.headers.find("If-None-Match");
+  if (it == req.headers.end()) {
+    it = req.headers.find("if-none-match");
+  }
+  if (it == req.headers.end()) {
+    return std::nullopt;
+  }
+  std::string tag = it->second;
+  if (tag.compare(0, 2, "W/") == 0) {
+    tag.erase(0, 2);
+  }
+  tag.erase(std::remove(tag.begin(), tag.end(), '"'), tag.end());
+  if (tag.empty() || tag.size() > 9 ||
+      !std::all_of(tag.begin(), tag.end(),
+                   [](unsigned char c) { return std::isdigit(c); })) {
+    return std::nullopt;
+  }
+  return std::stoi(tag);
+}
+
 // Helper function to create error response
 Response createErrorResponse(int statusCode, const std::string &message) {
   Response resp;
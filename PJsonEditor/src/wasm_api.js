@@ -0,0 +1,51 @@
+// JS side of src/wasm_bridge.cpp, appended to the generated module with
+// --post-js. Methods are assigned by quoted name so the closure compiler
+// keeps them.
+//
+//   const Module = await PJsonEditorModule();
+//   const editor = new Module.Editor(sceneListJsonText);
+//   editor.callJson({method: 'GET', url: '/v3/project/p1/scenes', body: {}});
+//   const view = editor.call(msgpackBytes);  // MessagePack response bytes
+//   editor.delete();
+
+var pjsonTextEncoder = new TextEncoder();
+var pjsonTextDecoder = new TextDecoder();
+
+function PJsonEditor(sceneList) {
+  var text = pjsonTextEncoder.encode(sceneList);
+  var at = _malloc(text.length);
+  HEAPU8.set(text, at);
+  this.handle = _pjson_editor_create(at, text.length);
+  _free(at);
+  if (!this.handle) {
+    throw new Error('PJsonEditor: scene list is not JSON');
+  }
+}
+
+PJsonEditor.prototype.send = function (bytes, call) {
+  HEAPU8.set(bytes, _pjson_editor_request_buffer(this.handle, bytes.length));
+  var size = call(this.handle, bytes.length);
+  // Take the view after the call: the heap may have grown during it.
+  var at = _pjson_editor_response(this.handle);
+  return HEAPU8.subarray(at, at + size);
+};
+
+// Request object in, response object {status, headers, body, patch} out.
+PJsonEditor.prototype['callJson'] = function (request) {
+  var view = this.send(pjsonTextEncoder.encode(JSON.stringify(request)),
+                       _pjson_editor_call_json);
+  return JSON.parse(pjsonTextDecoder.decode(view));
+};
+
+// MessagePack request bytes in, a view on the MessagePack response out. The
+// view is only valid until the next call on any editor.
+PJsonEditor.prototype['call'] = function (bytes) {
+  return this.send(bytes, _pjson_editor_call);
+};
+
+PJsonEditor.prototype['delete'] = function () {
+  _pjson_editor_destroy(this.handle);
+  this.handle = 0;
+};
+
+Module['Editor'] = PJsonEditor;
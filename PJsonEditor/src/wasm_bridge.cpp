@@ -0,0 +1,131 @@
+#include <emscripten/emscripten.h>
+
+#include <cstddef>
+#include <cstdint>
+#include "pjson_editor/BinaryBridge.h"
+#include "pjson_editor/pjson_editor.hpp"
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/proxying.h>
+#include <emscripten/threading.h>
+#include <utility>
+#include <vector>
+#include "pjson_editor/EditorWorker.h"
+#endif
+
+using namespace pjson;
+
+/**
+ * WebAssembly module around PJsonEditor::call.
+ *
+ * A plain C ABI rather than embind, so the module builds without RTTI and
+ * carries no binding tables. Every call goes through a BinaryBridge: JS
+ * writes the request into HEAPU8 at pjson_editor_request_buffer(), runs
+ * pjson_editor_call() (MessagePack) or pjson_editor_call_json() (JSON text)
+ * and reads the response from pjson_editor_response(). src/wasm_api.js wraps
+ * this as Module.Editor.
+ *
+ * The pthreads build (PJSON_WASM_THREADS) adds pjson_worker_*: the editor
+ * runs in an EditorWorker on its own thread, JS submits calls without
+ * waiting and drains the responses when the worker tells the main thread
+ * they are ready. src/wasm_worker_api.js wraps this as Module.EditorWorker.
+ */
+namespace {
+
+struct WasmEditor {
+    explicit WasmEditor(const nlohmann::json &sceneList) : editor(sceneList), bridge(editor) {}
+
+    PJsonEditor editor;
+    BinaryBridge bridge;
+};
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+struct WasmWorker;
+
+// Runs on the main thread. Only hands the handle to JS, which ignores
+// handles of workers deleted in the meantime.
+void notifyMainThread(void *handle) {
+    EM_ASM({ Module['pjsonWorkerReady']($0); }, handle);
+}
+
+struct WasmWorker {
+    explicit WasmWorker(nlohmann::json sceneList)
+        : worker(std::move(sceneList), [this] {
+              emscripten_proxy_async(emscripten_proxy_get_system_queue(),
+                                     emscripten_main_runtime_thread_id(), notifyMainThread, this);
+          }) {}
+
+    EditorWorker worker;
+    std::vector<uint8_t> response;  // the last one polled, until the next poll
+};
+
+#endif
+
+} // namespace
+
+extern "C" {
+
+// Editor for the scene list response in `size` bytes of JSON text at
+// `sceneList`; null when that is not JSON.
+EMSCRIPTEN_KEEPALIVE WasmEditor *pjson_editor_create(const char *sceneList, size_t size) {
+    nlohmann::json parsed = nlohmann::json::parse(sceneList, sceneList + size, nullptr, false);
+    if (parsed.is_discarded()) {
+        return nullptr;
+    }
+    return new WasmEditor(parsed);
+}
+
+EMSCRIPTEN_KEEPALIVE void pjson_editor_destroy(WasmEditor *handle) { delete handle; }
+
+EMSCRIPTEN_KEEPALIVE uint8_t *pjson_editor_request_buffer(WasmEditor *handle, size_t size) {
+    return handle->bridge.requestBuffer(size);
+}
+
+EMSCRIPTEN_KEEPALIVE size_t pjson_editor_call(WasmEditor *handle, size_t size) {
+    return handle->bridge.call(size);
+}
+
+EMSCRIPTEN_KEEPALIVE size_t pjson_editor_call_json(WasmEditor *handle, size_t size) {
+    return handle->bridge.callJson(size);
+}
+
+EMSCRIPTEN_KEEPALIVE const uint8_t *pjson_editor_response(WasmEditor *handle) {
+    return handle->bridge.responseData();
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+// Like pjson_editor_create(); the editor is built on the worker thread.
+EMSCRIPTEN_KEEPALIVE WasmWorker *pjson_worker_create(const char *sceneList, size_t size) {
+    nlohmann::json parsed = nlohmann::json::parse(sceneList, sceneList + size, nullptr, false);
+    if (parsed.is_discarded()) {
+        return nullptr;
+    }
+    return new WasmWorker(std::move(parsed));
+}
+
+// Blocks until the calls already submitted have run.
+EMSCRIPTEN_KEEPALIVE void pjson_worker_destroy(WasmWorker *handle) { delete handle; }
+
+// Copies the request; 0 when too many calls are pending, try again after
+// draining responses.
+EMSCRIPTEN_KEEPALIVE int pjson_worker_submit(WasmWorker *handle, const uint8_t *bytes,
+                                             size_t size, int json) {
+    EditorWorker::Call call{std::vector<uint8_t>(bytes, bytes + size), json != 0};
+    return handle->worker.submit(call) ? 1 : 0;
+}
+
+// Size of the next response, now at pjson_worker_response(); 0 if none is
+// ready.
+EMSCRIPTEN_KEEPALIVE size_t pjson_worker_poll(WasmWorker *handle) {
+    return handle->worker.poll(handle->response) ? handle->response.size() : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE const uint8_t *pjson_worker_response(WasmWorker *handle) {
+    return handle->response.data();
+}
+
+#endif
+
+} // extern "C"
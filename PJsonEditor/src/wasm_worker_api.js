@@ -0,0 +1,108 @@
+// JS side of the pjson_worker_* functions in src/wasm_bridge.cpp, appended
+// after src/wasm_api.js in the pthreads build (PJSON_WASM_THREADS).
+//
+//   const Module = await PJsonEditorModule();
+//   const worker = new Module.EditorWorker(sceneListJsonText);
+//   const resp = await worker.callJson({method: 'GET', url: '/v3/project/p1/scenes'});
+//   const bytes = await worker.call(msgpackBytes);  // MessagePack response
+//   worker.delete();
+//
+// Calls resolve in the order they were made. When the worker's queue is
+// full, further calls wait here and are submitted as responses come back.
+
+var pjsonWorkers = {};
+
+function PJsonEditorWorker(sceneList) {
+  var text = pjsonTextEncoder.encode(sceneList);
+  var at = _malloc(text.length);
+  HEAPU8.set(text, at);
+  this.handle = _pjson_worker_create(at, text.length);
+  _free(at);
+  if (!this.handle) {
+    throw new Error('PJsonEditor: scene list is not JSON');
+  }
+  this.submitted = [];  // calls the worker has, oldest first
+  this.backlog = [];    // calls waiting for room in the worker's queue
+  pjsonWorkers[this.handle] = this;
+}
+
+PJsonEditorWorker.prototype.submit = function (call) {
+  var at = _malloc(call.bytes.length);
+  HEAPU8.set(call.bytes, at);
+  var accepted = _pjson_worker_submit(this.handle, at, call.bytes.length, call.json ? 1 : 0);
+  _free(at);
+  if (accepted) {
+    this.submitted.push(call);
+  }
+  return accepted;
+};
+
+PJsonEditorWorker.prototype.enqueue = function (bytes, json) {
+  var self = this;
+  return new Promise(function (resolve, reject) {
+    if (!self.handle) {
+      reject(new Error('PJsonEditor: worker was deleted'));
+      return;
+    }
+    var call = {bytes: bytes, json: json, resolve: resolve, reject: reject};
+    if (self.backlog.length || !self.submit(call)) {
+      self.backlog.push(call);
+    }
+  });
+};
+
+// Resolves every call whose response is ready, then refills the queue.
+PJsonEditorWorker.prototype.drain = function () {
+  var size;
+  while ((size = _pjson_worker_poll(this.handle))) {
+    var at = _pjson_worker_response(this.handle);
+    // slice() copies out of the shared heap; TextDecoder refuses shared views.
+    var bytes = HEAPU8.slice(at, at + size);
+    var call = this.submitted.shift();
+    call.resolve(call.json ? JSON.parse(pjsonTextDecoder.decode(bytes)) : bytes);
+  }
+  while (this.backlog.length && this.submit(this.backlog[0])) {
+    this.backlog.shift();
+  }
+};
+
+// Request object in, a promise of the response object
+// {status, headers, body, patch} out.
+PJsonEditorWorker.prototype['callJson'] = function (request) {
+  return this.enqueue(pjsonTextEncoder.encode(JSON.stringify(request)), true);
+};
+
+// MessagePack request bytes in, a promise of the MessagePack response bytes
+// (a copy, valid for as long as the caller keeps it) out.
+PJsonEditorWorker.prototype['call'] = function (bytes) {
+  return this.enqueue(bytes, false);
+};
+
+// Resolves the calls answered so far and rejects the others. Blocks until
+// the worker has finished the calls it was given, so none is left half
+// applied.
+PJsonEditorWorker.prototype['delete'] = function () {
+  if (!this.handle) {
+    return;
+  }
+  var backlog = this.backlog;  // not submitted: keep drain() from doing it
+  this.backlog = [];
+  this.drain();
+  _pjson_worker_destroy(this.handle);
+  delete pjsonWorkers[this.handle];
+  this.handle = 0;
+  var pending = this.submitted.concat(backlog);
+  this.submitted = [];
+  pending.forEach(function (call) {
+    call.reject(new Error('PJsonEditor: worker was deleted'));
+  });
+};
+
+Module['pjsonWorkerReady'] = function (handle) {
+  var worker = pjsonWorkers[handle];
+  if (worker) {
+    worker.drain();
+  }
+};
+
+Module['EditorWorker'] = PJsonEditorWorker;
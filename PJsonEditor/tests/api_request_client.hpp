@@ -1,4 +1,5 @@
 #pragma once
+#include "fixture_backend.hpp"
 #include "http_client.hpp"
 #include <filesystem>
 #include <iostream>
@@ -10,13 +11,30 @@ class api_request_client {
 private:
   static const std::string BASE_URL;
   CurlHttpClient http_client;
+  FixtureBackend fixtures;
+  LatencyComparison latency;
   std::string auth_token;
   std::string project_uuid;
 
+  // Sends a request to the backend, or serves it from the fixtures when
+  // replaying. Records the exchange when recording.
+  nlohmann::json exchange(const std::string &method,
+                          const std::string &endpoint,
+                          const nlohmann::json &request_body);
+
 public:
   api_request_client() {
+    if (fixtures.replaying()) {
+      std::cout << "=== Replaying backend fixtures from "
+                << fixtures.directory() << " ===" << std::endl;
+      return;
+    }
     std::cout << "=== Real Server API Tester Initialized ===" << std::endl;
     std::cout << "Base URL: " << BASE_URL << std::endl;
+    if (fixtures.recording()) {
+      std::cout << "Recording backend fixtures to " << fixtures.directory()
+                << std::endl;
+    }
     // check if /tmp/TOKEN_FILE exists and last modified time is within 1 hour
     if (std::filesystem::exists("/tmp/TOKEN_FILE")) {
       std::cout << "/tmp/TOKEN_FILE exists, checking timestamp..." << std::endl;
@@ -35,6 +53,8 @@ public:
     }
   }
 
+  ~api_request_client() { latency.print(std::cout); }
+
   // Getter for auth token (for use in other tests)
   const std::string &getAuthToken() const { return auth_token; }
   const std::string &getProjectUuid() const { return project_uuid; }
@@ -52,4 +72,11 @@ public:
   del(const std::string &endpoint, const nlohmann::json &request_body) {
     return post(endpoint, request_body, "DELETE");
   }
+
+  // Latency of the matching local PJsonEditor call, for the backend vs local
+  // comparison printed when the client goes away.
+  void reportLocalLatency(const std::string &method,
+                          const std::string &endpoint, double us) {
+    latency.addLocal(method + " " + endpoint, us);
+  }
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+// Offline stand-in for the backend used by api_request_client.
+//
+// PJSON_BACKEND_MODE selects where backend responses come from:
+//   live    (default) call the server through curl
+//   record  call the server and write every exchange to PJSON_FIXTURE_DIR
+//   replay  serve the exchanges from PJSON_FIXTURE_DIR without any network
+//
+// Fixtures are numbered in call order ("0003_PUT_v3_project_..._rename.json"),
+// so a test replays exactly the sequence it recorded. Each file keeps the
+// request body, the response and the backend latency seen while recording.
+enum class BackendMode { LIVE, RECORD, REPLAY };
+
+class FixtureBackend {
+public:
+  FixtureBackend() : backendMode(modeFromEnv()), dir(directoryFromEnv()) {
+    if (backendMode == BackendMode::RECORD) {
+      std::filesystem::create_directories(dir);
+    }
+  }
+
+  BackendMode mode() const { return backendMode; }
+  bool recording() const { return backendMode == BackendMode::RECORD; }
+  bool replaying() const { return backendMode == BackendMode::REPLAY; }
+  const std::string &directory() const { return dir; }
+
+  // False when replay mode is selected but there is nothing to replay; the
+  // test binaries then exit with the ctest skip code.
+  static bool canRun() {
+    if (modeFromEnv() != BackendMode::REPLAY) {
+      return true;
+    }
+    std::error_code ec;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(directoryFromEnv(), ec)) {
+      if (entry.path().extension() == ".json") {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Serves the next recorded exchange. Returns false (and explains why on
+  // stderr) when the test diverged from the recording.
+  bool replay(const std::string &method, const std::string &endpoint,
+              const nlohmann::json &requestBody, nlohmann::json &response,
+              double &latencyUs) {
+    std::string path = nextPath(method, endpoint);
+    std::ifstream in(path);
+    if (!in.is_open()) {
+      std::cerr << "Fixture missing: " << path << std::endl;
+      return false;
+    }
+    nlohmann::json fixture = nlohmann::json::parse(in, nullptr, false);
+    if (fixture.is_discarded()) {
+      std::cerr << "Fixture unreadable: " << path << std::endl;
+      return false;
+    }
+    if (fixture.value("request", nlohmann::json()) != requestBody) {
+      std::cerr << "Fixture request mismatch: " << path << std::endl
+                << "  recorded: " << fixture.value("request", nlohmann::json())
+                << std::endl
+                << "  actual:   " << requestBody << std::endl;
+      return false;
+    }
+    response = fixture.value("response", nlohmann::json());
+    latencyUs = fixture.value("latencyUs", 0.0);
+    return true;
+  }
+
+  void record(const std::string &method, const std::string &endpoint,
+              const nlohmann::json &requestBody, const nlohmann::json &response,
+              int statusCode, double latencyUs) {
+    nlohmann::json fixture;
+    fixture["method"] = method;
+    fixture["endpoint"] = endpoint;
+    fixture["request"] = requestBody;
+    fixture["status"] = statusCode;
+    fixture["latencyUs"] = latencyUs;
+    fixture["response"] = response;
+    std::ofstream out(nextPath(method, endpoint));
+    out << fixture.dump(2) << '\n';
+  }
+
+private:
+  static BackendMode modeFromEnv() {
+    const char *mode = std::getenv("PJSON_BACKEND_MODE");
+    std::string value = mode ? mode : "";
+    if (value == "record") {
+      return BackendMode::RECORD;
+    }
+    if (value == "replay") {
+      return BackendMode::REPLAY;
+    }
+    return BackendMode::LIVE;
+  }
+
+  static std::string directoryFromEnv() {
+    const char *dir = std::getenv("PJSON_FIXTURE_DIR");
+    return dir && *dir ? dir : "fixtures";
+  }
+
+  std::string nextPath(const std::string &method, const std::string &endpoint) {
+    std::string slug;
+    for (char c : endpoint) {
+      bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                  (c >= '0' && c <= '9') || c == '-';
+      if (keep) {
+        slug += c;
+      } else if (!slug.empty() && slug.back() != '_') {
+        slug += '_';
+      }
+    }
+    char seq[16];
+    std::snprintf(seq, sizeof seq, "%04zu", sequence++);
+    return dir + "/" + seq + "_" + method + "_" + slug + ".json";
+  }
+
+  BackendMode backendMode;
+  std::string dir;
+  size_t sequence{0};
+};
+
+// Backend vs local (PJsonEditor) latency per endpoint. Backend numbers are
+// measured live or taken from the fixtures, so a replayed run still compares
+// against the server.
+class LatencyComparison {
+public:
+  void addBackend(const std::string &key, double us) {
+    entries[key].backendUs.push_back(us);
+  }
+  void addLocal(const std::string &key, double us) {
+    entries[key].localUs.push_back(us);
+  }
+
+  void print(std::ostream &os) const {
+    if (entries.empty()) {
+      return;
+    }
+    os << "\n=== Backend vs local latency (mean us) ===" << std::endl;
+    for (const auto &[key, entry] : entries) {
+      os << "  " << key << "  backend " << mean(entry.backendUs) << "  local "
+         << mean(entry.localUs) << "  (" << entry.backendUs.size() << "/"
+         << entry.localUs.size() << " calls)" << std::endl;
+    }
+  }
+
+private:
+  struct Entry {
+    std::vector<double> backendUs;
+    std::vector<double> localUs;
+  };
+
+  static double mean(const std::vector<double> &values) {
+    if (values.empty()) {
+      return 0;
+    }
+    double sum = 0;
+    for (double v : values) {
+      sum += v;
+    }
+    return sum / values.size();
+  }
+
+  std::map<std::string, Entry> entries;
+};
@@ -6,6 +6,11 @@ using json = nlohmann::json;
 bool api_request_client::login(const std::string &email,
                                const std::string &password) {
   std::cout << "\n=== Attempting Real Login ===" << std::endl;
+  if (fixtures.replaying()) {
+    // Credentials are never recorded; fixtures are served without a token.
+    auth_token = "replay";
+    return true;
+  }
   if (!auth_token.empty()) {
     std::cout << "Already logged in with token: " << auth_token << std::endl;
     return true;
@@ -43,6 +48,11 @@ bool api_request_client::login(const std::string &email,
 }
 
 bool api_request_client::create_test_project() {
+  if (fixtures.mode() != BackendMode::LIVE) {
+    std::cout << "Test projects are only created against a live backend"
+              << std::endl;
+    return false;
+  }
   if (auth_token.empty()) {
     std::cout << "No auth token - cannot create project" << std::endl;
     return false;
@@ -78,6 +88,9 @@ bool api_request_client::create_test_project() {
 }
 
 void api_request_client::remove_test_project() {
+  if (fixtures.mode() != BackendMode::LIVE) {
+    return;
+  }
   if (auth_token.empty() || project_uuid.empty()) {
     std::cout << "No auth token or project UUID - cannot delete project"
               << std::endl;
@@ -103,41 +116,61 @@ void api_request_client::remove_test_project() {
 const std::string api_request_client::BASE_URL =
     "https://api-snapshot.dev01.vislaus.cn";
 
-// Generic POST method for API testing
-nlohmann::json
-api_request_client::post(const std::string &endpoint,
-                         const nlohmann::json &request_body,
-                         const std::string &method) {
-  std::string url = BASE_URL + endpoint;
-  std::string json_body = request_body.dump();
+nlohmann::json api_request_client::exchange(const std::string &method,
+                                            const std::string &endpoint,
+                                            const nlohmann::json &request_body) {
+  const std::string key = method + " " + endpoint;
+  json response_json;
+  if (fixtures.replaying()) {
+    double latencyUs = 0;
+    if (!fixtures.replay(method, endpoint, request_body, response_json,
+                         latencyUs)) {
+      return {{"code", -1}, {"message", "no matching fixture for " + key}};
+    }
+    latency.addBackend(key, latencyUs);
+    return response_json;
+  }
 
-  std::cout << "Executing: " << method << " " << url << std::endl;
+  std::string url = BASE_URL + endpoint;
+  auto start = std::chrono::steady_clock::now();
   CurlHttpClient::Response response =
-      http_client.post(url, json_body, method, auth_token);
-  json response_json;
+      method == "GET" ? http_client.get(url, auth_token)
+                      : http_client.post(url, request_body.dump(), method,
+                                         auth_token);
+  double latencyUs = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  latency.addBackend(key, latencyUs);
   try {
     response_json = json::parse(response.body);
-    if (response_json.contains("code") && response_json["code"] != 0) {
-      std::cerr << "API Error: " << response_json["code"]  << " Message: "<< response_json["message"] << std::endl << "Body: " << request_body << std::endl;
-      
-    }
   } catch (const json::exception &e) {
     assert(false && "JSON parse error in response");
   }
+  if (fixtures.recording()) {
+    fixtures.record(method, endpoint, request_body, response_json,
+                    response.status_code, latencyUs);
+  }
+  return response_json;
+}
 
+// Generic POST method for API testing
+nlohmann::json
+api_request_client::post(const std::string &endpoint,
+                         const nlohmann::json &request_body,
+                         const std::string &method) {
+  std::cout << "Executing: " << method << " " << BASE_URL + endpoint
+            << std::endl;
+  json response_json = exchange(method, endpoint, request_body);
+  if (response_json.contains("code") && response_json["code"] != 0) {
+    std::cerr << "API Error: " << response_json["code"]
+              << " Message: " << response_json["message"] << std::endl
+              << "Body: " << request_body << std::endl;
+  }
   return response_json;
 }
 
 // Generic GET method for API testing
 nlohmann::json
 api_request_client::get(const std::string &endpoint) {
-  std::string url = BASE_URL + endpoint;
-  CurlHttpClient::Response response = http_client.get(url, auth_token);
-  json response_json;
-  try {
-    response_json = json::parse(response.body);
-  } catch (const json::exception &e) {
-    assert(false && "JSON parse error in response");
-  }
-  return response_json;
-}
\ No newline at end of file
+  return exchange("GET", endpoint, nullptr);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Scene-list responses for the offline tests, shaped like the backend's
+// GET /v3/project/{projectUuid}/scene/list so they can seed a PJsonEditor or
+// an ExtendedProjectAndScenesVo. Everything lives in project "p1"; scene i is
+// "scene-<i>" named "Scene <i>".
+
+// Wraps `scenes` in the response envelope; `data` keys such as assets or
+// bgms are merged into the response data.
+inline nlohmann::json sceneListResponse(
+    const nlohmann::json &scenes,
+    const nlohmann::json &data = nlohmann::json::object()) {
+  nlohmann::json body = data;
+  body["projectUuid"] = "p1";
+  body["scenes"] = scenes;
+  return {{"code", 0}, {"msg", "success"}, {"data", body}};
+}
+
+// Scene i without any timelines.
+inline nlohmann::json makeScene(int i, int offset, int duration = 5000) {
+  return {{"sceneUuid", "scene-" + std::to_string(i)},
+          {"projectUuid", "p1"},
+          {"name", "Scene " + std::to_string(i)},
+          {"duration", duration},
+          {"timeOffsetInProject", offset},
+          {"sceneType", "default"}};
+}
+
+// A timeline reading `duration` ms of `asset` from `startTime`.
+inline nlohmann::json makeTimeline(const std::string &uuid,
+                                   const std::string &scene, int offset,
+                                   int duration, int startTime = 0,
+                                   const std::string &asset = "asset") {
+  return {{"timelineUuid", uuid},
+          {"sceneUuid", scene},
+          {"assetUuid", asset},
+          {"timeOffsetInProject", offset},
+          {"startTime", startTime},
+          {"endTime", startTime + duration},
+          {"timelineDuration", duration}};
+}
+
+// Voice-overs are keyed by voiceUuid instead of timelineUuid.
+inline nlohmann::json makeVoiceOver(const std::string &voiceUuid,
+                                    const std::string &scene, int offset,
+                                    int duration, int startTime = 0,
+                                    const std::string &asset = "asset") {
+  nlohmann::json voiceOver =
+      makeTimeline("", scene, offset, duration, startTime, asset);
+  voiceOver.erase("timelineUuid");
+  voiceOver["voiceUuid"] = voiceUuid;
+  return voiceOver;
+}
+
+// `count` back-to-back 5s scenes without timelines.
+inline nlohmann::json makeSceneList(int count) {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < count; ++i) {
+    scenes.push_back(makeScene(i, i * 5000));
+  }
+  return sceneListResponse(scenes);
+}
+
+// `count` back-to-back 5s scenes, each with an a-roll "a-<i>" over the whole
+// scene, a b-roll "b-<i>" from 1s to 4s and a voice-over "voice-<i>" from 2s
+// to 4s.
+inline nlohmann::json makeSceneListWithTimelines(int count) {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < count; ++i) {
+    std::string uuid = "scene-" + std::to_string(i);
+    int offset = i * 5000;
+    nlohmann::json scene = makeScene(i, offset);
+    scene["arolls"] = {makeTimeline("a-" + std::to_string(i), uuid, offset, 5000)};
+    scene["brolls"] = {
+        makeTimeline("b-" + std::to_string(i), uuid, offset + 1000, 3000)};
+    scene["voiceOvers"] = {
+        makeVoiceOver("voice-" + std::to_string(i), uuid, offset + 2000, 2000)};
+    scenes.push_back(scene);
+  }
+  return sceneListResponse(scenes);
+}
@@ -0,0 +1,39 @@
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/AllocStats.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+TEST_CASE("allocStats reports per-handler and per-route counters") {
+  PJsonEditor editor(makeSceneList(3));
+  editor.resetAllocStats();
+  editor.call({"PUT",
+               "/v3/project/p1/scene/rename",
+               {{"sceneUuid", "scene-1"}, {"name", "Renamed"}},
+               {}});
+
+  nlohmann::json stats = editor.allocStats();
+  CHECK(stats["enabled"] == AllocStats::enabled());
+  if (!AllocStats::enabled()) {
+    CHECK_FALSE(stats.contains("scopes"));
+    return;
+  }
+
+  const nlohmann::json &scopes = stats["scopes"];
+  REQUIRE(scopes.contains("renameScene"));
+  REQUIRE(scopes.contains("PUT /v3/project/*/scene/rename"));
+  const nlohmann::json &handler = scopes["renameScene"];
+  const nlohmann::json &route = scopes["PUT /v3/project/*/scene/rename"];
+  CHECK(handler["calls"] == 1);
+  CHECK(handler["allocations"].get<uint64_t>() > 0);
+  CHECK(handler["peakLiveBytes"].get<uint64_t>() > 0);
+  // The route scope wraps body decoding, the handler and the response.
+  CHECK(route["allocations"].get<uint64_t>() >=
+        handler["allocations"].get<uint64_t>());
+  CHECK(route["bytes"].get<uint64_t>() >= handler["bytes"].get<uint64_t>());
+
+  editor.resetAllocStats();
+  CHECK(editor.allocStats()["scopes"].empty());
+}
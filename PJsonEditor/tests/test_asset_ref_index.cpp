@@ -0,0 +1,230 @@
+#include <memory>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ExtendedModels.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+nlohmann::json makeAsset(const std::string &uuid) {
+  return {{"assetUuid", uuid}, {"assetType", "video"}, {"duration", 5000}};
+}
+
+// Two scenes sharing "clip" as their a-roll; scene 1 also has "broll" and a
+// voice-over on "voice". The bgm uses "music"; "unused" is used by nothing.
+nlohmann::json makeSceneList() {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < 2; ++i) {
+    std::string uuid = "scene-" + std::to_string(i);
+    nlohmann::json scene = makeScene(i, i * 5000);
+    scene["arolls"] = {
+        makeTimeline("a-" + std::to_string(i), uuid, 0, 5000, 0, "clip")};
+    if (i == 1) {
+      scene["brolls"] = {makeTimeline("b-1", uuid, 0, 5000, 0, "broll")};
+      scene["voiceOvers"] = {makeVoiceOver("voice-1", uuid, 0, 5000, 0, "voice")};
+    }
+    scenes.push_back(scene);
+  }
+  return sceneListResponse(
+      scenes, {{"assets",
+                {{"clip", makeAsset("clip")},
+                 {"broll", makeAsset("broll")},
+                 {"voice", makeAsset("voice")},
+                 {"music", makeAsset("music")},
+                 {"fresh", makeAsset("fresh")},
+                 {"unused", makeAsset("unused")}}},
+               {"bgms",
+                {{{"timelineUuid", "bgm-0"},
+                  {"assetUuid", "music"},
+                  {"duration", 10000}}}}});
+}
+
+struct Fixture {
+  std::shared_ptr<ExtendedDataStore> dataStore =
+      std::make_shared<ExtendedDataStore>();
+  ExtendedControllerAPI api;
+
+  Fixture() {
+    dataStore->init(
+        std::make_shared<ExtendedProjectAndScenesVo>(makeSceneList()));
+    api.setDataStore(dataStore);
+  }
+
+  std::vector<AssetRef> refs(const std::string &asset) {
+    return dataStore->assetRefs().refs(dataStore->getCurrentProjectData(),
+                                       asset);
+  }
+
+  // The index kept in step by the handlers matches a fresh build.
+  void checkAgainstRebuild() {
+    const auto &project = dataStore->getCurrentProjectData();
+    AssetRefIndex rebuilt;
+    rebuilt.build(project);
+    const AssetRefIndex &kept = dataStore->assetRefs();
+    CHECK(kept.assetCount() == rebuilt.assetCount());
+    for (const auto &asset : project.assets) {
+      const auto expected = rebuilt.refs(project, asset.first);
+      const auto actual = kept.refs(project, asset.first);
+      REQUIRE(actual.size() == expected.size());
+      for (size_t i = 0; i < actual.size(); ++i) {
+        CHECK(actual[i].kind == expected[i].kind);
+        CHECK(actual[i].sceneIndex == expected[i].sceneIndex);
+        CHECK(actual[i].index == expected[i].index);
+      }
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE_FIXTURE(Fixture, "the index lists every use of an asset") {
+  const AssetRefIndex &index = dataStore->assetRefs();
+  const auto clip = refs("clip");
+  REQUIRE(clip.size() == 4);  // two a-rolls, two project timelines
+  CHECK(clip[0].kind == AssetRefKind::A_ROLL);
+  CHECK(clip[0].sceneIndex == 0);
+  CHECK(clip[1].kind == AssetRefKind::A_ROLL);
+  CHECK(clip[1].sceneIndex == 1);
+  CHECK(clip[2].kind == AssetRefKind::PROJECT_TIMELINE);
+
+  REQUIRE(refs("voice").size() == 1);
+  CHECK(refs("voice")[0].kind == AssetRefKind::VOICE_OVER);
+  REQUIRE(refs("music").size() == 1);
+  CHECK(refs("music")[0].kind == AssetRefKind::BGM);
+  CHECK_FALSE(index.referenced("unused"));
+
+  // A handler's edit shows up on the next query.
+  ProjectSceneFootageAddReqBody add;
+  add.sceneUuid = "scene-0";
+  add.assetUuid = "fresh";
+  add.duration = 1000;
+  REQUIRE(api.addFootage(add).isSuccess());
+  CHECK(dataStore->assetRefs().referenced("fresh"));
+}
+
+TEST_CASE_FIXTURE(Fixture, "replaceAsset repoints every use and patches each") {
+  ProjectAssetReplaceReqBody body;
+  body.oldAssetUuid = "clip";
+  body.newAssetUuid = "broll";
+  ApiResult result = api.replaceAsset(body);
+  REQUIRE(result.isSuccess());
+
+  REQUIRE(result.patch.size() == 2);
+  CHECK(result.patch[0]["path"] == "/scenes/[uuid=scene-0]/aRolls/0/assetUuid");
+  CHECK(result.patch[1]["path"] == "/scenes/[uuid=scene-1]/aRolls/0/assetUuid");
+  CHECK(result.patch[1]["value"] == "broll");
+
+  const auto &project = dataStore->getCurrentProjectData();
+  CHECK(project.scenes[0].aRolls[0].assetUuid == "broll");
+  CHECK(project.scenes[1].aRolls[0].assetUuid == "broll");
+  for (const auto &timeline : project.timelines) {
+    CHECK(timeline.assetUuid != "clip");
+  }
+
+  // The index was kept in step and matches a fresh build.
+  checkAgainstRebuild();
+  CHECK_FALSE(dataStore->assetRefs().referenced("clip"));
+
+  body.oldAssetUuid = "music";
+  body.newAssetUuid = "voice";
+  result = api.replaceAsset(body);
+  REQUIRE(result.patch.size() == 1);
+  CHECK(result.patch[0]["path"] == "/bgms/0/assetUuid");
+
+  body.newAssetUuid = "";
+  CHECK(api.replaceAsset(body).getCode() ==
+        ApiMessageHelper::getCode(ApiMessage::ILLEGAL_PARAMS));
+
+  // The replacement must be one of the project's assets.
+  body.oldAssetUuid = "voice";
+  body.newAssetUuid = "missing";
+  CHECK(api.replaceAsset(body).getCode() ==
+        ApiMessageHelper::getCode(ApiMessage::ILLEGAL_PARAMS));
+  CHECK(dataStore->getCurrentProjectData().bgms[0].assetUuid == "voice");
+}
+
+TEST_CASE_FIXTURE(Fixture, "handlers keep the index in step") {
+  dataStore->assetRefs();
+
+  ProjectSceneFootageAddReqBody add;
+  add.sceneUuid = "scene-0";
+  add.assetUuid = "fresh";
+  add.duration = 1000;
+  REQUIRE(api.addFootage(add).isSuccess());
+  checkAgainstRebuild();
+
+  ExtendedProjectSceneSplitReqBody split;
+  split.sceneUuid = "scene-1";
+  split.splitTime = 2000;
+  REQUIRE(api.splitScene(split).isSuccess());
+  checkAgainstRebuild();
+
+  ExtendedProjectSceneMoveReqBody move;
+  move.uuid = "scene-0";
+  move.afterSceneUuid = dataStore->getCurrentProjectData().scenes[2].uuid;
+  REQUIRE(api.moveScene(move).isSuccess());
+  checkAgainstRebuild();
+
+  ExtendedProjectSceneDeleteReqBody remove;
+  remove.sceneUuid = "scene-0";
+  REQUIRE(api.deleteScene(remove).isSuccess());
+  CHECK_FALSE(dataStore->assetRefs().referenced("fresh"));
+  checkAgainstRebuild();
+
+  ProjectBgmDeleteReqBody deleteBgm;
+  deleteBgm.timelineUuid = "bgm-0";
+  REQUIRE(api.deleteBgm(deleteBgm).isSuccess());
+  CHECK_FALSE(dataStore->assetRefs().referenced("music"));
+  checkAgainstRebuild();
+}
+
+TEST_CASE_FIXTURE(Fixture, "pruneAssets removes only what nothing uses") {
+  ApiResult result = api.pruneAssets({});
+  REQUIRE(result.isSuccess());
+  REQUIRE(result.patch.size() == 2);
+  CHECK(result.patch[0]["path"] == "/assets/fresh");
+  CHECK(result.patch[1]["path"] == "/assets/unused");
+  const auto &assets = dataStore->getCurrentProjectData().assets;
+  CHECK(assets.size() == 4);
+  CHECK(assets.count("music") == 1);
+
+  // Deleting the last b-roll on an asset frees it.
+  ProjectSceneFootageDeleteReqBody remove;
+  remove.sceneUuid = "scene-1";
+  remove.timelineUuid = "b-1";
+  REQUIRE(api.deleteFootage(remove).isSuccess());
+  result = api.pruneAssets({});
+  REQUIRE(result.patch.size() == 1);
+  CHECK(result.patch[0]["path"] == "/assets/broll");
+  CHECK(api.pruneAssets({}).patch.empty());
+}
+
+TEST_CASE_FIXTURE(Fixture, "scoped scene VOs carry only the assets their scene uses") {
+  // The backend sends every asset of the project.
+  CHECK(api.convertProjectToProjectAndSceneVo("scene-0")["assets"].size() == 6);
+
+  BackendParityOptions options;
+  options.scopeSceneVoAssets = true;
+  api.setParityOptions(options);
+  nlohmann::json vo = api.convertProjectToProjectAndSceneVo("scene-1");
+  CHECK(vo["assets"].size() == 3);
+  CHECK(vo["assets"].contains("clip"));
+  CHECK(vo["assets"].contains("broll"));
+  CHECK(vo["assets"]["voice"]["assetType"] == "video");
+  CHECK(api.convertProjectToProjectAndSceneVo("scene-0")["assets"].size() == 1);
+
+  // Edits and asset replacement reach the scene's asset set.
+  ProjectSceneFootageDeleteReqBody remove;
+  remove.sceneUuid = "scene-1";
+  remove.timelineUuid = "b-1";
+  REQUIRE(api.deleteFootage(remove).isSuccess());
+  CHECK_FALSE(api.convertProjectToProjectAndSceneVo("scene-1")["assets"].contains("broll"));
+  dataStore->replaceAsset("clip", "fresh");
+  vo = api.convertProjectToProjectAndSceneVo("scene-0");
+  CHECK(vo["assets"].size() == 1);
+  CHECK(vo["assets"].contains("fresh"));
+}
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// Four 5s scenes, each with an a-roll over the whole scene and a b-roll
+// starting 1s in.
+nlohmann::json makeSceneList() {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < 4; ++i) {
+    std::string uuid = "scene-" + std::to_string(i);
+    int offset = i * 5000;
+    nlohmann::json scene = makeScene(i, offset);
+    scene["arolls"] = {makeTimeline("a-" + std::to_string(i), uuid, offset, 5000)};
+    scene["brolls"] = {
+        makeTimeline("b-" + std::to_string(i), uuid, offset + 1000, 2000)};
+    scenes.push_back(scene);
+  }
+  return sceneListResponse(scenes);
+}
+
+struct Fixture {
+  std::shared_ptr<ExtendedDataStore> dataStore =
+      std::make_shared<ExtendedDataStore>();
+  ExtendedControllerAPI api;
+
+  Fixture() {
+    dataStore->init(
+        std::make_shared<ExtendedProjectAndScenesVo>(makeSceneList()));
+    api.setDataStore(dataStore);
+  }
+
+  const std::vector<ExtendedProjectScene> &scenes() {
+    return dataStore->getCurrentProjectData().scenes;
+  }
+
+  // The scene offsets a client holds.
+  nlohmann::json clientView() {
+    nlohmann::json view = {{"scenes", nlohmann::json::array()}};
+    for (const auto &scene : scenes()) {
+      view["scenes"].push_back(
+          {{"timeOffsetInProject", scene.timeOffsetInProject}});
+    }
+    return view;
+  }
+
+  void checkClient(const nlohmann::json &view) {
+    REQUIRE(view["scenes"].size() == scenes().size());
+    for (size_t i = 0; i < scenes().size(); ++i) {
+      CHECK(view["scenes"][i]["timeOffsetInProject"] ==
+            scenes()[i].timeOffsetInProject);
+    }
+  }
+
+  void checkOffsets() {
+    int offset = 0;
+    for (const auto &scene : scenes()) {
+      CHECK(scene.timeOffsetInProject == offset);
+      CHECK(scene.aRolls[0].timeOffsetInProject == offset);
+      CHECK(scene.bRolls[0].timeOffsetInProject == offset + 1000);
+      offset += scene.duration;
+    }
+  }
+};
+
+// Applies the scene moves and offsets of `patch` to a client's view.
+nlohmann::json applyScenePatch(const nlohmann::json &view,
+                               const nlohmann::json &patch) {
+  static const std::string offset = "/timeOffsetInProject";
+  nlohmann::json scenePatch = nlohmann::json::array();
+  for (const auto &op : patch) {
+    const std::string path = op["path"];
+    if (path.rfind("/scenes/", 0) != 0) {
+      continue;
+    }
+    const size_t slash = path.find('/', 8);
+    if (slash == std::string::npos && op["op"] == "move") {
+      scenePatch.push_back(op);
+    } else if (slash == std::string::npos && op["op"] == "replace") {
+      scenePatch.push_back({{"op", "replace"},
+                            {"path", path + offset},
+                            {"value", op["value"]["timeOffsetInProject"]}});
+    } else if (path.compare(slash, std::string::npos, offset) == 0) {
+      scenePatch.push_back(op);
+    }
+  }
+  return view.patch(scenePatch);
+}
+
+} // namespace
+
+TEST_CASE_FIXTURE(Fixture, "batch applies every operation and answers once") {
+  Expected<ProjectBatchReqBody> decoded = decodeBody<ProjectBatchReqBody>(nlohmann::json{
+      {"operations",
+       {{{"op", "setSceneTime"},
+         {"body", {{"sceneUuid", "scene-1"}, {"newDuration", 8000}}}},
+        {{"op", "renameScene"},
+         {"body", {{"sceneUuid", "scene-2"}, {"name", "Renamed"}}}},
+        {{"op", "moveScene"},
+         {"body", {{"uuid", "scene-3"}, {"afterSceneUuid", "scene-0"}}}}}}});
+  REQUIRE(decoded.has_value());
+  const ProjectBatchReqBody &req = *decoded;
+  REQUIRE(req.operations.size() == 3);
+
+  ApiResult result = api.batch(req);
+  REQUIRE(result.isSuccess());
+  REQUIRE(scenes().size() == 4);
+  CHECK(scenes()[1].uuid == "scene-3");
+  CHECK(scenes()[2].duration == 8000);
+  CHECK(scenes()[3].name == "Renamed");
+  checkOffsets();
+
+  // The patches of all three operations, and the whole project as data.
+  CHECK(result.patch.size() > 3);
+  REQUIRE(result.data.contains("scenes"));
+  CHECK(result.data["scenes"].size() == 4);
+  CHECK(result.data["scenes"][1]["sceneUuid"] == "scene-3");
+}
+
+TEST_CASE_FIXTURE(Fixture, "a failing operation rolls the whole batch back") {
+  ProjectBatchReqBody req;
+  ExtendedProjectSceneSetTimeReqBody setTime;
+  setTime.sceneUuid = "scene-0";
+  setTime.newDuration = 9000;
+  ExtendedProjectSceneDeleteReqBody del;
+  del.sceneUuid = "scene-2";
+  ExtendedProjectSceneRenameReqBody rename;
+  rename.sceneUuid = "missing";
+  rename.name = "x";
+  req.operations = {setTime, del, rename};
+
+  ApiResult result = api.batch(req);
+  CHECK(result.isError());
+  CHECK(result.apiMessage == ApiMessage::PROJECT_VIDEO_SCENE_NOT_FOUND);
+  CHECK(result.data["failedIndex"] == 2);
+
+  REQUIRE(scenes().size() == 4);
+  CHECK(scenes()[0].duration == 5000);
+  CHECK(scenes()[2].uuid == "scene-2");
+  checkOffsets();
+
+  // The store is usable afterwards.
+  req.operations = {setTime};
+  REQUIRE(api.batch(req).isSuccess());
+  CHECK(scenes()[0].duration == 9000);
+  checkOffsets();
+}
+
+TEST_CASE("a batched operation patches the same offsets as a direct call") {
+  SetMainStoryOrderReqBody order;
+  order.timelineUuids = {"scene-3", "scene-1", "scene-0", "scene-2"};
+
+  Fixture direct;
+  ApiResult expected = direct.api.setMainStoryOrder(order);
+  REQUIRE(expected.isSuccess());
+
+  Fixture batched;
+  ProjectBatchReqBody req;
+  req.operations = {order};
+  ApiResult result = batched.api.batch(req);
+  REQUIRE(result.isSuccess());
+
+  CHECK(result.patch == expected.patch);
+  int replaced = 0;
+  for (const auto &op : result.patch) {
+    replaced += op["op"] == "replace";
+  }
+  CHECK(replaced > 0);
+  batched.checkOffsets();
+}
+
+TEST_CASE("operations after a reorder see the reordered offsets") {
+  SetMainStoryOrderReqBody order;
+  order.timelineUuids = {"scene-3", "scene-1", "scene-0", "scene-2"};
+  ProjectSceneFootageAddReqBody footage;
+  footage.sceneUuid = "scene-0";
+  footage.assetUuid = "asset";
+  footage.timeOffsetInScene = 3500;
+  footage.duration = 1000;
+
+  Fixture direct;
+  REQUIRE(direct.api.setMainStoryOrder(order).isSuccess());
+  ApiResult expected = direct.api.addFootage(footage);
+  REQUIRE(expected.isSuccess());
+  REQUIRE(expected.patch[0]["value"]["timeOffsetInProject"] == 13500);
+
+  Fixture batched;
+  ProjectBatchReqBody req;
+  req.operations = {order, footage};
+  ApiResult result = batched.api.batch(req);
+  REQUIRE(result.isSuccess());
+
+  // The same footage patches, up to the new timeline's uuid.
+  auto withoutUuid = [](nlohmann::json patch) {
+    for (auto &op : patch) {
+      if (op.contains("value") && op["value"].is_object()) {
+        op["value"].erase("uuid");
+      }
+    }
+    return patch;
+  };
+  const nlohmann::json batchedPatch = withoutUuid(result.patch);
+  for (const auto &op : withoutUuid(expected.patch)) {
+    CHECK(std::find(batchedPatch.begin(), batchedPatch.end(), op) !=
+          batchedPatch.end());
+  }
+  CHECK(batched.scenes()[2].bRolls.back().timeOffsetInProject == 13500);
+  CHECK(batched.dataStore->getCurrentProjectData().timelines.back()
+            .timeOffsetInProject == 13500);
+}
+
+TEST_CASE_FIXTURE(Fixture, "the batch patch leaves a client with the store's offsets") {
+  nlohmann::json view = clientView();
+
+  // setSceneTime sends scene-2 at 15000; the reorder puts it back at 10000,
+  // its offset before the batch.
+  ExtendedProjectSceneSetTimeReqBody setTime;
+  setTime.sceneUuid = "scene-0";
+  setTime.newDuration = 10000;
+  SetMainStoryOrderReqBody order;
+  order.timelineUuids = {"scene-0", "scene-2", "scene-1", "scene-3"};
+  ProjectBatchReqBody req;
+  req.operations = {setTime, order};
+  ApiResult result = api.batch(req);
+  REQUIRE(result.isSuccess());
+
+  CHECK(scenes()[1].uuid == "scene-2");
+  CHECK(scenes()[1].timeOffsetInProject == 10000);
+  checkClient(applyScenePatch(view, result.patch));
+}
+
+TEST_CASE("random batches leave a client with the store's offsets") {
+  for (unsigned seed = 0; seed < 100; ++seed) {
+    std::mt19937 rng(seed);
+    auto sceneUuid = [&rng] {
+      return "scene-" + std::to_string(rng() % 4);
+    };
+    ProjectBatchReqBody req;
+    for (int i = 0; i < 4; ++i) {
+      switch (rng() % 3) {
+      case 0: {
+        ExtendedProjectSceneSetTimeReqBody setTime;
+        setTime.sceneUuid = sceneUuid();
+        setTime.newDuration = 1000 + static_cast<int>(rng() % 9000);
+        req.operations.push_back(setTime);
+        break;
+      }
+      case 1: {
+        ExtendedProjectSceneMoveReqBody move;
+        move.uuid = sceneUuid();
+        move.newIndex = 0;
+        move.afterSceneUuid = sceneUuid();
+        req.operations.push_back(move);
+        break;
+      }
+      default: {
+        SetMainStoryOrderReqBody order;
+        order.timelineUuids = {"scene-0", "scene-1", "scene-2", "scene-3"};
+        std::shuffle(order.timelineUuids.begin(), order.timelineUuids.end(), rng);
+        req.operations.push_back(order);
+      }
+      }
+    }
+
+    Fixture fixture;
+    nlohmann::json view = fixture.clientView();
+    ApiResult result = fixture.api.batch(req);
+    if (result.isSuccess()) {
+      fixture.checkClient(applyScenePatch(view, result.patch));
+    }
+  }
+}
+
+TEST_CASE("batch route") {
+  PJsonEditor editor(makeSceneList());
+  Request req;
+  req.method = "POST";
+  req.url = "/v3/project/p1/batch";
+  req.body = {{"operations",
+               {{{"op", "renameScene"},
+                 {"body", {{"sceneUuid", "scene-0"}, {"name", "First"}}}},
+                {{"op", "deleteScene"}, {"body", {{"sceneUuid", "scene-3"}}}}}}};
+  Response resp = editor.call(req);
+  CHECK(resp.status_code == 200);
+  CHECK(resp.body["data"]["scenes"].size() == 3);
+  CHECK(resp.body["data"]["scenes"][0]["name"] == "First");
+
+  req.body = {{"operations",
+               {{{"op", "deleteScene"}, {"body", {{"sceneUuid", "scene-0"}}}},
+                {{"op", "deleteScene"}, {"body", {{"sceneUuid", "nope"}}}}}}};
+  resp = editor.call(req);
+  CHECK(resp.status_code == 400);
+  CHECK(resp.body["data"]["failedIndex"] == 1);
+
+  req.body = {{"operations", {{{"op", "noSuchOp"}, {"body", {}}}}}};
+  resp = editor.call(req);
+  CHECK(resp.status_code == 400);
+}
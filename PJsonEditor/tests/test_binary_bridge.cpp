@@ -0,0 +1,88 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/BinaryBridge.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// Encodes `message` into the bridge's request buffer and decodes what the
+// call wrote back.
+nlohmann::json roundTrip(BinaryBridge &bridge, const nlohmann::json &message) {
+  std::vector<uint8_t> bytes = nlohmann::json::to_msgpack(message);
+  std::memcpy(bridge.requestBuffer(bytes.size()), bytes.data(), bytes.size());
+  size_t size = bridge.call(bytes.size());
+  REQUIRE(size == bridge.responseSize());
+  return nlohmann::json::from_msgpack(bridge.responseData(),
+                                      bridge.responseData() + size);
+}
+
+} // namespace
+
+TEST_CASE("binary calls return the response and the patch they recorded") {
+  PJsonEditor editor(makeSceneList(1));
+  BinaryBridge bridge(editor);
+
+  nlohmann::json renamed =
+      roundTrip(bridge, {{"method", "PUT"},
+                         {"url", "/v3/project/p1/scene/rename"},
+                         {"body", {{"sceneUuid", "scene-0"}, {"name", "Intro"}}}});
+  CHECK(renamed["status"] == 200);
+  CHECK(renamed["body"]["code"] == 0);
+  REQUIRE_FALSE(renamed["patch"].empty());
+  CHECK(renamed["patch"][0]["value"] == "Intro");
+
+  // Reads change nothing and carry an empty patch; the buffers are reused.
+  nlohmann::json read = roundTrip(
+      bridge, {{"method", "GET"},
+               {"url", "/v3/project/p1/scenes"},
+               {"headers", {{"If-None-Match", "\"0\""}}}});
+  CHECK(read["status"] == 200);
+  CHECK(read["patch"].empty());
+  CHECK(read["body"]["data"]["scenes"][0]["name"] == "Intro");
+}
+
+TEST_CASE("requests that are not MessagePack objects get a 400") {
+  PJsonEditor editor(makeSceneList(1));
+  BinaryBridge bridge(editor);
+
+  const uint8_t garbage[] = {0xc1, 0xff, 0x00};
+  std::memcpy(bridge.requestBuffer(sizeof(garbage)), garbage, sizeof(garbage));
+  size_t size = bridge.call(sizeof(garbage));
+  nlohmann::json response = nlohmann::json::from_msgpack(
+      bridge.responseData(), bridge.responseData() + size);
+  CHECK(response["status"] == 400);
+  CHECK(response["body"]["code"] == -1);
+
+  CHECK(roundTrip(bridge, {{"method", "GET"}})["status"] == 400);
+  CHECK(roundTrip(bridge, nlohmann::json::array({1, 2}))["status"] == 400);
+}
+
+TEST_CASE("callJson takes and returns the same messages as JSON text") {
+  PJsonEditor editor(makeSceneList(1));
+  BinaryBridge bridge(editor);
+
+  const std::string request =
+      nlohmann::json{{"method", "POST"},
+                     {"url", "/v3/project/p1/scene/time/set"},
+                     {"body", {{"sceneUuid", "scene-0"}, {"newDuration", 3000}}}}
+          .dump();
+  std::memcpy(bridge.requestBuffer(request.size()), request.data(),
+              request.size());
+  size_t size = bridge.callJson(request.size());
+  nlohmann::json response = nlohmann::json::parse(
+      bridge.responseData(), bridge.responseData() + size);
+  CHECK(response["status"] == 200);
+  CHECK_FALSE(response["patch"].empty());
+
+  const std::string garbage = "{\"method\": ";
+  std::memcpy(bridge.requestBuffer(garbage.size()), garbage.data(),
+              garbage.size());
+  size = bridge.callJson(garbage.size());
+  CHECK(nlohmann::json::parse(bridge.responseData(),
+                              bridge.responseData() + size)["status"] == 400);
+}
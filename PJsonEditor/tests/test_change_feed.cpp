@@ -0,0 +1,90 @@
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ChangeFeed.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+Response rename(PJsonEditor &editor, const std::string &scene,
+                const std::string &name) {
+  return editor.call({"PUT",
+                      "/v3/project/p1/scene/rename",
+                      {{"sceneUuid", scene}, {"name", name}},
+                      {}});
+}
+
+} // namespace
+
+TEST_CASE("consumers tail the feed from their own cursors") {
+  ChangeFeed feed(4);
+  CHECK(feed.lastSequence() == 0);
+  CHECK(feed.read(0).records.empty());
+
+  for (int v = 2; v <= 4; ++v) {
+    feed.append(v, {{{"op", "replace"}, {"path", "/v"}, {"value", v}}});
+  }
+  auto fast = feed.read(0, 2);
+  REQUIRE(fast.records.size() == 2);
+  CHECK(fast.records[0].sequence == 1);
+  CHECK(fast.records[1].version == 3);
+  CHECK(fast.cursor == 2);
+  fast = feed.read(fast.cursor);
+  REQUIRE(fast.records.size() == 1);
+  CHECK(fast.cursor == 3);
+  CHECK(feed.read(fast.cursor).records.empty());
+
+  // Readers share the stored patch.
+  CHECK(feed.read(0).records[0].patch == feed.read(0).records[0].patch);
+
+  // Only the newest four are kept; cursor 0 now needs a snapshot.
+  for (int v = 5; v <= 7; ++v) {
+    feed.append(v, nlohmann::json::array());
+  }
+  CHECK(feed.size() == 4);
+  auto late = feed.read(0);
+  CHECK(late.snapshotRequired);
+  CHECK(late.cursor == 6);
+  auto caughtUp = feed.read(2);
+  CHECK_FALSE(caughtUp.snapshotRequired);
+  REQUIRE(caughtUp.records.size() == 4);
+  CHECK(caughtUp.records.front().sequence == 3);
+
+  // Sequences keep counting after clear().
+  feed.clear();
+  CHECK(feed.read(6).records.empty());
+  CHECK(feed.read(5).snapshotRequired);
+  CHECK(feed.append(8, nlohmann::json::array()) == 7);
+}
+
+TEST_CASE("PJsonEditor feeds successful mutations to every consumer") {
+  PJsonEditor editor(makeSceneList(3));
+  auto start = editor.changesSince(0);
+  CHECK(start["cursor"] == 0);
+  CHECK(start["changes"].empty());
+
+  REQUIRE(rename(editor, "scene-0", "A").status_code == 200);
+  CHECK(rename(editor, "missing", "B").status_code == 400);
+  REQUIRE(rename(editor, "scene-1", "C").status_code == 200);
+
+  auto first = editor.changesSince(0, 1);
+  REQUIRE(first["changes"].size() == 1);
+  CHECK(first["changes"][0]["version"] == 2);
+  CHECK(first["changes"][0]["patch"][0]["value"] == "A");
+
+  auto second = editor.changesSince(first["cursor"]);
+  REQUIRE(second["changes"].size() == 1);
+  CHECK(second["changes"][0]["patch"][0]["value"] == "C");
+  CHECK(second["cursor"] == 2);
+
+  // Same feed through the route.
+  Response routed = editor.call({"GET",
+                                 "/v3/project/p1/changes",
+                                 {{"cursor", 1}},
+                                 {}});
+  REQUIRE(routed.status_code == 200);
+  CHECK(routed.body["data"]["changes"].size() == 1);
+  CHECK(routed.body["data"]["cursor"] == 2);
+}
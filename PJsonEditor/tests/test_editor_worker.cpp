@@ -0,0 +1,131 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/EditorWorker.h>
+#include <pjson_editor/SpscRing.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+EditorWorker::Call rename(int i) {
+  nlohmann::json message = {
+      {"method", "PUT"},
+      {"url", "/v3/project/p1/scene/rename"},
+      {"body", {{"sceneUuid", "scene-0"}, {"name", "Name " + std::to_string(i)}}}};
+  return {nlohmann::json::to_msgpack(message), false};
+}
+
+// Polls until a response is there; the worker answers within milliseconds.
+nlohmann::json next(EditorWorker &worker) {
+  std::vector<uint8_t> bytes;
+  while (!worker.poll(bytes)) {
+    std::this_thread::yield();
+  }
+  return nlohmann::json::from_msgpack(bytes);
+}
+
+} // namespace
+
+TEST_CASE("the ring hands items across threads in order") {
+  SpscRing<int> ring(100);
+  CHECK(ring.capacity() == 128);
+
+  const int count = 100000;
+  std::thread producer([&ring] {
+    for (int i = 0; i < count; ++i) {
+      int item = i;
+      while (!ring.push(std::move(item))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int expected = 0;
+  while (expected < count) {
+    int item = -1;
+    if (ring.pop(item)) {
+      REQUIRE(item == expected);
+      ++expected;
+    }
+  }
+  producer.join();
+  CHECK(ring.empty());
+}
+
+TEST_CASE("calls run on the worker and answer in submission order") {
+  std::atomic<int> notifications{0};
+  EditorWorker worker(makeSceneList(1), [&notifications] { ++notifications; });
+
+  const int calls = 20;
+  for (int i = 0; i < calls; ++i) {
+    EditorWorker::Call call = rename(i);
+    REQUIRE(worker.submit(call));
+  }
+  EditorWorker::Call read{{}, true};
+  const std::string text =
+      nlohmann::json{{"method", "GET"}, {"url", "/v3/project/p1/scenes"}}.dump();
+  read.bytes.assign(text.begin(), text.end());
+  REQUIRE(worker.submit(read));
+
+  for (int i = 0; i < calls; ++i) {
+    nlohmann::json response = next(worker);
+    CHECK(response["status"] == 200);
+    CHECK(response["patch"][0]["value"] == "Name " + std::to_string(i));
+  }
+  std::vector<uint8_t> bytes;
+  while (!worker.poll(bytes)) {
+    std::this_thread::yield();
+  }
+  nlohmann::json scenes = nlohmann::json::parse(bytes);
+  CHECK(scenes["body"]["data"]["scenes"][0]["name"] == "Name 19");
+  CHECK(worker.pending() == 0);
+  CHECK_FALSE(worker.poll(bytes));
+
+  // At least one notification, not necessarily one per call.
+  CHECK(notifications.load() >= 1);
+  CHECK(notifications.load() <= calls + 1);
+}
+
+TEST_CASE("submit refuses calls beyond maxPending until responses are polled") {
+  // 3 rounds the rings up to 4 entries; the limit is still 3.
+  EditorWorker worker(makeSceneList(1), {}, 3);
+  std::vector<EditorWorker::Call> calls;
+  for (int i = 0; i < 4; ++i) {
+    calls.push_back(rename(i));
+  }
+  REQUIRE(worker.submit(calls[0]));
+  REQUIRE(worker.submit(calls[1]));
+  REQUIRE(worker.submit(calls[2]));
+  CHECK_FALSE(worker.submit(calls[3]));
+  CHECK_FALSE(calls[3].bytes.empty());
+
+  next(worker);
+  CHECK(worker.submit(calls[3]));
+  next(worker);
+  next(worker);
+  CHECK(next(worker)["patch"][0]["value"] == "Name 3");
+}
+
+TEST_CASE("a notification after an empty poll is never lost") {
+  std::atomic<int> notifications{0};
+  EditorWorker worker(makeSceneList(1), [&notifications] { ++notifications; });
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < 50; ++i) {
+    const int before = notifications.load();
+    EditorWorker::Call call = rename(i);
+    REQUIRE(worker.submit(call));
+    // Wait for the notification rather than polling blindly, then drain.
+    while (notifications.load() == before) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    int drained = 0;
+    while (worker.poll(bytes)) {
+      ++drained;
+    }
+    CHECK(drained == 1);
+  }
+}
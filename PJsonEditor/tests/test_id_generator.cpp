@@ -0,0 +1,100 @@
+#include <string>
+#include <unordered_set>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/IdGenerator.h>
+#include <pjson_editor/pjson_editor.hpp>
+using namespace pjson;
+
+namespace {
+
+bool isCanonical(const std::string &id, char version) {
+  if (id.size() != 36 || id[14] != version ||
+      std::string("89ab").find(id[19]) == std::string::npos) {
+    return false;
+  }
+  for (size_t i = 0; i < id.size(); ++i) {
+    const bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+    if (dash != (id[i] == '-') ||
+        (!dash && std::string("0123456789abcdef").find(id[i]) ==
+                      std::string::npos)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string addScene(PJsonEditor &editor) {
+  editor.call({"POST", "/v3/project/p1/scene/add", {{"addPosition", 0}}, {}});
+  return editor.call({"GET", "/v3/project/p1/scenes", {}, {}})
+      .body["data"]["scenes"][0]["sceneUuid"];
+}
+
+} // namespace
+
+TEST_CASE("v4 ids are canonical, seeded and unique") {
+  IdGenerator a(42);
+  IdGenerator b(42);
+  IdGenerator c(43);
+  const std::string first = a.nextString();
+  CHECK(isCanonical(first, '4'));
+  CHECK(b.nextString() == first);
+  CHECK(c.nextString() != first);
+
+  std::unordered_set<std::string> seen;
+  for (int i = 0; i < 100000; ++i) {
+    seen.insert(a.nextString());
+  }
+  CHECK(seen.size() == 100000);
+}
+
+TEST_CASE("v7 ids carry the clock and stay ordered") {
+  IdGenerator ids(7, IdGenerator::Version::V7);
+  ids.setAutoClock(false);
+  ids.advanceTime(0x0123456789ab);
+  const std::string first = ids.nextString();
+  CHECK(isCanonical(first, '7'));
+  CHECK(first.substr(0, 13) == "01234567-89ab");
+
+  // The clock never goes back.
+  ids.advanceTime(1000);
+  CHECK(ids.nextString().substr(0, 13) == "01234567-89ab");
+  ids.advanceTime(0x0123456789ac);
+  CHECK(ids.nextString() > first);
+
+  IdGenerator live(7, IdGenerator::Version::V7);
+  const int64_t before = IdGenerator::systemTimeMs();
+  live.nextString();
+  CHECK(live.state().timeMs >= before);
+}
+
+TEST_CASE("batches and restored states replay the same ids") {
+  IdGenerator ids(99);
+  const IdGenerator::State start = ids.state();
+  std::vector<UuidText> batch(5);
+  ids.nextBatch(batch.data(), batch.size());
+
+  ids.setState(start);
+  for (const auto &expected : batch) {
+    UuidText text;
+    ids.next(text);
+    CHECK(text == expected);
+  }
+}
+
+TEST_CASE("every editor has its own generator") {
+  nlohmann::json sceneList = {{"data", {{"projectUuid", "p1"}}}};
+  PJsonEditor first(sceneList);
+  PJsonEditor second(sceneList);
+  const std::string a = addScene(first);
+  const std::string b = addScene(second);
+  CHECK(isCanonical(a, '4'));
+  CHECK(a != b);
+
+  PJsonEditor seededA(sceneList);
+  PJsonEditor seededB(sceneList);
+  seededA.idGenerator() = IdGenerator(5);
+  seededB.idGenerator() = IdGenerator(5);
+  CHECK(addScene(seededA) == addScene(seededB));
+}
@@ -0,0 +1,75 @@
+#include <optional>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedModels.h>
+#include <pjson_editor/JsonBlob.h>
+#include <pjson_editor/JsonReader.h>
+#include <pjson_editor/ProjectCheckpoint.h>
+using namespace pjson;
+
+TEST_CASE("copies share one value; assigning replaces it") {
+  ExtendedProjectScene scene;
+  scene.uuid = "scene-0";
+  ExtendedTimeline timeline;
+  timeline.cropData = nlohmann::json{{"x", 0.1}, {"y", 0.2}};
+  scene.aRolls.push_back(timeline);
+  scene.deprecatedEffect = nlohmann::json{{"type", "fade"}};
+
+  ExtendedProjectScene copy = scene;
+  CHECK(copy.aRolls[0].cropData.shares(scene.aRolls[0].cropData));
+  CHECK(copy.deprecatedEffect.shares(scene.deprecatedEffect));
+  CHECK_FALSE(copy.aRolls[0].kenburnsData.has_value());
+
+  copy.aRolls[0].cropData = nlohmann::json{{"x", 0.5}};
+  CHECK((*scene.aRolls[0].cropData)["x"] == 0.1);
+  CHECK(copy.aRolls[0].cropData->at("x") == 0.5);
+  CHECK(copy.aRolls[0].cropData != scene.aRolls[0].cropData);
+  CHECK(JsonBlob(nlohmann::json{{"x", 0.1}, {"y", 0.2}}) == scene.aRolls[0].cropData);
+
+  CHECK(sizeof(JsonBlob) < sizeof(std::optional<nlohmann::json>));
+}
+
+TEST_CASE("blobs read and write like optional json") {
+  JsonBlob blob;
+  CHECK(readValue(nlohmann::json::array({1, 2}), blob));
+  REQUIRE(blob.has_value());
+  CHECK(blob->size() == 2);
+  CHECK(nlohmann::json{{"data", blob}}.dump() == R"({"data":[1,2]})");
+
+  blob.reset();
+  CHECK(nlohmann::json(blob).is_null());
+
+  // Null is a value, as for std::optional<json>.
+  JsonReader in(nlohmann::json{{"easing", nullptr}});
+  SceneTransition transition;
+  in.read("easing", transition.easing);
+  CHECK(transition.easing.has_value());
+  CHECK(transition.easing->is_null());
+}
+
+TEST_CASE("checkpoints keep blob fields and their absence") {
+  ExtendedProjectAndScenesVo project;
+  ExtendedProjectScene scene;
+  scene.uuid = "scene-0";
+  ExtendedTimeline timeline;
+  timeline.kenburnsData = nlohmann::json{{"zoom", 1.2}};
+  scene.bRolls.push_back(timeline);
+  BaseLayer layer;
+  layer.data = nlohmann::json{{"text", "Title"}};
+  scene.layers.push_back(layer);
+  SceneTransition transition;
+  transition.properties = nlohmann::json{{"direction", "left"}};
+  scene.transitions.push_back(transition);
+  project.scenes.push_back(scene);
+
+  Expected<ExtendedProjectAndScenesVo> decoded =
+      decodeProjectCheckpoint(encodeProjectCheckpoint(project));
+  REQUIRE(decoded);
+  const auto &restored = decoded->scenes.at(0);
+  CHECK(restored.bRolls.at(0).kenburnsData == timeline.kenburnsData);
+  CHECK_FALSE(restored.bRolls.at(0).cropData.has_value());
+  CHECK(restored.layers.at(0).data->at("text") == "Title");
+  CHECK(restored.transitions.at(0).properties == transition.properties);
+  CHECK_FALSE(restored.transitions.at(0).easing.has_value());
+  CHECK_FALSE(restored.deprecatedAudio.has_value());
+}
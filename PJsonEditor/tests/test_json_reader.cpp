@@ -0,0 +1,102 @@
+#include <optional>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/JsonReader.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// The message of an error response (its body is the serialized JSON).
+std::string errorMessage(const Response &resp) {
+  return nlohmann::json::parse(resp.body.get<std::string>())["msg"];
+}
+
+} // namespace
+
+TEST_CASE("fields are read when present and of the right type") {
+  nlohmann::json data = {{"name", "Intro"},
+                         {"count", 3},
+                         {"ratio", 1.5},
+                         {"tags", {"a", "b"}},
+                         {"cut", nullptr}};
+  JsonReader in(data);
+  std::string name;
+  int count = 0;
+  double ratio = 0;
+  std::vector<std::string> tags;
+  std::optional<int> cut = 7;
+  int untouched = 42;
+  in.read("name", name)
+      .read("count", count)
+      .read("ratio", ratio)
+      .read("tags", tags)
+      .read("cut", cut)
+      .read("absent", untouched);
+  CHECK(in.ok());
+  CHECK(name == "Intro");
+  CHECK(count == 3);
+  CHECK(ratio == 1.5);
+  CHECK(tags == std::vector<std::string>{"a", "b"});
+  CHECK_FALSE(cut.has_value());
+  CHECK(untouched == 42);
+}
+
+TEST_CASE("the first error is kept with the path of the field") {
+  nlohmann::json data = {
+      {"layers", {{{"id", "l0"}}, {{"id", 5}}}},
+      {"script", {{"text", false}}}};
+  JsonReader in(data);
+  std::vector<std::string> ids;
+  in.forEach("layers", [&ids](JsonReader &layer) {
+    std::string id;
+    layer.read("id", id);
+    ids.push_back(id);
+  });
+  std::string text;
+  in.child("script").read("text", text);
+  CHECK_FALSE(in.ok());
+  CHECK(in.error() == "layers[1].id: unexpected number");
+  CHECK(ids == std::vector<std::string>{"l0", ""});
+
+  int position = 0;
+  JsonReader empty(nlohmann::json::object());
+  empty.require("addPosition", position);
+  CHECK(empty.error() == "addPosition: missing");
+}
+
+TEST_CASE("bad request bodies get a 400 instead of an exception") {
+  PJsonEditor editor(makeSceneList(1));
+
+  Response resp = editor.call({"POST", "/v3/project/p1/scene/add",
+                               nlohmann::json::object(), {}});
+  CHECK(resp.status_code == 400);
+  CHECK(errorMessage(resp) == "Invalid request body: addPosition: missing");
+
+  resp = editor.call({"PUT", "/v3/project/p1/scene/rename",
+                      {{"sceneUuid", 12}, {"name", "x"}}, {}});
+  CHECK(resp.status_code == 400);
+  CHECK(errorMessage(resp) == "Invalid request body: sceneUuid: unexpected number");
+
+  resp = editor.call({"PUT", "/v3/project/p1/scene/rename", "scene-0", {}});
+  CHECK(resp.status_code == 400);
+  CHECK(errorMessage(resp) == "Invalid request body: expected an object, got string");
+
+  resp = editor.call(
+      {"POST", "/v3/project/p1/batch",
+       {{"operations",
+         {{{"op", "renameScene"}, {"body", {{"sceneUuid", "scene-0"}}}},
+          {{"op", "setSceneTime"},
+           {"body", {{"sceneUuid", "scene-0"}, {"newDuration", "long"}}}}}}},
+       {}});
+  CHECK(resp.status_code == 400);
+  CHECK(errorMessage(resp) ==
+        "Invalid request body: operations[1].body.newDuration: unexpected string");
+
+  // Nothing was applied.
+  resp = editor.call({"GET", "/v3/project/p1/scenes", nullptr, {}});
+  CHECK(resp.body["data"]["scenes"][0]["name"] == "Scene 0");
+}
@@ -0,0 +1,138 @@
+#include <memory>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/LayerPartitioner.h>
+using namespace pjson;
+
+namespace {
+
+BaseLayer layer(const std::string &uuid, const std::string &type, int offset,
+                int duration) {
+  BaseLayer l;
+  l.uuid = uuid;
+  l.type = type;
+  l.timeOffsetInScene = offset;
+  l.duration = duration;
+  return l;
+}
+
+// uuid:offset+duration for each layer, in order.
+std::string describe(const std::vector<BaseLayer> &layers) {
+  std::string out;
+  for (const auto &l : layers) {
+    out += (out.empty() ? "" : " ") + l.uuid + ":" +
+           std::to_string(l.timeOffsetInScene) + "+" + std::to_string(l.duration);
+  }
+  return out;
+}
+
+std::function<std::string()> counter() {
+  auto next = std::make_shared<int>(0);
+  return [next] { return "new-" + std::to_string((*next)++); };
+}
+
+} // namespace
+
+TEST_CASE("split clips layers to each half and rebases the second") {
+  std::vector<BaseLayer> layers = {
+      layer("before", "sticker", 500, 1000),    // [500, 1500)
+      layer("spanning", "text", 1500, 2000),    // [1500, 3500)
+      layer("after", "sticker", 3000, 1000),    // [3000, 4000)
+      layer("overlong", "text", 4000, 5000),    // past the scene end
+      layer("avatar", "avatar", 0, -1),         // whole scene
+      layer("marker", "narration", 2000, 0)};
+  std::vector<BaseLayer> first, second;
+  splitLayers(layers, 2000, 5000, first, second, counter());
+
+  CHECK(describe(first) == "before:500+1000 spanning:1500+500 avatar:0+-1");
+  CHECK(describe(second) == "new-0:0+1500 after:1000+1000 overlong:2000+1000 "
+                            "new-1:0+-1 marker:0+0");
+  CHECK(layers.empty());
+}
+
+TEST_CASE("merge rebases the latter and resolves whole-scene layers") {
+  std::vector<BaseLayer> former = {layer("f-text", "text", 1000, 500),
+                                   layer("f-avatar", "avatar", 0, -1),
+                                   layer("f-look", "look", 0, -1)};
+  std::vector<BaseLayer> latter = {layer("l-text", "text", 0, 4000),
+                                   layer("l-avatar", "avatar", 0, -1),
+                                   layer("l-bg", "background", 0, -1)};
+  // Former 2000 ms, latter 3000 ms with 500 ms of pause dropped.
+  mergeLayers(former, latter, 2000, 3000, 4500);
+
+  CHECK(describe(former) == "f-text:1000+500 f-avatar:0+-1 f-look:0+2000 "
+                            "l-text:2000+2500 l-bg:2000+2500");
+  CHECK(latter.empty());
+}
+
+TEST_CASE("cut shortens layers and drops those inside a cut") {
+  std::vector<BaseLayer> layers = {
+      layer("across", "text", 500, 2000),   // [500, 2500) loses [1000, 2000)
+      layer("inside", "sticker", 1200, 500),
+      layer("after", "sticker", 3000, 1000),
+      layer("avatar", "avatar", 0, -1),
+      layer("marker", "narration", 1500, 0)};
+  SceneCutList cuts({{1000, 2000}}, 5000);
+  cutLayers(layers, cuts, 5000);
+
+  CHECK(describe(layers) ==
+        "across:500+1000 after:2000+1000 avatar:0+-1 marker:1000+0");
+}
+
+TEST_CASE("split, merge and cut carry layers through the API") {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < 2; ++i) {
+    scenes.push_back(
+        {{"sceneUuid", "scene-" + std::to_string(i)},
+         {"projectUuid", "p1"},
+         {"name", "Scene " + std::to_string(i)},
+         {"duration", 4000},
+         {"timeOffsetInProject", i * 4000},
+         {"sceneType", "default"},
+         {"layers",
+          {{{"uuid", "sticker-" + std::to_string(i)},
+            {"type", "sticker"},
+            {"timeOffsetInScene", 1000},
+            {"duration", 2000},
+            {"data", {{"emoji", "star"}}}}}}});
+  }
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(nlohmann::json{
+      {"code", 0},
+      {"msg", "success"},
+      {"data", {{"projectUuid", "p1"}, {"scenes", scenes}}}}));
+  ExtendedControllerAPI api;
+  api.setDataStore(dataStore);
+  const auto &project = dataStore->getCurrentProjectData();
+  REQUIRE(describe(project.scenes[0].layers) == "sticker-0:1000+2000");
+
+  ExtendedProjectSceneSplitReqBody split;
+  split.sceneUuid = "scene-0";
+  split.splitTime = 2000;
+  ApiResult result = api.splitScene(split);
+  REQUIRE(result.isSuccess());
+  CHECK(describe(project.scenes[0].layers) == "sticker-0:1000+1000");
+  REQUIRE(project.scenes[1].layers.size() == 1);
+  CHECK(project.scenes[1].layers[0].timeOffsetInScene == 0);
+  CHECK(project.scenes[1].layers[0].duration == 1000);
+  CHECK(project.scenes[1].layers[0].data->at("emoji") == "star");
+  CHECK(result.patch[1]["value"]["layers"][0]["duration"] == 1000);
+  CHECK(result.data[1]["scene"]["layers"].size() == 1);
+
+  ExtendedProjectSceneMergeReqBody merge;
+  merge.sceneUuids = {project.scenes[1].uuid, "scene-1"};
+  REQUIRE(api.mergeScenes(merge).isSuccess());
+  REQUIRE(project.scenes.size() == 2);
+  CHECK(describe(project.scenes[1].layers).find("sticker-1:3000+2000") !=
+        std::string::npos);
+
+  ExtendedProjectSceneCutReqBody cut;
+  cut.sceneUuid = project.scenes[1].uuid;
+  cut.cutList = {{3500, 4500}};
+  REQUIRE(api.cutScene(cut).isSuccess());
+  CHECK(describe(project.scenes[1].layers).find("sticker-1:3000+1000") !=
+        std::string::npos);
+}
@@ -0,0 +1,206 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/OpLog.h>
+#include <pjson_editor/ProjectCheckpoint.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// Three 5s scenes with an a-roll, a b-roll and a short transcript, plus a
+// bgm and its asset.
+nlohmann::json makeSceneList() {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < 3; ++i) {
+    std::string uuid = "scene-" + std::to_string(i);
+    int offset = i * 5000;
+    nlohmann::json scene = makeScene(i, offset);
+    scene["transcript"] = {
+        {"items",
+         {{{"text", "hello"}, {"startMs", 0}, {"endMs", 400}},
+          {{"text", "world"}, {"startMs", 400}, {"endMs", 900}}}}};
+    scene["arolls"] = {makeTimeline("a-" + std::to_string(i), uuid, offset, 5000)};
+    scene["brolls"] = {
+        makeTimeline("b-" + std::to_string(i), uuid, offset + 1000, 2000)};
+    scenes.push_back(scene);
+  }
+  return sceneListResponse(
+      scenes, {{"assets",
+                {{"asset",
+                  {{"assetUuid", "asset"},
+                   {"assetLink", "https://example.com/a.mp4"},
+                   {"assetType", "video"},
+                   {"duration", 60000}}}}},
+               {"bgms",
+                {{{"timelineUuid", "bgm-1"},
+                  {"assetUuid", "asset"},
+                  {"assetLink", "https://example.com/a.mp4"},
+                  {"duration", 15000}}}}});
+}
+
+nlohmann::json state(PJsonEditor &editor) {
+  return editor.call({"GET", "/v3/project/p1/scenes", {}, {}}).body["data"];
+}
+
+// Edits that create ids (addScene) and then use them, a failing call and a
+// read, none of which the log may get wrong.
+void edit(PJsonEditor &editor, int round) {
+  REQUIRE(editor
+              .call({"POST",
+                     "/v3/project/p1/scene/add",
+                     {{"addPosition", 1}, {"duration", 3000}},
+                     {}})
+              .status_code == 200);
+  std::string added = state(editor)["scenes"][1]["sceneUuid"];
+  REQUIRE(editor
+              .call({"PUT",
+                     "/v3/project/p1/scene/rename",
+                     {{"sceneUuid", added},
+                      {"name", "Added " + std::to_string(round)}},
+                     {}})
+              .status_code == 200);
+  CHECK(editor
+            .call({"PUT",
+                   "/v3/project/p1/scene/rename",
+                   {{"sceneUuid", "missing"}, {"name", "x"}},
+                   {}})
+            .status_code == 400);
+  REQUIRE(editor
+              .call({"POST",
+                     "/v3/project/p1/scene/time/set",
+                     {{"sceneUuid", "scene-0"}, {"newDuration", 4000 + round}},
+                     {}})
+              .status_code == 200);
+}
+
+} // namespace
+
+TEST_CASE("project checkpoints round-trip every field") {
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(makeSceneList()));
+  auto &project = dataStore->getProject();
+  project.version = 7;
+  project.sceneListVersion = 5;
+  project.scenes[1].version = 6;
+  project.scenes[1].aRolls[0].speed = 1.5;
+  project.scenes[1].aRolls[0].category = ProjectTimelineCategoryEnum::AROLL;
+  project.scenes[1].scale = SceneScale{2.0, 2.0, 0.0, 0.0, std::nullopt};
+  project.scenes[2].layers.push_back({"layer-1", "text", 0, 1000, {{"k", 1}}});
+  project.style = nlohmann::json{{"font", "serif"}};
+
+  nlohmann::json encoded = encodeProjectCheckpoint(project);
+  Expected<ExtendedProjectAndScenesVo> result = decodeProjectCheckpoint(encoded);
+  REQUIRE(result.has_value());
+  const ExtendedProjectAndScenesVo &decoded = *result;
+  CHECK(encodeProjectCheckpoint(decoded) == encoded);
+  CHECK(decoded.version == 7);
+  CHECK(decoded.sceneListVersion == 5);
+  CHECK(decoded.scenes[1].version == 6);
+  CHECK(decoded.scenes[1].aRolls[0].speed == 1.5);
+  CHECK(decoded.scenes[1].aRolls[0].category ==
+        ProjectTimelineCategoryEnum::AROLL);
+  CHECK(decoded.scenes[1].scale->scaleX == 2.0);
+  CHECK(decoded.scenes[0].transcript->items.size() == 2);
+  CHECK(decoded.assets.at("asset").duration == 60000);
+  CHECK(decoded.bgms.size() == 1);
+
+  // Survives the CBOR round trip the op log puts it through.
+  CHECK(nlohmann::json::from_cbor(nlohmann::json::to_cbor(encoded)) == encoded);
+
+  // A damaged checkpoint is reported, not thrown.
+  encoded["scenes"][1]["aRolls"][0]["speed"] = "fast";
+  Expected<ExtendedProjectAndScenesVo> damaged = decodeProjectCheckpoint(encoded);
+  REQUIRE_FALSE(damaged.has_value());
+  CHECK(damaged.error() == "scenes[1].aRolls[0].speed: unexpected string");
+}
+
+TEST_CASE("recovering from a stream log reproduces the session") {
+  std::stringstream stream;
+  PJsonEditor editor(makeSceneList());
+  editor.setOpLog(std::make_shared<OpLog>(stream));
+  edit(editor, 1);
+  edit(editor, 2);
+  nlohmann::json expected = state(editor);
+
+  RecoveredLog log;
+  std::string error;
+  REQUIRE(loadOpLog(stream, log, &error));
+  CHECK_FALSE(log.truncated);
+  CHECK(log.version == 1);
+  CHECK(log.ops.size() == 6);
+
+  PJsonEditor recovered(nlohmann::json::object());
+  REQUIRE(recovered.recover(log, &error));
+  CHECK(state(recovered) == expected);
+
+  // The recovered editor keeps handing out fresh ids.
+  edit(recovered, 3);
+  CHECK(state(recovered)["scenes"].size() == expected["scenes"].size() + 1);
+}
+
+TEST_CASE("a file log is compacted at checkpoints and survives a torn tail") {
+  const std::string path = "test_op_log.bin";
+  OpLogOptions options;
+  options.checkpointInterval = 4;
+  PJsonEditor editor(makeSceneList());
+  auto log = std::make_shared<OpLog>(path, options);
+  REQUIRE(log->isOpen());
+  editor.setOpLog(log);
+  edit(editor, 1);
+  edit(editor, 2);
+  edit(editor, 3);
+  log->flush();
+  nlohmann::json expected = state(editor);
+
+  // Nine ops: two checkpoints were taken, the last after op 8.
+  RecoveredLog recoveredLog;
+  std::string error;
+  REQUIRE(loadOpLog(path, recoveredLog, &error));
+  CHECK(recoveredLog.version == 9);
+  REQUIRE(recoveredLog.ops.size() == 1);
+  PJsonEditor recovered(nlohmann::json::object());
+  REQUIRE(recovered.recover(recoveredLog, &error));
+  CHECK(state(recovered) == expected);
+
+  // Cut the last frame short: recovery stops at the checkpoint before it.
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  std::stringstream torn(bytes.substr(0, bytes.size() - 3));
+  REQUIRE(loadOpLog(torn, recoveredLog, &error));
+  CHECK(recoveredLog.truncated);
+  CHECK(recoveredLog.ops.empty());
+  PJsonEditor partial(nlohmann::json::object());
+  REQUIRE(partial.recover(recoveredLog, &error));
+  CHECK(partial.call({"GET", "/v3/project/p1/scenes", {}, {}})
+            .headers["ETag"] == "\"9\"");
+
+  log.reset();
+  editor.setOpLog(nullptr);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("loadOpLog rejects what is not a log") {
+  RecoveredLog log;
+  std::string error;
+  std::stringstream garbage("not a log");
+  CHECK_FALSE(loadOpLog(garbage, log, &error));
+  CHECK_FALSE(error.empty());
+
+  std::stringstream empty;
+  CHECK_FALSE(loadOpLog(empty, log, &error));
+
+  // A header without a checkpoint has nothing to recover from.
+  std::stringstream headerOnly;
+  { OpLog writer(headerOnly); }
+  CHECK_FALSE(loadOpLog(headerOnly, log, &error));
+}
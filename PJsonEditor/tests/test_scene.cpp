@@ -1,7 +1,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_IMPLEMENT
 #include "api_request_client.hpp"
 #include <doctest/doctest.h>
 #include <pjson_editor/ExtendedAPI.h>
@@ -30,6 +30,19 @@ public:
     executor = std::make_shared<pjson::PJsonEditor>(serverResponse);
   }
 
+  // Runs a request against the local editor and reports its latency next to
+  // the backend's.
+  pjson::Response localCall(pjson::Request req) {
+    auto start = std::chrono::steady_clock::now();
+    pjson::Response resp = executor->call(req);
+    apiClient.reportLocalLatency(
+        req.method, req.url,
+        std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    return resp;
+  }
+
   ~TestSceneContext() {
     if (sceneUuid.empty())
       return;
@@ -54,8 +67,7 @@ TEST_CASE_FIXTURE(TestSceneContext, "/v3/project/{projectUuid}/scene/") {
       check_scene_name(serverResponse, "New scene");
     }
     {
-      auto r =
-          executor->call({.method = "POST",
+      auto r = localCall({.method = "POST",
                           .url = "/v3/project/" + PROPJECT_UUID + "/scene/add",
                           .body = requestBody});
       check_scene_name(r.body, "New scene");
@@ -69,7 +81,7 @@ TEST_CASE_FIXTURE(TestSceneContext, "/v3/project/{projectUuid}/scene/") {
     nlohmann::json serverResponse = apiClient.post(
         "/v3/project/" + PROPJECT_UUID + "/scene/rename", requestBody, "PUT");
               requestBody["sceneUuid"] = localSceneUuid;
-      auto r = executor->call(
+      auto r = localCall(
           {.method = "PUT",
            .url = "/v3/project/" + PROPJECT_UUID + "/scene/rename",
            .body = requestBody});
@@ -89,7 +101,7 @@ TEST_CASE_FIXTURE(TestSceneContext, "/v3/project/{projectUuid}/scene/") {
           "/v3/project/" + PROPJECT_UUID + "/scene/split", requestBody, "PUT");
 
       requestBody["sceneUuid"] = localSceneUuid;
-      auto r = executor->call(
+      auto r = localCall(
           {.method = "PUT",
            .url = "/v3/project/" + PROPJECT_UUID + "/scene/split",
            .body = requestBody});
@@ -112,7 +124,7 @@ TEST_CASE_FIXTURE(TestSceneContext, "/v3/project/{projectUuid}/scene/") {
       nlohmann::json serverResponse = apiClient.post(
           "/v3/project/" + PROPJECT_UUID + "/scene/merge", requestBody, "PUT");
       requestBody["sceneUuids"] = {localSplitedSceneUuid[0], localSplitedSceneUuid[1]};
-      auto r = executor->call(
+      auto r = localCall(
           {.method = "PUT",
            .url = "/v3/project/" + PROPJECT_UUID + "/scene/merge",
            .body = requestBody});
@@ -126,10 +138,19 @@ TEST_CASE_FIXTURE(TestSceneContext, "/v3/project/{projectUuid}/scene/") {
   {
     apiClient.del("/v3/project/" + PROPJECT_UUID + "/scene/delete",
                   {{"sceneUuid", sceneUuid}});
-    executor->call({.method = "DELETE",
-                    .url = "/v3/project/" + PROPJECT_UUID + "/scene/delete",
-                    .body = {{"sceneUuid", sceneUuid}}});
+    localCall({.method = "DELETE",
+               .url = "/v3/project/" + PROPJECT_UUID + "/scene/delete",
+               .body = {{"sceneUuid", sceneUuid}}});
   }
 
   // Local ExtendedAPI comparison
 }
+
+int main(int argc, char **argv) {
+  if (!FixtureBackend::canRun()) {
+    std::cout << "No backend fixtures to replay; skipping." << std::endl;
+    return 77; // ctest SKIP_RETURN_CODE
+  }
+  doctest::Context context(argc, argv);
+  return context.run();
+}
@@ -0,0 +1,319 @@
+#include <memory>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/SceneCutUtils.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// Two 10s scenes. Scene 0 has an a-roll over the whole scene, a b-roll from
+// 2s to 6s, a voice-over from 1s to 9s and one transcript word per second.
+nlohmann::json makeSceneList() {
+  nlohmann::json transcriptItems = nlohmann::json::array();
+  std::string text;
+  for (int i = 0; i < 10; ++i) {
+    std::string word = "w" + std::to_string(i);
+    transcriptItems.push_back(
+        {{"startMs", i * 1000}, {"endMs", (i + 1) * 1000}, {"text", word}});
+    text += (i ? " " : "") + word;
+  }
+  nlohmann::json scene0 = makeScene(0, 0, 10000);
+  scene0["transcript"] = {{"text", text}, {"items", transcriptItems}};
+  scene0["arolls"] = {makeTimeline("a-0", "scene-0", 0, 10000, 500)};
+  scene0["brolls"] = {makeTimeline("b-0", "scene-0", 2000, 4000)};
+  scene0["voiceOvers"] = {makeVoiceOver("voice-0", "scene-0", 1000, 8000)};
+  nlohmann::json scene1 = makeScene(1, 10000, 10000);
+  scene1["arolls"] = {makeTimeline("a-1", "scene-1", 10000, 10000)};
+  return sceneListResponse({scene0, scene1});
+}
+
+struct Fixture {
+  std::shared_ptr<ExtendedDataStore> dataStore =
+      std::make_shared<ExtendedDataStore>();
+  ExtendedControllerAPI api;
+
+  Fixture() {
+    dataStore->init(
+        std::make_shared<ExtendedProjectAndScenesVo>(makeSceneList()));
+    api.setDataStore(dataStore);
+  }
+
+  // The b-roll of scene 0 reads its 4s of media at `speed`.
+  void setBRollSpeed(double speed) {
+    auto &bRoll = dataStore->getProject().scenes[0].bRolls[0];
+    bRoll.speed = speed;
+    bRoll.endTime = bRoll.startTime + static_cast<int>(bRoll.duration * speed);
+  }
+
+  ApiResult cut(const std::vector<TimePeriod> &cutList) {
+    ExtendedProjectSceneCutReqBody req;
+    req.sceneUuid = "scene-0";
+    req.cutList = cutList;
+    return api.cutScene(req);
+  }
+};
+
+} // namespace
+
+TEST_CASE("SceneCutList merges, clips and maps times") {
+  SceneCutList cuts({{5000, 6000}, {-100, 200}, {5500, 7000}, {7000, 7100},
+                     {9000, 12000}, {3000, 3000}},
+                    10000);
+  const auto &periods = cuts.periods();
+  REQUIRE(periods.size() == 3);
+  CHECK(periods[0].start == 0);
+  CHECK(periods[0].end == 200);
+  CHECK(periods[1].start == 5000);
+  CHECK(periods[1].end == 7100);
+  CHECK(periods[2].start == 9000);
+  CHECK(periods[2].end == 10000);
+  CHECK(cuts.removed() == 200 + 2100 + 1000);
+
+  CHECK(cuts.mapTime(0) == 0);
+  CHECK(cuts.mapTime(200) == 0);
+  CHECK(cuts.mapTime(1000) == 800);
+  CHECK(cuts.mapTime(6000) == 4800);
+  CHECK(cuts.mapTime(7100) == 4800);
+  CHECK(cuts.mapTime(10000) == 6700);
+
+  std::vector<TimePeriod> kept;
+  cuts.forEachKept(100, 9500, [&kept](int start, int end) {
+    kept.push_back({start, end});
+  });
+  REQUIRE(kept.size() == 2);
+  CHECK(kept[0].start == 200);
+  CHECK(kept[0].end == 5000);
+  CHECK(kept[1].start == 7100);
+  CHECK(kept[1].end == 9000);
+}
+
+TEST_CASE_FIXTURE(Fixture, "cutScene trims and splits timelines") {
+  ApiResult result = cut({{4000, 5000}, {1500, 2500}});
+  REQUIRE(result.isSuccess());
+
+  auto &scenes = dataStore->getProject().scenes;
+  const auto &scene = scenes[0];
+  CHECK(scene.duration == 8000);
+  CHECK(scenes[1].timeOffsetInProject == 8000);
+  CHECK(scenes[1].aRolls[0].timeOffsetInProject == 8000);
+
+  // The a-roll loses both ranges of its asset.
+  REQUIRE(scene.aRolls.size() == 3);
+  CHECK(scene.aRolls[0].uuid == "a-0");
+  CHECK(scene.aRolls[1].uuid != "a-0");
+  CHECK(scene.aRolls[2].uuid != scene.aRolls[1].uuid);
+  const int expected[3][3] = {// in scene, asset start, duration
+                              {0, 500, 1500},
+                              {1500, 3000, 1500},
+                              {3000, 5500, 5000}};
+  for (int i = 0; i < 3; ++i) {
+    CHECK(scene.aRolls[i].timeOffsetInScene == expected[i][0]);
+    CHECK(scene.aRolls[i].timeOffsetInProject == expected[i][0]);
+    CHECK(scene.aRolls[i].startTime == expected[i][1]);
+    CHECK(scene.aRolls[i].duration == expected[i][2]);
+    CHECK(scene.aRolls[i].endTime == expected[i][1] + expected[i][2]);
+  }
+
+  // The b-roll [2000, 6000) starts inside the first cut.
+  REQUIRE(scene.bRolls.size() == 2);
+  CHECK(scene.bRolls[0].timeOffsetInScene == 1500);
+  CHECK(scene.bRolls[0].startTime == 500);
+  CHECK(scene.bRolls[0].duration == 1500);
+  CHECK(scene.bRolls[1].timeOffsetInScene == 3000);
+  CHECK(scene.bRolls[1].startTime == 3000);
+  CHECK(scene.bRolls[1].duration == 1000);
+
+  // The voice-over [1000, 9000) keeps 6s in three parts.
+  REQUIRE(scene.voiceOvers.size() == 3);
+  int voiceOverTotal = 0;
+  for (const auto &voiceOver : scene.voiceOvers) {
+    voiceOverTotal += voiceOver.duration;
+  }
+  CHECK(voiceOverTotal == 6000);
+  CHECK(scene.voiceOvers[0].timeOffsetInProject == 1000);
+  CHECK(scene.voiceOvers[2].timeOffsetInProject == 3000);
+  CHECK(scene.voiceOvers[2].startTime == 4000);
+
+  // w4 lies entirely inside a cut; w1 and w2 are trimmed.
+  REQUIRE(scene.transcript.has_value());
+  REQUIRE(scene.transcript->items.size() == 9);
+  CHECK(scene.transcript->text == "w0 w1 w2 w3 w5 w6 w7 w8 w9");
+  CHECK(scene.transcript->items[1].startMs == 1000);
+  CHECK(scene.transcript->items[1].endMs == 1500);
+  CHECK(scene.transcript->items[2].startMs == 1500);
+  CHECK(scene.transcript->items[2].endMs == 2000);
+  CHECK(scene.transcript->items.back().endMs == 8000);
+
+  REQUIRE(result.patch.size() == 2);
+  CHECK(result.patch[0]["path"] == "/scenes/0");
+  CHECK(result.patch[1]["value"] == 8000);
+}
+
+TEST_CASE_FIXTURE(Fixture, "cutScene keeps project timelines and bgms in step") {
+  ProjectBgm bgm;
+  bgm.uuid = "bgm-0";
+  bgm.duration = 20000;
+  dataStore->getProject().bgms.push_back(bgm);
+  ApiResult result = cut({{3000, 4000}});
+  REQUIRE(result.isSuccess());
+
+  // The project-level copies match the scene tracks, shifted like them.
+  const auto &project = dataStore->getCurrentProjectData();
+  const auto &scene = project.scenes[0];
+  REQUIRE(project.timelines.size() ==
+          scene.aRolls.size() + scene.bRolls.size() + 1);
+  std::vector<ExtendedTimeline> tracks = scene.aRolls;
+  tracks.insert(tracks.end(), scene.bRolls.begin(), scene.bRolls.end());
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    CHECK(project.timelines[i].uuid == tracks[i].uuid);
+    CHECK(project.timelines[i].timeOffsetInProject == tracks[i].timeOffsetInProject);
+    CHECK(project.timelines[i].duration == tracks[i].duration);
+    CHECK(project.timelines[i].endTime == tracks[i].endTime);
+  }
+  CHECK(project.timelines.back().uuid == "a-1");
+  CHECK(project.timelines.back().timeOffsetInProject == 9000);
+
+  CHECK(project.bgms[0].duration == 19000);
+  CHECK(result.patch.back()["path"] == "/bgms/0/duration");
+  CHECK(result.patch.back()["value"] == 19000);
+
+  // Later edits start from the shifted offsets.
+  ProjectSceneFootageAddReqBody add;
+  add.sceneUuid = "scene-1";
+  add.assetUuid = "asset";
+  add.duration = 1000;
+  REQUIRE(api.addFootage(add).isSuccess());
+  CHECK(project.timelines.back().timeOffsetInProject ==
+        project.scenes[1].bRolls.back().timeOffsetInProject);
+}
+
+TEST_CASE_FIXTURE(Fixture, "cutScene with hundreds of ranges") {
+  // Remove 10ms out of every 40ms, like a silence-removal pass.
+  std::vector<TimePeriod> cutList;
+  for (int t = 30; t < 10000; t += 40) {
+    cutList.push_back({t, t + 10});
+  }
+  REQUIRE(cut(cutList).isSuccess());
+
+  const auto &scenes = dataStore->getProject().scenes;
+  CHECK(scenes[0].duration == 7500);
+  CHECK(scenes[1].timeOffsetInProject == 7500);
+  REQUIRE(scenes[0].aRolls.size() == cutList.size());
+  int offset = 0;
+  for (const auto &part : scenes[0].aRolls) {
+    CHECK(part.timeOffsetInScene == offset);
+    offset += part.duration;
+  }
+  CHECK(offset == 7500);
+}
+
+TEST_CASE_FIXTURE(Fixture, "cutScene rejects removing the whole scene") {
+  ApiResult result = cut({{0, 6000}, {5000, 10000}});
+  CHECK_FALSE(result.isSuccess());
+  CHECK(dataStore->getProject().scenes[0].duration == 10000);
+
+  // Ranges outside the scene change nothing.
+  result = cut({{12000, 13000}});
+  REQUIRE(result.isSuccess());
+  CHECK(result.patch.empty());
+  CHECK(dataStore->getProject().scenes[0].aRolls.size() == 1);
+}
+
+TEST_CASE_FIXTURE(Fixture, "cutScene scales media time by the playback speed") {
+  setBRollSpeed(2.0);
+  REQUIRE(cut({{3000, 4000}}).isSuccess());
+
+  // The b-roll [2000, 6000) at 2x reads media 0..8000; [3000, 4000) of
+  // scene time is 2000..4000 of media.
+  const auto &bRolls = dataStore->getProject().scenes[0].bRolls;
+  REQUIRE(bRolls.size() == 2);
+  CHECK(bRolls[0].startTime == 0);
+  CHECK(bRolls[0].endTime == 2000);
+  CHECK(bRolls[1].startTime == 4000);
+  CHECK(bRolls[1].endTime == 8000);
+  CHECK(bRolls[1].duration == 2000);
+}
+
+TEST_CASE_FIXTURE(Fixture, "splitScene divides the media window of spanning timelines") {
+  setBRollSpeed(2.0);
+  ExtendedProjectSceneSplitReqBody req;
+  req.sceneUuid = "scene-0";
+  req.splitTime = 4000;
+  ApiResult result = api.splitScene(req);
+  REQUIRE(result.isSuccess());
+
+  const auto &scenes = dataStore->getProject().scenes;
+  REQUIRE(scenes.size() == 3);
+  const auto &first = scenes[0];
+  const auto &second = scenes[1];
+
+  // a-roll [0, 10000) from media 500
+  CHECK(first.aRolls[0].startTime == 500);
+  CHECK(first.aRolls[0].endTime == 4500);
+  CHECK(first.aRolls[0].duration == 4000);
+  CHECK(second.aRolls[0].timeOffsetInScene == 0);
+  CHECK(second.aRolls[0].timeOffsetInProject == 4000);
+  CHECK(second.aRolls[0].startTime == 4500);
+  CHECK(second.aRolls[0].endTime == 10500);
+  CHECK(second.aRolls[0].duration == 6000);
+
+  // b-roll [2000, 6000) at 2x
+  CHECK(first.bRolls[0].endTime == 4000);
+  CHECK(second.bRolls[0].startTime == 4000);
+  CHECK(second.bRolls[0].endTime == 8000);
+  CHECK(second.bRolls[0].duration == 2000);
+
+  // voice-over [1000, 9000)
+  CHECK(first.voiceOvers[0].endTime == 3000);
+  CHECK(second.voiceOvers[0].startTime == 3000);
+  CHECK(second.voiceOvers[0].endTime == 8000);
+  CHECK(second.voiceOvers[0].timeOffsetInProject == 4000);
+
+  // The scene patches carry the same windows.
+  REQUIRE(result.patch.size() == 2);
+  CHECK(result.patch[0]["value"]["bRolls"][0]["endTime"] == 4000);
+  CHECK(result.patch[1]["value"]["aRolls"][0]["startTime"] == 4500);
+  CHECK(result.patch[1]["value"]["aRolls"][0]["timeOffsetInScene"] == 0);
+  CHECK(result.patch[1]["value"]["voiceOvers"][0]["startTime"] == 3000);
+
+  // So do the project-level copies, now under the halves.
+  const auto &timelines = dataStore->getCurrentProjectData().timelines;
+  REQUIRE(timelines.size() == 5);
+  CHECK(timelines[0].sceneUuid == first.uuid);
+  CHECK(timelines[0].endTime == 4500);
+  CHECK(timelines[2].sceneUuid == second.uuid);
+  CHECK(timelines[2].startTime == 4500);
+  CHECK(timelines[2].timeOffsetInScene == 0);
+  CHECK(timelines[2].duration == 6000);
+  CHECK(timelines[3].startTime == 4000);
+  CHECK(timelines[4].uuid == "a-1");
+}
+
+TEST_CASE_FIXTURE(Fixture, "split and cut keep the media end of a timeline") {
+  // 4s at 1.3x reads 5.2s of media; the source says one more ms.
+  setBRollSpeed(1.3);
+  dataStore->getProject().scenes[0].bRolls[0].endTime += 1;
+
+  SUBCASE("split") {
+    ExtendedProjectSceneSplitReqBody req;
+    req.sceneUuid = "scene-0";
+    req.splitTime = 3333;
+    REQUIRE(api.splitScene(req).isSuccess());
+    const auto &scenes = dataStore->getCurrentProjectData().scenes;
+    CHECK(scenes[0].bRolls[0].endTime == 1733);  // 1333ms at 1.3x
+    CHECK(scenes[1].bRolls[0].startTime == 1733);
+    CHECK(scenes[1].bRolls[0].endTime == 5201);
+  }
+  SUBCASE("cut") {
+    REQUIRE(cut({{3000, 3333}}).isSuccess());
+    const auto &bRolls = dataStore->getCurrentProjectData().scenes[0].bRolls;
+    REQUIRE(bRolls.size() == 2);
+    CHECK(bRolls[0].endTime == 1300);
+    CHECK(bRolls[1].startTime == 1733);
+    CHECK(bRolls[1].endTime == 5201);
+  }
+}
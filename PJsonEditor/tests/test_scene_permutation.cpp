@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ScenePermutation.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+// Applies the moves to a list of old indices the way a JSON Patch consumer
+// would.
+std::vector<size_t> replayMoves(size_t n,
+                                const std::vector<PermutationMove> &moves) {
+  std::vector<size_t> list(n);
+  std::iota(list.begin(), list.end(), 0);
+  for (const auto &move : moves) {
+    REQUIRE(move.from < list.size());
+    size_t item = list[move.from];
+    list.erase(list.begin() + move.from);
+    REQUIRE(move.to <= list.size());
+    list.insert(list.begin() + move.to, item);
+  }
+  return list;
+}
+
+// Scenes of 1s, 2s, 3s, ..., all at offset 0.
+nlohmann::json makeGrowingSceneList(int count) {
+  nlohmann::json scenes = nlohmann::json::array();
+  for (int i = 0; i < count; ++i) {
+    scenes.push_back(makeScene(i, 0, 1000 * (i + 1)));
+  }
+  return sceneListResponse(scenes);
+}
+
+} // namespace
+
+TEST_CASE("applyPermutation reorders in place") {
+  std::vector<std::string> items{"a", "b", "c", "d", "e"};
+  applyPermutation(items, {3, 0, 4, 1, 2});
+  CHECK(items == std::vector<std::string>{"d", "a", "e", "b", "c"});
+}
+
+TEST_CASE("permutationMoves produces the target order with fewest moves") {
+  CHECK(permutationMoves({0, 1, 2, 3}).empty());
+  // Moving one scene to the front is a single move.
+  auto single = permutationMoves({3, 0, 1, 2});
+  REQUIRE(single.size() == 1);
+  CHECK(single[0].from == 3);
+  CHECK(single[0].to == 0);
+
+  std::mt19937 rng(11);
+  for (size_t n : {1, 2, 5, 17, 64, 300}) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    auto moves = permutationMoves(order);
+    CHECK(replayMoves(n, moves) == order);
+
+    // n minus the longest increasing run of old indices.
+    std::vector<size_t> tails;
+    for (size_t value : order) {
+      auto it = std::lower_bound(tails.begin(), tails.end(), value);
+      if (it == tails.end()) {
+        tails.push_back(value);
+      } else {
+        *it = value;
+      }
+    }
+    CHECK(moves.size() == n - tails.size());
+  }
+}
+
+TEST_CASE("setMainStoryOrder emits a move patch and recomputes offsets") {
+  nlohmann::json sceneList = makeGrowingSceneList(5);
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(sceneList));
+  ExtendedControllerAPI api;
+  api.setDataStore(dataStore);
+  dataStore->recomputeOffsets();
+
+  // The client's view before the change.
+  nlohmann::json view = {{"scenes", nlohmann::json::array()}};
+  for (const auto &scene : dataStore->getProject().scenes) {
+    view["scenes"].push_back({{"uuid", scene.uuid},
+                              {"timeOffsetInProject", scene.timeOffsetInProject}});
+  }
+
+  SetMainStoryOrderReqBody req;
+  req.timelineUuids = {"scene-3", "scene-1", "scene-3", "missing", "scene-0"};
+  ApiResult result = api.setMainStoryOrder(req);
+  REQUIRE(result.isSuccess());
+
+  const auto &scenes = dataStore->getProject().scenes;
+  std::vector<std::string> uuids;
+  for (const auto &scene : scenes) {
+    uuids.push_back(scene.uuid);
+  }
+  CHECK(uuids == std::vector<std::string>{"scene-3", "scene-1", "scene-0",
+                                          "scene-2", "scene-4"});
+  int offset = 0;
+  for (const auto &scene : scenes) {
+    CHECK(scene.timeOffsetInProject == offset);
+    offset += scene.duration;
+  }
+
+  nlohmann::json patched = view.patch(result.patch);
+  REQUIRE(patched["scenes"].size() == scenes.size());
+  for (size_t i = 0; i < scenes.size(); ++i) {
+    CHECK(patched["scenes"][i]["uuid"] == scenes[i].uuid);
+    CHECK(patched["scenes"][i]["timeOffsetInProject"] ==
+          scenes[i].timeOffsetInProject);
+  }
+}
+
+TEST_CASE("moveScene rotates the range and patches only its offsets") {
+  nlohmann::json sceneList = makeGrowingSceneList(6);
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(sceneList));
+  ExtendedControllerAPI api;
+  api.setDataStore(dataStore);
+  dataStore->recomputeOffsets();
+
+  nlohmann::json view = {{"scenes", nlohmann::json::array()}};
+  for (const auto &scene : dataStore->getProject().scenes) {
+    view["scenes"].push_back({{"uuid", scene.uuid},
+                              {"timeOffsetInProject", scene.timeOffsetInProject}});
+  }
+
+  std::vector<std::string> expected;
+  size_t first = 0, last = 0;
+  ExtendedProjectSceneMoveReqBody req;
+  SUBCASE("forward") {
+    req.uuid = "scene-1";
+    req.afterSceneUuid = "scene-3";
+    expected = {"scene-0", "scene-2", "scene-3", "scene-1", "scene-4", "scene-5"};
+    first = 1;
+    last = 3;
+  }
+  SUBCASE("backward") {
+    req.uuid = "scene-4";
+    req.afterSceneUuid = "scene-0";
+    expected = {"scene-0", "scene-4", "scene-1", "scene-2", "scene-3", "scene-5"};
+    first = 1;
+    last = 4;
+  }
+  SUBCASE("to the front") {
+    req.uuid = "scene-2";
+    expected = {"scene-2", "scene-0", "scene-1", "scene-3", "scene-4", "scene-5"};
+    first = 0;
+    last = 2;
+  }
+  ApiResult result = api.moveScene(req);
+  REQUIRE(result.isSuccess());
+
+  const auto &scenes = dataStore->getProject().scenes;
+  std::vector<std::string> uuids;
+  int offset = 0;
+  for (const auto &scene : scenes) {
+    uuids.push_back(scene.uuid);
+    CHECK(scene.timeOffsetInProject == offset);
+    offset += scene.duration;
+  }
+  CHECK(uuids == expected);
+
+  // One move plus one offset per scene of the rotated range.
+  REQUIRE(result.patch.size() == 1 + last - first + 1);
+  CHECK(result.patch[0]["op"] == "move");
+  nlohmann::json patched = view.patch(result.patch);
+  for (size_t i = 0; i < scenes.size(); ++i) {
+    CHECK(patched["scenes"][i]["uuid"] == scenes[i].uuid);
+    CHECK(patched["scenes"][i]["timeOffsetInProject"] ==
+          scenes[i].timeOffsetInProject);
+  }
+}
+
+TEST_CASE("moveScene after its own predecessor is a no-op") {
+  nlohmann::json sceneList = makeGrowingSceneList(3);
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(sceneList));
+  ExtendedControllerAPI api;
+  api.setDataStore(dataStore);
+
+  ExtendedProjectSceneMoveReqBody req;
+  req.uuid = "scene-2";
+  req.afterSceneUuid = "scene-1";
+  ApiResult result = api.moveScene(req);
+  REQUIRE(result.isSuccess());
+  CHECK(result.patch.empty());
+  CHECK(dataStore->getProject().scenes[2].uuid == "scene-2");
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include <sstream>
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/SessionRecorder.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+TEST_CASE("SessionRecorder round-trips a recorded session") {
+  nlohmann::json sceneList = makeSceneList(3);
+  std::stringstream stream;
+  auto recorder = std::make_shared<SessionRecorder>(stream, sceneList);
+
+  PJsonEditor editor(sceneList);
+  editor.setSessionRecorder(recorder);
+  Request rename{"PUT",
+                 "/v3/project/p1/scene/rename",
+                 {{"sceneUuid", "scene-1"}, {"name", "Renamed"}},
+                 {{"X-Trace", "t1"}}};
+  Request missing{"PUT",
+                  "/v3/project/p1/scene/rename",
+                  {{"sceneUuid", "nope"}, {"name", "x"}},
+                  {}};
+  Response ok = editor.call(rename);
+  Response notFound = editor.call(missing);
+  CHECK(recorder->recordedCount() == 2);
+
+  RecordedSession session;
+  std::string error;
+  REQUIRE(loadSession(stream, session, &error));
+  CHECK(session.sceneList == sceneList);
+  REQUIRE(session.calls.size() == 2);
+  CHECK(session.calls[0].request.method == "PUT");
+  CHECK(session.calls[0].request.url == rename.url);
+  CHECK(session.calls[0].request.body == rename.body);
+  CHECK(session.calls[0].request.headers.at("X-Trace") == "t1");
+  CHECK(session.calls[0].statusCode == ok.status_code);
+  CHECK(session.calls[1].statusCode == notFound.status_code);
+
+  // Replaying against a fresh editor reproduces the recorded statuses.
+  PJsonEditor replayed(session.sceneList);
+  for (const auto &call : session.calls) {
+    CHECK(replayed.call(call.request).status_code == call.statusCode);
+  }
+}
+
+TEST_CASE("loadSession rejects malformed input") {
+  RecordedSession session;
+  std::string error;
+
+  std::stringstream noInit(
+      R"({"type":"request","method":"PUT","url":"/x","body":{}})"
+      "\n");
+  CHECK_FALSE(loadSession(noInit, session, &error));
+  CHECK_FALSE(error.empty());
+
+  std::stringstream garbage("not json\n");
+  CHECK_FALSE(loadSession(garbage, session, &error));
+
+  std::stringstream empty;
+  CHECK_FALSE(loadSession(empty, session, &error));
+}
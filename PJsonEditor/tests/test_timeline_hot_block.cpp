@@ -0,0 +1,186 @@
+#include <memory>
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ExtendedModels.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+struct Fixture {
+  std::shared_ptr<ExtendedDataStore> dataStore =
+      std::make_shared<ExtendedDataStore>();
+  ExtendedControllerAPI api;
+
+  Fixture() {
+    dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(
+        makeSceneListWithTimelines(3)));
+    api.setDataStore(dataStore);
+  }
+
+  // Every timeline sits at the same place relative to its scene as it did
+  // in makeSceneListWithTimelines().
+  void checkConsistent() {
+    for (const auto &scene : dataStore->getProject().scenes) {
+      REQUIRE(scene.aRolls.size() == 1);
+      REQUIRE(scene.bRolls.size() == 1);
+      REQUIRE(scene.voiceOvers.size() == 1);
+      CHECK(scene.aRolls[0].timeOffsetInProject == scene.timeOffsetInProject);
+      CHECK(scene.aRolls[0].timeOffsetInScene == 0);
+      CHECK(scene.bRolls[0].timeOffsetInProject ==
+            scene.timeOffsetInProject + 1000);
+      CHECK(scene.bRolls[0].timeOffsetInScene == 1000);
+      CHECK(scene.voiceOvers[0].timeOffsetInProject ==
+            scene.timeOffsetInProject + 2000);
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE_FIXTURE(Fixture, "block mirrors the timelines in scene order") {
+  const TimelineHotBlock &block = dataStore->timelineBlock();
+  REQUIRE(block.size() == 9);
+  REQUIRE(block.sceneCount() == 3);
+  for (size_t s = 0; s < 3; ++s) {
+    REQUIRE(block.sceneEnd(s) - block.sceneBegin(s) == 3);
+    size_t i = block.sceneBegin(s);
+    CHECK(block.tracks[i] == TimelineTrack::A_ROLL);
+    CHECK(block.tracks[i + 1] == TimelineTrack::B_ROLL);
+    CHECK(block.tracks[i + 2] == TimelineTrack::VOICE_OVER);
+    CHECK(block.offsets[i + 1] == static_cast<int>(s) * 5000 + 1000);
+    CHECK(block.offsetsInScene[i + 2] == 2000);
+  }
+}
+
+TEST_CASE_FIXTURE(Fixture, "shiftScenes moves scenes and their timelines") {
+  dataStore->shiftScenes(1, 700);
+  auto &scenes = dataStore->getProject().scenes;
+  CHECK(scenes[0].timeOffsetInProject == 0);
+  CHECK(scenes[1].timeOffsetInProject == 5700);
+  CHECK(scenes[2].timeOffsetInProject == 10700);
+  checkConsistent();
+
+  // Edits made through the models in between are picked up.
+  scenes[2].bRolls[0].timeOffsetInProject += 10;
+  dataStore->shiftSceneRange(2, 3, -700);
+  CHECK(scenes[2].bRolls[0].timeOffsetInProject == 10000 + 1000 + 10);
+}
+
+TEST_CASE_FIXTURE(Fixture, "recomputeOffsets keeps voice-overs in place") {
+  // Recomputing twice must not move voice-overs by their scene offset again.
+  dataStore->recomputeOffsets();
+  dataStore->recomputeOffsets();
+  checkConsistent();
+}
+
+TEST_CASE_FIXTURE(Fixture, "scene handlers keep timelines with their scene") {
+  SUBCASE("setSceneTime") {
+    ExtendedProjectSceneSetTimeReqBody req;
+    req.sceneUuid = "scene-0";
+    req.newDuration = 8000;
+    CHECK(api.setSceneTime(req).isSuccess());
+  }
+  SUBCASE("deleteScene") {
+    ExtendedProjectSceneDeleteReqBody req;
+    req.sceneUuid = "scene-0";
+    CHECK(api.deleteScene(req).isSuccess());
+    CHECK(dataStore->getProject().scenes[0].timeOffsetInProject == 0);
+  }
+  SUBCASE("moveScene") {
+    ExtendedProjectSceneMoveReqBody req;
+    req.uuid = "scene-0";
+    req.newIndex = 0;
+    req.afterSceneUuid = "scene-2";
+    CHECK(api.moveScene(req).isSuccess());
+    CHECK(dataStore->getProject().scenes[0].timeOffsetInProject == 0);
+  }
+  SUBCASE("moveScene backward") {
+    ExtendedProjectSceneMoveReqBody req;
+    req.uuid = "scene-2";
+    req.newIndex = 0;
+    CHECK(api.moveScene(req).isSuccess());
+    CHECK(dataStore->getProject().scenes[0].uuid == "scene-2");
+    CHECK(dataStore->getProject().scenes[0].timeOffsetInProject == 0);
+  }
+  auto &scenes = dataStore->getProject().scenes;
+  for (size_t i = 1; i < scenes.size(); ++i) {
+    CHECK(scenes[i].timeOffsetInProject ==
+          scenes[i - 1].timeOffsetInProject + scenes[i - 1].duration);
+  }
+  checkConsistent();
+}
+
+TEST_CASE_FIXTURE(Fixture, "split and merge keep timelines in place") {
+  ExtendedProjectSceneSplitReqBody split;
+  split.sceneUuid = "scene-1";
+  split.splitTime = 1000;
+  REQUIRE(api.splitScene(split).isSuccess());
+  auto &scenes = dataStore->getProject().scenes;
+  REQUIRE(scenes.size() == 4);
+  const auto &second = scenes[2];
+  CHECK(second.timeOffsetInProject == 6000);
+  REQUIRE(second.bRolls.size() == 1);
+  CHECK(second.bRolls[0].timeOffsetInProject == 6000);
+  CHECK(second.bRolls[0].timeOffsetInScene == 0);
+  REQUIRE(second.voiceOvers.size() == 1);
+  CHECK(second.voiceOvers[0].timeOffsetInProject == 7000);
+  // The a-roll continuation starts with the new scene.
+  REQUIRE(second.aRolls.size() == 1);
+  CHECK(second.aRolls[0].timeOffsetInProject == 6000);
+  CHECK(second.aRolls[0].timeOffsetInScene == 0);
+
+  ExtendedProjectSceneMergeReqBody merge;
+  merge.sceneUuids = {scenes[1].uuid, scenes[2].uuid};
+  REQUIRE(api.mergeScenes(merge).isSuccess());
+  REQUIRE(scenes.size() == 3);
+  const auto &merged = scenes[1];
+  CHECK(merged.timeOffsetInProject == 5000);
+  REQUIRE(merged.bRolls.size() == 1);
+  CHECK(merged.bRolls[0].timeOffsetInProject == 6000);
+  CHECK(merged.bRolls[0].timeOffsetInScene == 1000);
+  REQUIRE(merged.voiceOvers.size() == 1);
+  CHECK(merged.voiceOvers[0].timeOffsetInProject == 7000);
+  CHECK(scenes[2].voiceOvers[0].timeOffsetInProject == 12000);
+}
+
+TEST_CASE_FIXTURE(Fixture, "edited scenes are re-read like a full rebuild") {
+  dataStore->timelineBlock();
+
+  AddVoiceOverReqBody add;
+  add.sceneUuid = "scene-0";
+  add.assetUuid = "asset";
+  add.timeOffsetInScene = 4000;
+  add.duration = 500;
+  REQUIRE(api.addVoiceOver(add).isSuccess());
+  DeleteVoiceOverReqBody remove;
+  remove.sceneUuid = "scene-1";
+  remove.timelineUuid = "voice-1";
+  REQUIRE(api.deleteVoiceOver(remove).isSuccess());
+  ExtendedProjectSceneSetTimeReqBody setTime;
+  setTime.sceneUuid = "scene-2";
+  setTime.newDuration = 6000;
+  REQUIRE(api.setSceneTime(setTime).isSuccess());
+  ExtendedProjectSceneSetTimeReqBody grow;
+  grow.sceneUuid = "scene-1";
+  grow.newDuration = 5500;
+  REQUIRE(api.setSceneTime(grow).isSuccess());
+
+  const TimelineHotBlock &block = dataStore->timelineBlock();
+  ExtendedProjectAndScenesVo copy = dataStore->getCurrentProjectData();
+  TimelineHotBlock rebuilt;
+  rebuilt.build(copy.scenes);
+  REQUIRE(block.size() == 9);
+  CHECK(block.sceneEnd(0) - block.sceneBegin(0) == 4);
+  CHECK(block.sceneEnd(1) - block.sceneBegin(1) == 2);
+  CHECK(block.offsets == rebuilt.offsets);
+  CHECK(block.offsetsInScene == rebuilt.offsetsInScene);
+  CHECK(block.durations == rebuilt.durations);
+  CHECK(block.endTimes == rebuilt.endTimes);
+  CHECK(block.sceneIndex == rebuilt.sceneIndex);
+  CHECK(block.tracks == rebuilt.tracks);
+  CHECK(dataStore->getCurrentProjectData().scenes[2].bRolls[0].timeOffsetInProject ==
+        10500 + 1000);
+}
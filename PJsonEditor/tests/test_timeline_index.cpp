@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/ExtendedModels.h>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+using Hit = std::tuple<int, size_t, size_t, int32_t, int32_t>;
+
+std::vector<Hit> hits(const TimelineQueryResult &result) {
+  std::vector<Hit> out;
+  for (const auto &hit : result.timelines) {
+    out.emplace_back(static_cast<int>(hit.track), hit.sceneIndex, hit.index,
+                     hit.begin, hit.end);
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+// The same query as a walk over every scene and timeline.
+std::vector<Hit> linearScan(const std::vector<ExtendedProjectScene> &scenes,
+                            int32_t begin, int32_t end) {
+  std::vector<Hit> out;
+  for (size_t s = 0; s < scenes.size(); ++s) {
+    const auto &scene = scenes[s];
+    const int32_t sceneStart = scene.timeOffsetInProject;
+    const int32_t sceneEnd = sceneStart + scene.duration;
+    auto add = [&](TimelineTrack track, size_t i, int32_t offset, int32_t duration) {
+      const int32_t b = std::max(offset, sceneStart);
+      const int32_t e = std::min(offset + duration, sceneEnd);
+      if (duration > 0 && b < e && b < end && e > begin) {
+        out.emplace_back(static_cast<int>(track), s, i, b, e);
+      }
+    };
+    for (size_t i = 0; i < scene.aRolls.size(); ++i) {
+      add(TimelineTrack::A_ROLL, i, sceneStart + scene.aRolls[i].timeOffsetInScene,
+          scene.aRolls[i].duration);
+    }
+    for (size_t i = 0; i < scene.bRolls.size(); ++i) {
+      add(TimelineTrack::B_ROLL, i, sceneStart + scene.bRolls[i].timeOffsetInScene,
+          scene.bRolls[i].duration);
+    }
+    for (size_t i = 0; i < scene.voiceOvers.size(); ++i) {
+      add(TimelineTrack::VOICE_OVER, i, scene.voiceOvers[i].timeOffsetInProject,
+          scene.voiceOvers[i].duration);
+    }
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+struct Fixture {
+  std::shared_ptr<ExtendedDataStore> dataStore =
+      std::make_shared<ExtendedDataStore>();
+  ExtendedControllerAPI api;
+
+  Fixture() {
+    dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(
+        makeSceneListWithTimelines(4)));
+    api.setDataStore(dataStore);
+  }
+
+  void checkAgainstLinearScan() {
+    const auto &scenes = dataStore->getCurrentProjectData().scenes;
+    for (int32_t t = -500; t <= 21000; t += 250) {
+      CHECK(hits(dataStore->activeAt(t)) == linearScan(scenes, t, t + 1));
+      CHECK(hits(dataStore->rangeQuery(t, t + 1750)) ==
+            linearScan(scenes, t, t + 1750));
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE_FIXTURE(Fixture, "activeAt finds the scene and what plays in it") {
+  TimelineQueryResult result = dataStore->activeAt(6500);
+  CHECK(result.sceneBegin == 1);
+  CHECK(result.sceneEnd == 2);
+  REQUIRE(result.timelines.size() == 2);
+  CHECK(result.timelines[0].track == TimelineTrack::A_ROLL);
+  CHECK(result.timelines[0].begin == 5000);
+  CHECK(result.timelines[0].end == 10000);
+  CHECK(result.timelines[1].track == TimelineTrack::B_ROLL);
+  CHECK(result.timelines[1].begin == 6000);
+  CHECK(result.timelines[1].end == 9000);
+
+  CHECK(dataStore->timelineIndex().sceneAt(0) == 0);
+  CHECK(dataStore->timelineIndex().sceneAt(19999) == 3);
+  CHECK(dataStore->timelineIndex().sceneAt(20000) == SIZE_MAX);
+  CHECK(dataStore->timelineIndex().sceneAt(-1) == SIZE_MAX);
+  CHECK(dataStore->activeAt(20000).timelines.empty());
+}
+
+TEST_CASE_FIXTURE(Fixture, "rangeQuery returns every scene and timeline overlapping") {
+  TimelineQueryResult result = dataStore->rangeQuery(4000, 7500);
+  CHECK(result.sceneBegin == 0);
+  CHECK(result.sceneEnd == 2);
+  // Scene 0's b-roll and voice-over end at 4000, outside the range.
+  CHECK(result.timelines.size() == 4);
+  CHECK(dataStore->rangeQuery(7000, 7000).timelines.empty());
+  checkAgainstLinearScan();
+}
+
+TEST_CASE_FIXTURE(Fixture, "edits only rebuild the scenes whose timelines changed") {
+  dataStore->timelineIndex();
+
+  // Scene 1 gets shorter; scenes 2 and 3 only move.
+  ExtendedProjectSceneSetTimeReqBody setTime;
+  setTime.sceneUuid = "scene-1";
+  setTime.newDuration = 3000;
+  REQUIRE(api.setSceneTime(setTime).isSuccess());
+  CHECK(dataStore->timelineIndex().rebuiltScenes() <= 1);
+  CHECK(dataStore->timelineIndex().sceneAt(7999) == 1);
+  CHECK(dataStore->timelineIndex().sceneAt(8000) == 2);
+  checkAgainstLinearScan();
+
+  ExtendedProjectSceneMoveReqBody move;
+  move.uuid = "scene-3";
+  move.newIndex = 0;
+  REQUIRE(api.moveScene(move).isSuccess());
+  CHECK(dataStore->timelineIndex().rebuiltScenes() == 0);
+  CHECK(dataStore->activeAt(0).timelines[0].sceneIndex == 0);
+  checkAgainstLinearScan();
+
+  ExtendedProjectSceneDeleteReqBody remove;
+  remove.sceneUuid = "scene-0";
+  REQUIRE(api.deleteScene(remove).isSuccess());
+  CHECK(dataStore->timelineIndex().sceneCount() == 3);
+  CHECK(dataStore->timelineIndex().rebuiltScenes() == 0);
+  checkAgainstLinearScan();
+}
+
+TEST_CASE_FIXTURE(Fixture, "a scene edited after a move gets its tree rebuilt") {
+  dataStore->timelineIndex();
+
+  ExtendedProjectSceneMoveReqBody move;
+  move.uuid = "scene-0";
+  move.newIndex = 3;
+  move.afterSceneUuid = "scene-3";
+  REQUIRE(api.moveScene(move).isSuccess());
+  DeleteVoiceOverReqBody remove;
+  remove.sceneUuid = "scene-0";
+  remove.timelineUuid = "voice-0";
+  REQUIRE(api.deleteVoiceOver(remove).isSuccess());
+  CHECK(dataStore->timelineIndex().rebuiltScenes() == 1);
+  CHECK(dataStore->activeAt(17000).timelines.size() == 2);
+  checkAgainstLinearScan();
+
+  ExtendedProjectSceneSplitReqBody split;
+  split.sceneUuid = "scene-2";
+  split.splitTime = 2500;
+  REQUIRE(api.splitScene(split).isSuccess());
+  CHECK(dataStore->timelineIndex().sceneCount() == 5);
+  CHECK(dataStore->timelineIndex().rebuiltScenes() == 2);
+  checkAgainstLinearScan();
+}
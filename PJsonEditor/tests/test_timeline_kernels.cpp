@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/TimelineKernels.h>
+using namespace pjson;
+
+namespace {
+
+std::vector<const TimelineKernels *> availableKernels() {
+  std::vector<const TimelineKernels *> kernels;
+  for (KernelIsa isa : {KernelIsa::SCALAR, KernelIsa::SSE41, KernelIsa::AVX2,
+                        KernelIsa::WASM_SIMD128}) {
+    if (const TimelineKernels *k = timelineKernelsFor(isa)) {
+      kernels.push_back(k);
+    }
+  }
+  return kernels;
+}
+
+std::vector<int32_t> randomValues(std::mt19937 &rng, size_t n, int32_t lo,
+                                  int32_t hi) {
+  std::uniform_int_distribution<int32_t> dist(lo, hi);
+  std::vector<int32_t> values(n);
+  for (auto &v : values) {
+    v = dist(rng);
+  }
+  return values;
+}
+
+} // namespace
+
+TEST_CASE("scalar kernels are always available and one is selected") {
+  REQUIRE(timelineKernelsFor(KernelIsa::SCALAR) != nullptr);
+  CHECK(timelineKernels().name != nullptr);
+  CHECK(timelineKernelsFor(timelineKernels().isa) == &timelineKernels());
+}
+
+TEST_CASE("all kernel variants agree with the scalar loops") {
+  const TimelineKernels &scalar = *timelineKernelsFor(KernelIsa::SCALAR);
+  std::mt19937 rng(7);
+  // Lengths around the 4- and 8-lane boundaries exercise the scalar tails.
+  for (size_t n : {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100}) {
+    std::vector<int32_t> starts = randomValues(rng, n, 0, 60000);
+    std::vector<int32_t> lengths = randomValues(rng, n, 0, 5000);
+    std::vector<int32_t> ends(n);
+    for (size_t i = 0; i < n; ++i) {
+      ends[i] = starts[i] + lengths[i];
+    }
+
+    for (const TimelineKernels *k : availableKernels()) {
+      std::vector<int32_t> expected = starts;
+      std::vector<int32_t> actual = starts;
+      scalar.addDelta(expected.data(), n, -1234);
+      k->addDelta(actual.data(), n, -1234);
+      CHECK(actual == expected);
+
+      for (int32_t probe : {-100, 0, 2500, 30000, 59999, 70000}) {
+        CHECK(k->findOverlap(starts.data(), ends.data(), n, probe, probe + 300) ==
+              scalar.findOverlap(starts.data(), ends.data(), n, probe,
+                                 probe + 300));
+      }
+
+      std::vector<int32_t> expectedEnds = ends, actualEnds = ends;
+      std::vector<int32_t> expectedDurations = lengths,
+                           actualDurations = lengths;
+      size_t expectedCount =
+          scalar.clampEndTimes(starts.data(), expectedEnds.data(),
+                               expectedDurations.data(), n, 2500);
+      size_t actualCount = k->clampEndTimes(
+          starts.data(), actualEnds.data(), actualDurations.data(), n, 2500);
+      CHECK(actualCount == expectedCount);
+      CHECK(actualEnds == expectedEnds);
+      CHECK(actualDurations == expectedDurations);
+    }
+  }
+}
+
+TEST_CASE("findOverlap treats touching intervals as disjoint") {
+  const std::vector<int32_t> starts{0, 1000, 2000, 3000, 4000,
+                                    5000, 6000, 7000, 8000};
+  const std::vector<int32_t> ends{1000, 2000, 3000, 4000, 5000,
+                                  6000, 7000, 8000, 9000};
+  for (const TimelineKernels *k : availableKernels()) {
+    CHECK(k->findOverlap(starts.data(), ends.data(), starts.size(), 9000,
+                         9500) == -1);
+    CHECK(k->findOverlap(starts.data(), ends.data(), starts.size(), 8999,
+                         9500) == 8);
+    CHECK(k->findOverlap(starts.data(), ends.data(), starts.size(), 1500,
+                         3500) == 1);
+  }
+}
@@ -0,0 +1,113 @@
+#include <memory>
+#include <string>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <pjson_editor/ExtendedAPI.h>
+#include <pjson_editor/pjson_editor.hpp>
+#include "scene_fixture.hpp"
+using namespace pjson;
+
+namespace {
+
+Request get(const std::string &url, const std::string &knownTag = "") {
+  Request req{"GET", url, nlohmann::json::object(), {}};
+  if (!knownTag.empty()) {
+    req.headers["If-None-Match"] = knownTag;
+  }
+  return req;
+}
+
+} // namespace
+
+TEST_CASE("read routes answer 304 or only what changed") {
+  PJsonEditor editor(makeSceneList(3));
+
+  Response full = editor.call(get("/v3/project/p1/scenes"));
+  REQUIRE(full.status_code == 200);
+  CHECK(full.headers["ETag"] == "\"1\"");
+  CHECK(full.body["data"]["scenes"].size() == 3);
+  CHECK(editor.call(get("/v3/project/p1/scenes", "\"1\"")).status_code == 304);
+  CHECK(editor.call(get("/v3/project/p1/scenes", "W/\"1\"")).status_code ==
+        304);
+
+  Response renamed = editor.call(
+      {"PUT",
+       "/v3/project/p1/scene/rename",
+       {{"sceneUuid", "scene-2"}, {"name", "Renamed"}},
+       {}});
+  REQUIRE(renamed.status_code == 200);
+  CHECK(renamed.headers["ETag"] == "\"2\"");
+
+  Response delta = editor.call(get("/v3/project/p1/scenes", "\"1\""));
+  REQUIRE(delta.status_code == 200);
+  CHECK(delta.headers["ETag"] == "\"2\"");
+  const auto &data = delta.body["data"];
+  CHECK(data["sinceVersion"] == 1);
+  REQUIRE(data["scenes"].size() == 1);
+  CHECK(data["scenes"][0]["name"] == "Renamed");
+  CHECK_FALSE(data.contains("sceneUuids"));
+
+  // scene-0 did not change, so a client holding it at version 1 keeps it.
+  CHECK(editor.call(get("/v3/project/p1/scene/scene-0", "\"1\"")).status_code ==
+        304);
+  Response scene2 = editor.call(get("/v3/project/p1/scene/scene-2", "\"1\""));
+  CHECK(scene2.status_code == 200);
+  CHECK(scene2.headers["ETag"] == "\"2\"");
+
+  // Removing a scene sends the new order.
+  Response deleted = editor.call({"DELETE",
+                                  "/v3/project/p1/scene/delete",
+                                  {{"sceneUuid", "scene-0"}},
+                                  {}});
+  REQUIRE(deleted.status_code == 200);
+  Response afterDelete = editor.call(get("/v3/project/p1/scenes", "\"2\""));
+  REQUIRE(afterDelete.status_code == 200);
+  CHECK(afterDelete.body["data"]["sceneUuids"] ==
+        nlohmann::json::array({"scene-1", "scene-2"}));
+
+  // A failed call is not a change.
+  Response failed = editor.call({"PUT",
+                                 "/v3/project/p1/scene/rename",
+                                 {{"sceneUuid", "missing"}, {"name", "x"}},
+                                 {}});
+  CHECK(failed.status_code == 400);
+  CHECK(failed.headers["ETag"] == deleted.headers["ETag"]);
+}
+
+TEST_CASE("recordChange stamps scenes from patch paths") {
+  auto dataStore = std::make_shared<ExtendedDataStore>();
+  dataStore->init(std::make_shared<ExtendedProjectAndScenesVo>(makeSceneList(3)));
+  ExtendedControllerAPI api;
+  api.setDataStore(dataStore);
+  const auto &project = dataStore->getCurrentProjectData();
+
+  dataStore->recordChange(nlohmann::json::array());
+  CHECK(project.version == 1);
+
+  dataStore->recordChange(
+      {{{"op", "replace"}, {"path", "/scenes/1/duration"}, {"value", 1}},
+       {{"op", "replace"}, {"path", "/scenes/[uuid=scene-2]/name"}, {"value", "x"}}});
+  CHECK(project.version == 2);
+  CHECK(project.scenes[0].version == 0);
+  CHECK(project.scenes[1].version == 2);
+  CHECK(project.scenes[2].version == 2);
+  CHECK(project.sceneListVersion == 1);
+  CHECK(project.sharedVersion == 1);
+  CHECK(api.convertProjectToProjectAndScenesVoSince(2)["scenes"].empty());
+
+  // A change outside the scenes makes the delta a full view.
+  dataStore->recordChange({{{"op", "add"}, {"path", "/bgms/-"}, {"value", {}}}});
+  CHECK(project.sharedVersion == 3);
+  nlohmann::json since = api.convertProjectToProjectAndScenesVoSince(2);
+  CHECK_FALSE(since.contains("sinceVersion"));
+  CHECK(since["scenes"].size() == 3);
+
+  // Segments that are not a plain, bounded index stamp every scene instead
+  // of being parsed.
+  dataStore->recordChange(
+      {{{"op", "replace"}, {"path", "/scenes/99999999999999999999999/name"}, {"value", "x"}},
+       {{"op", "replace"}, {"path", "/scenes/\xc3\xa9/name"}, {"value", "x"}}});
+  CHECK(project.version == 4);
+  CHECK(project.sceneListVersion == 4);
+  CHECK(project.scenes[0].version == 4);
+}
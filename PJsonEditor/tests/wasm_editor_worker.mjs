@@ -0,0 +1,70 @@
+// Headless test of Module.EditorWorker in the pthreads build of the wasm
+// module (-DPJSON_WASM_THREADS=ON); registered as the wasm_editor_worker
+// ctest in that build.
+//
+//   node tests/wasm_editor_worker.mjs <build>/pjson_wasm.js
+import assert from 'node:assert/strict';
+import { createRequire } from 'node:module';
+import path from 'node:path';
+
+const [modulePath] = process.argv.slice(2);
+if (!modulePath) {
+  console.error('usage: node wasm_editor_worker.mjs <pjson_wasm.js>');
+  process.exit(1);
+}
+
+const require = createRequire(import.meta.url);
+const createModule = require(path.resolve(modulePath));
+const Module = await createModule();
+
+const sceneList = JSON.stringify({
+  code: 0,
+  msg: 'success',
+  data: {
+    projectUuid: 'p1',
+    scenes: [{
+      sceneUuid: 'scene-0', projectUuid: 'p1', name: 'Scene 0',
+      duration: 5000, timeOffsetInProject: 0, sceneType: 'default',
+    }],
+  },
+});
+
+assert.throws(() => new Module.EditorWorker('{"code": '), /not JSON/);
+
+const worker = new Module.EditorWorker(sceneList);
+
+// More calls than the worker's queue holds: the rest wait in JS and still
+// resolve in order.
+const calls = [];
+for (let i = 0; i < 600; ++i) {
+  calls.push(worker.callJson({
+    method: 'PUT',
+    url: '/v3/project/p1/scene/rename',
+    body: { sceneUuid: 'scene-0', name: `Name ${i}` },
+  }));
+}
+const responses = await Promise.all(calls);
+responses.forEach((response, i) => {
+  assert.equal(response.status, 200);
+  assert.equal(response.patch[0].value, `Name ${i}`);
+});
+
+const scenes = await worker.callJson({ method: 'GET', url: '/v3/project/p1/scenes' });
+assert.equal(scenes.body.data.scenes[0].name, 'Name 599');
+
+const invalid = await worker.callJson({
+  method: 'PUT', url: '/v3/project/p1/scene/rename', body: { sceneUuid: 7 },
+});
+assert.equal(invalid.status, 400);
+
+// The synchronous editor in the same module still works alongside.
+const editor = new Module.Editor(sceneList);
+assert.equal(editor.callJson({ method: 'GET', url: '/v3/project/p1/scenes' }).status, 200);
+editor.delete();
+
+worker.delete();
+await assert.rejects(worker.callJson({ method: 'GET', url: '/' }), /deleted/);
+
+console.log('wasm_editor_worker: ok');
+// Pool threads keep Node alive.
+process.exit(0);